@@ -0,0 +1,219 @@
+#ifndef MS_CACHE_H
+# define MS_CACHE_H
+
+# include <ms_struct.h>
+
+/*
+ * Eviction policies
+*/
+# define MS_CACHE_LRU                 MS_CAST(int, 0x00)
+# define MS_CACHE_SLRU                MS_CAST(int, 0x01)
+# define MS_CACHE_CLOCK               MS_CAST(int, 0x02)
+# define MS_CACHE_S3FIFO              MS_CAST(int, 0x03)
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+struct s_cache;
+
+/* Type opaque */
+typedef struct s_cache t_cache;
+
+struct s_cache_stats
+{
+	size_t hits;
+	size_t misses;
+	size_t evictions;
+	size_t entries;
+	size_t bytes;
+};
+
+typedef struct s_cache_stats t_cache_stats;
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+/*! Cache init
+ *
+ * @brief Initialize a bounded cache. Each entry is linked at once
+ *        in a hash table and in the queues of the policy, so that
+ *        get, put, touch and evict are O(1)
+ *
+ *            MS_CACHE_LRU    evict the least recently used entry
+ *            MS_CACHE_SLRU   segmented LRU: a first hit promotes an entry
+ *                            from probation to a protected segment (80%)
+ *            MS_CACHE_CLOCK  FIFO with a reference bit (second chance),
+ *                            a hit does not move the entry
+ *            MS_CACHE_S3FIFO small FIFO (10%) filtering one-hit entries
+ *                            before a main FIFO, with a ghost FIFO of the
+ *                            recently evicted keys
+ *
+ * @param cache
+ *     (input) cache to initialize
+ * @param policy
+ *     (input) eviction policy
+ * @param max_entries
+ *     (input) maximum number of entries, 0 for no limit
+ * @param max_bytes
+ *     (input) maximum sum of the charges of the entries, 0 for no limit
+ * @param f_hash
+ *     (input) function use to create the hash
+ *             @param key
+ *                 (input) key to hash
+ *             @param key_len
+ *                 (input) length of the key
+ *
+ *             @result Return a fresh hash
+ * @param f_free
+ *     (input) function to free the data of an entry leaving the cache
+ *             (evicted, replaced or destroyed)
+ *             @param data
+ *                 (input) data to free
+ *             @result NaN
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int cache_init(
+	  t_cache ** cache
+	, int policy
+	, size_t max_entries
+	, size_t max_bytes
+	, size_t (*f_hash)(unsigned char * key, size_t key_len)
+	, void (*f_free)(void * data)
+);
+
+/*! Cache destroy
+ *
+ * @brief Dealloc a cache, giving every data to f_free
+ *
+ * @param cache
+ *     (input) cache to free
+ *
+ * @result NaN.
+*/
+void cache_destroy(t_cache * cache);
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+/*! Cache size
+ *
+ * @brief Return the number of entries of the cache
+ *
+ * @param cache
+ *     (input) cache
+ *
+ * @result If successful, size is returned.
+ *         Otherwise, a 0 is returned.
+*/
+size_t cache_size(const t_cache * cache);
+
+/*! Cache put
+ *
+ * @brief Insert an entry into the cache, or replace the data of the
+ *        entry of the same key, the previous data given to f_free unless
+ *        it is the same. The key is copied. Entries are evicted until
+ *        the cache fits its capacity again
+ *
+ * @param cache
+ *     (input) cache
+ * @param data
+ *     (input) data to add to the cache
+ * @param size
+ *     (input) size of the content to allocate.
+ *             If the size is 0, no copy occurs
+ * @param key
+ *     (input) key to use
+ * @param key_len
+ *     (input) length of the key
+ * @param charge
+ *     (input) bytes accounted against max_bytes for the entry
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int cache_put(
+	  t_cache * cache
+	, void * data
+	, size_t size
+	, unsigned char * key
+	, size_t key_len
+	, size_t charge
+);
+
+/*! Cache get
+ *
+ * @brief Search an entry into the cache. A hit is reported to the policy
+ *        and counted, as well as a miss
+ *
+ * @param cache
+ *     (input) cache
+ * @param key
+ *     (input) key to use
+ * @param key_len
+ *     (input) length of the key
+ * @param flag
+ *     (input) if bit set to MS_ELEMENT_REMOVE remove it while returned
+ *             (the data is not given to f_free)
+ *
+ * @result If successful, the data is returned.
+ *         Otherwise, NULL is returned.
+*/
+void * cache_get(
+	  t_cache * cache
+	, unsigned char * key
+	, size_t key_len
+	, int flag
+);
+
+/*! Cache touch
+ *
+ * @brief Report an access to an entry to the policy,
+ *        without counting it as a hit
+ *
+ * @param cache
+ *     (input) cache
+ * @param key
+ *     (input) key to use
+ * @param key_len
+ *     (input) length of the key
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int cache_touch(
+	  t_cache * cache
+	, unsigned char * key
+	, size_t key_len
+);
+
+/*! Cache evict
+ *
+ * @brief Evict the entry chosen by the policy, giving its data to f_free
+ *
+ * @param cache
+ *     (input) cache
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int cache_evict(t_cache * cache);
+
+/*! Cache stats
+ *
+ * @brief Retrieve the counters of the cache
+ *
+ * @param cache
+ *     (input) cache
+ * @param stats
+ *     (output) hits, misses, evictions, entries and bytes of the cache
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int cache_stats(
+	  const t_cache * cache
+	, t_cache_stats * stats
+);
+
+#endif /* !MS_CACHE_H */
+
+/* EOF */
\ No newline at end of file
@@ -0,0 +1,175 @@
+#ifndef MS_CHANNEL_H
+# define MS_CHANNEL_H
+
+# include <ms_struct.h>
+# include <ms_futex.h>
+
+/*
+ * Operations of a select case
+*/
+# define MS_CHANNEL_SEND              0
+# define MS_CHANNEL_RECV              1
+
+/*
+ * Results of channel_send and channel_recv besides 0
+*/
+# define MS_CHANNEL_TIMEOUT           1
+# define MS_CHANNEL_CLOSED            2
+
+/*
+ * Maximum number of cases of a select
+*/
+# define MS_CHANNEL_CASES             64
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+struct s_channel;
+
+/* Type opaque */
+typedef struct s_channel t_channel;
+
+/*
+ * A case of channel_select: `data` is the data to send, or receives the
+ * data received. `closed` is set when the case is done because the
+ * channel is closed, nothing being sent or received
+*/
+typedef struct s_channel_case
+{
+	t_channel * channel;
+	int         op;
+	int         closed;
+	void      * data;
+} t_channel_case;
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+/*! Channel init
+ *
+ * @brief Initialize a channel passing data between threads. A buffered
+ *        channel holds up to `capacity` data, an unbuffered one hands
+ *        each data from a sender directly to a receiver, both waiting
+ *        for the other
+ *
+ * @param channel
+ *     (input) channel to initialize
+ * @param capacity
+ *     (input) size of the buffer, 0 for an unbuffered channel
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int channel_init(
+	  t_channel ** channel
+	, size_t capacity
+);
+
+/*! Channel destroy
+ *
+ * @brief Dealloc a channel
+ *
+ * @note No other thread may use the channel anymore
+ *
+ * @param channel
+ *     (input) channel to free
+ * @param f_free
+ *     (input) function to free the data left in the buffer
+ *             @param data
+ *                 (input) data to free
+ *             @result NaN
+ *
+ * @result NaN
+*/
+void channel_destroy(
+	  t_channel * channel
+	, void (*f_free)(void * data)
+);
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+/*! Channel close
+ *
+ * @brief Close a channel: the data buffered can still be received, every
+ *        send fails and the threads waiting on the channel are woken
+ *
+ * @param channel
+ *     (input) channel
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int channel_close(t_channel * channel);
+
+/*! Channel send
+ *
+ * @brief Send a data through the channel, waiting for room in the buffer
+ *        or, unbuffered, for a receiver
+ *
+ * @param channel
+ *     (input) channel
+ * @param data
+ *     (input) data to send, no copy occurs
+ * @param timeout
+ *     (input) timeout in milliseconds, 0 to not wait,
+ *             or MS_FUTEX_INFINITE
+ *
+ * @result If successful, 0 is returned.
+ *         If the timeout expired, MS_CHANNEL_TIMEOUT is returned.
+ *         If the channel is closed, MS_CHANNEL_CLOSED is returned.
+*/
+int channel_send(
+	  t_channel * channel
+	, void * data
+	, long timeout
+);
+
+/*! Channel receive
+ *
+ * @brief Receive a data from the channel, waiting for one
+ *
+ * @param channel
+ *     (input) channel
+ * @param data
+ *     (output) data received
+ * @param timeout
+ *     (input) timeout in milliseconds, 0 to not wait,
+ *             or MS_FUTEX_INFINITE
+ *
+ * @result If successful, 0 is returned.
+ *         If the timeout expired, MS_CHANNEL_TIMEOUT is returned.
+ *         If the channel is closed and empty, MS_CHANNEL_CLOSED is returned.
+*/
+int channel_recv(
+	  t_channel * channel
+	, void ** data
+	, long timeout
+);
+
+/*! Channel select
+ *
+ * @brief Do exactly one of several sends and receives, the first one
+ *        possible. When none is, the thread waits once for all of them:
+ *        it is queued on every channel, sleeps on a single futex, and the
+ *        thread making a case possible does it on its behalf. The cases
+ *        ready at once are tried from a rotating start, so that none
+ *        starves
+ *
+ * @param cases
+ *     (input) cases, a channel may appear in several of them
+ * @param count
+ *     (input) number of cases, at most MS_CHANNEL_CASES
+ * @param timeout
+ *     (input) timeout in milliseconds, 0 to not wait,
+ *             or MS_FUTEX_INFINITE
+ *
+ * @result The index of the case done is returned.
+ *         Otherwise, a -1 is returned.
+*/
+int channel_select(
+	  t_channel_case * cases
+	, size_t count
+	, long timeout
+);
+
+#endif /* !MS_CHANNEL_H */
+
+/* EOF */
\ No newline at end of file
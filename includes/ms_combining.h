@@ -0,0 +1,101 @@
+#ifndef MS_COMBINING_H
+# define MS_COMBINING_H
+
+# include <ms_struct.h>
+
+/*
+ * Flat combining: a thread publishes its operation in its own record
+ * of the combining, then the first thread to take the lock applies the
+ * operations of every record at once to the sequential container, so
+ * that the container stays in the cache of a single core
+*/
+
+/*
+ * Scans of the records by a combiner before it releases the lock
+*/
+# define MS_COMBINING_PASSES          4
+
+/*
+ * Spins of a waiting thread before it yields the core
+*/
+# define MS_COMBINING_SPIN            64
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+struct s_combining;
+
+/* Type opaque */
+typedef struct s_combining t_combining;
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+/*! Combining init
+ *
+ * @brief Make a sequential container safe to use from several threads
+ *
+ * @note Each combining holds a pthread key until it is destroyed: at
+ *       most PTHREAD_KEYS_MAX keys (1024 with glibc, 128 by POSIX) exist
+ *       at once in the process, including the keys of other libraries.
+ *       Past it, the init fails
+ *
+ * @param comb
+ *     (input) combining to initialize
+ * @param container
+ *     (input) container given to every operation, e.g. a `t_tree_rb **`
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int combining_init(
+	  t_combining ** comb
+	, void * container
+);
+
+/*! Combining destroy
+ *
+ * @brief Dealloc a combining, the container is left to the caller
+ *
+ * @note No other thread may use the combining anymore
+ *
+ * @param comb
+ *     (input) combining to free
+ *
+ * @result NaN
+*/
+void combining_destroy(t_combining * comb);
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+/*! Combining apply
+ *
+ * @brief Apply an operation to the container, by the calling thread or by
+ *        the thread combining at that time, and wait for its result.
+ *        The operations are applied one at a time, in no given order
+ *
+ * @param comb
+ *     (input) combining
+ * @param f_op
+ *     (input) operation on the sequential container
+ *             @param container
+ *                 (input) container
+ *             @param arg
+ *                 (input) argument of the operation
+ *             @result Return the result of the operation
+ * @param arg
+ *     (input) argument of the operation, it may also receive its output
+ * @param ret
+ *     (output) result of f_op, or NULL
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned and f_op is not called.
+*/
+int combining_apply(
+	  t_combining * comb
+	, int (*f_op)(void * container, void * arg)
+	, void * arg
+	, int * ret
+);
+
+#endif /* !MS_COMBINING_H */
+
+/* EOF */
\ No newline at end of file
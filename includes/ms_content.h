@@ -51,6 +51,27 @@ void content_destroy(
 	, void (*f_free)(void * data)
 );
 
+/*! Content retire
+ *
+ * @brief Dealloc a content unlinked from a concurrent structure, once
+ *        no thread can still read it (ms_epoch.h)
+ *
+ * @param content
+ *     (input) content to free
+ * @param f_free
+ *     (input) function to free the data
+ *             @param data
+ *                 (input) data to free
+ *             @result NaN
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int content_retire(
+	  t_content * content
+	, void (*f_free)(void * data)
+);
+
 #endif /* !MS_CONTENT_H */
 
 /* EOF */
\ No newline at end of file
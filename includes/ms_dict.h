@@ -3,6 +3,7 @@
 
 # include <ms_struct.h>
 # include <ms_content.h>
+# include <ms_pool.h>
 
 /*----------------------------------- STRUCTURES ------------------------------------*/
 
@@ -15,12 +16,14 @@ typedef struct s_dict t_dict;
 
 /*! Dictionary init
  *
- * @brief Initialize a dictionary of a given size
+ * @brief Initialize a dictionary of a given size.
+ *        The number of buckets is rounded up to a power of two
+ *        and doubles when it is outgrown by the number of elements
  *
  * @param dict
  *     (input) dict to initialize
  * @param size
- *     (input) size of the dictionary
+ *     (input) initial number of buckets of the dictionary
  * @param f_hash
  *     (input) function use to create the hash
  *             @param key
@@ -58,8 +61,64 @@ void dict_destroy(
 	, void (*f_free)(void * data)
 );
 
+/*! Dictionary destroy parallel
+ *
+ * @brief Dealloc a dictionary, its buckets freed by the threads of a pool
+ *
+ * @param dict
+ *     (input) dictionary to free
+ * @param f_free
+ *     (input) function to free the data, called concurrently
+ *             @param data
+ *                 (input) data to free
+ *             @result NaN
+ * @param pool
+ *     (input) pool, or NULL to free on the calling thread only
+ * @param grain
+ *     (input) buckets of a task, 0 for MS_POOL_GRAIN
+ *
+ * @result NaN
+*/
+void dict_destroy_parallel(
+	  t_dict * dict
+	, void (*f_free)(void * data)
+	, t_pool * pool
+	, size_t grain
+);
+
 /*------------------------------------- METHODS -------------------------------------*/
 
+/*! Dictionary size
+ *
+ * @brief Return the number of elements of the dictionary
+ *
+ * @param dict
+ *     (input) dictionary
+ *
+ * @result If successful, size is returned.
+ *         Otherwise, a 0 is returned.
+*/
+size_t dict_size(const t_dict * dict);
+
+/*! Dictionary resize
+ *
+ * @brief Grow or shrink the number of buckets of the dictionary,
+ *        rounded up to a power of two. The elements are rehashed
+ *        from their stored hash, the keys are not needed
+ *
+ * @param dict
+ *     (input) dictionary
+ * @param size
+ *     (input) new number of buckets
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int dict_resize(
+	  t_dict * dict
+	, size_t size
+);
+
 /*! Dictionary insert
  *
  * @brief Insert an element into the dictionary
@@ -87,9 +146,35 @@ int dict_insert(
 	, size_t key_len
 );
 
+/*! Dictionary insert hashed
+ *
+ * @brief Insert an element into the dictionary from the hash of its key,
+ *        already computed by the caller with the f_hash of the dictionary
+ *
+ * @param dict
+ *     (input) dictionary
+ * @param data
+ *     (input) data to add to the dictionary
+ * @param size
+ *     (input) size of the content to allocate.
+ *             If the size is 0, no copy occurs
+ * @param hash
+ *     (input) hash of the key
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int dict_insert_hashed(
+	  t_dict * dict
+	, void * data
+	, size_t size
+	, size_t hash
+);
+
 /*! Dictionary search
  *
- * @brief Search an element into the dictionary
+ * @brief Search an element into the dictionary.
+ *        The most recently inserted match is returned
  *
  * @param dict
  *     (input) dictionary
@@ -125,6 +210,278 @@ void * dict_search(
 	, int (*f_compare)(void * data, unsigned char * key, size_t key_len)
 );
 
+/*! Dictionary search hashed
+ *
+ * @brief Search an element into the dictionary from the hash of its key,
+ *        already computed by the caller with the f_hash of the dictionary
+ *
+ * @param dict
+ *     (input) dictionary
+ * @param hash
+ *     (input) hash of the key
+ * @param key
+ *     (input) key to use
+ * @param key_len
+ *     (input) length of the key
+ * @param flag
+ *     (input) if bit set to MS_ELEMENT_REMOVE remove it while returned
+ * @param f_compare
+ *     (input) function use to compare the key with the data
+ *             @param data
+ *                 (input) data to compare
+ *             @param key
+ *                 (input) key to compare
+ *             @param key_len
+ *                 (input) length of the key
+ *
+ *             @result If equals, 0 is returned.
+ *                     If greater, 1 is returned.
+ *                     If smaller, -1 is returned.
+ *
+ * @result If successful, the data is returned.
+ *         Otherwise, NULL is returned.
+*/
+void * dict_search_hashed(
+	  t_dict * dict
+	, size_t hash
+	, unsigned char * key
+	, size_t key_len
+	, int flag
+	, int (*f_compare)(void * data, unsigned char * key, size_t key_len)
+);
+
+/*! Dictionary upsert
+ *
+ * @brief Replace the data of the element matching the key,
+ *        or insert it if there is none, with a single hash
+ *        and a single walk of the chain
+ *
+ * @param dict
+ *     (input) dictionary
+ * @param data
+ *     (input) data to add to the dictionary
+ * @param size
+ *     (input) size of the content to allocate.
+ *             If the size is 0, no copy occurs
+ * @param key
+ *     (input) key to use
+ * @param key_len
+ *     (input) length of the key
+ * @param f_compare
+ *     (input) function use to compare the key with the data
+ *             @param data
+ *                 (input) data to compare
+ *             @param key
+ *                 (input) key to compare
+ *             @param key_len
+ *                 (input) length of the key
+ *
+ *             @result If equals, 0 is returned.
+ *                     If greater, 1 is returned.
+ *                     If smaller, -1 is returned.
+ * @param f_free
+ *     (input) function to free the replaced data, unless it is the
+ *             data given again
+ *             @param data
+ *                 (input) data to free
+ *             @result NaN
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int dict_upsert(
+	  t_dict * dict
+	, void * data
+	, size_t size
+	, unsigned char * key
+	, size_t key_len
+	, int (*f_compare)(void * data, unsigned char * key, size_t key_len)
+	, void (*f_free)(void * data)
+);
+
+/*! Dictionary get or insert
+ *
+ * @brief Return the slot holding the data of the element matching
+ *        the key, inserting the given data first if there is none.
+ *        The slot can be read and written in place
+ *        (e.g. to increment a counter), until the element is removed
+ *        or the dictionary is destroyed
+ *
+ * @param dict
+ *     (input) dictionary
+ * @param data
+ *     (input) data to add to the dictionary if the key is missing
+ * @param size
+ *     (input) size of the content to allocate.
+ *             If the size is 0, no copy occurs
+ * @param key
+ *     (input) key to use
+ * @param key_len
+ *     (input) length of the key
+ * @param f_compare
+ *     (input) function use to compare the key with the data
+ *             @param data
+ *                 (input) data to compare
+ *             @param key
+ *                 (input) key to compare
+ *             @param key_len
+ *                 (input) length of the key
+ *
+ *             @result If equals, 0 is returned.
+ *                     If greater, 1 is returned.
+ *                     If smaller, -1 is returned.
+ *
+ * @result If successful, the slot of the data is returned.
+ *         Otherwise, NULL is returned.
+*/
+void ** dict_get_or_insert(
+	  t_dict * dict
+	, void * data
+	, size_t size
+	, unsigned char * key
+	, size_t key_len
+	, int (*f_compare)(void * data, unsigned char * key, size_t key_len)
+);
+
+/*! Dictionary search batch
+ *
+ * @brief Search several elements into the dictionary at once.
+ *        Every hash is computed first, then the buckets and the
+ *        chains of all the keys are walked in an interleaved fashion
+ *        with prefetching, so that their cache misses overlap
+ *
+ * @param dict
+ *     (input) dictionary
+ * @param keys
+ *     (input) keys to use
+ * @param key_lens
+ *     (input) length of each key
+ * @param count
+ *     (input) number of keys
+ * @param datas
+ *     (output) data found for each key, or NULL
+ * @param f_compare
+ *     (input) function use to compare the key with the data
+ *             @param data
+ *                 (input) data to compare
+ *             @param key
+ *                 (input) key to compare
+ *             @param key_len
+ *                 (input) length of the key
+ *
+ *             @result If equals, 0 is returned.
+ *                     If greater, 1 is returned.
+ *                     If smaller, -1 is returned.
+ *
+ * @result Return the number of elements found.
+*/
+size_t dict_search_batch(
+	  t_dict * dict
+	, unsigned char ** keys
+	, size_t * key_lens
+	, size_t count
+	, void ** datas
+	, int (*f_compare)(void * data, unsigned char * key, size_t key_len)
+);
+
+/*! Dictionary function
+ *
+ * @brief Apply a function to each element of the dictionary,
+ *        in bucket order
+ *
+ * @param dict
+ *     (input) dictionary
+ * @param content
+ *     (output) data to retrieve
+ * @param f_fct
+ *     (input) function to apply on the data
+ *             @param data
+ *                 (input) data
+ *             @param content
+ *                 (output) data to retrieve
+ *             @result If successful, 0 is returned.
+ *                     Otherwise, a number is returned.
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a number is returned.
+*/
+int dict_foreach(
+	  t_dict * dict
+	, void ** content
+	, int (*f_fct)(void * data, void ** content)
+);
+
+/*! Dictionary function parallel
+ *
+ * @brief Apply a function to each element of the dictionary, its buckets
+ *        shared by the threads of a pool, in no given order. Once f_fct
+ *        fails, the buckets not started yet are skipped
+ *
+ * @note The dictionary may not be modified meanwhile
+ *
+ * @param dict
+ *     (input) dictionary
+ * @param content
+ *     (output) data to retrieve, shared by every call
+ * @param f_fct
+ *     (input) function to apply on the data, called concurrently
+ *             @param data
+ *                 (input) data
+ *             @param content
+ *                 (output) data to retrieve
+ *             @result If successful, 0 is returned.
+ *                     Otherwise, a number is returned.
+ * @param pool
+ *     (input) pool, or NULL to run on the calling thread only
+ * @param grain
+ *     (input) buckets of a task, 0 for MS_POOL_GRAIN
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, the first number returned by f_fct is returned.
+*/
+int dict_foreach_parallel(
+	  t_dict * dict
+	, void ** content
+	, int (*f_fct)(void * data, void ** content)
+	, t_pool * pool
+	, size_t grain
+);
+
+/*! Dictionary scan
+ *
+ * @brief Apply a function to the elements of one bucket and return
+ *        the cursor of the next one. Starting from 0 and calling again
+ *        until 0 is returned visits every element that stayed in the
+ *        dictionary for the whole scan at least once, even if the
+ *        dictionary was resized between two calls.
+ *        An element can be visited twice after a shrink
+ *
+ * @note Between two calls the dictionary can be modified freely,
+ *       during a call f_fct may only remove the data it is given
+ *
+ * @param dict
+ *     (input) dictionary
+ * @param cursor
+ *     (input) cursor returned by the previous call, 0 to start
+ * @param content
+ *     (output) data to retrieve
+ * @param f_fct
+ *     (input) function to apply on the data
+ *             @param data
+ *                 (input) data
+ *             @param content
+ *                 (output) data to retrieve
+ *             @result Ignored, the whole bucket is always visited
+ *
+ * @result Return the cursor of the next call, 0 once the scan is over.
+*/
+size_t dict_scan(
+	  t_dict * dict
+	, size_t cursor
+	, void ** content
+	, int (*f_fct)(void * data, void ** content)
+);
+
 #endif /* !MS_DICT_H */
 
 /* EOF */
\ No newline at end of file
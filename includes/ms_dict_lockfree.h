@@ -0,0 +1,217 @@
+#ifndef MS_DICT_LOCKFREE_H
+# define MS_DICT_LOCKFREE_H
+
+# include <ms_struct.h>
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+struct s_dict_lf;
+
+/* Type opaque */
+typedef struct s_dict_lf t_dict_lf;
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+/*! Lock-free Dictionary init
+ *
+ * @brief Initialize a dictionary safe to use from several threads
+ *        without any lock (split-ordered list). Every element is chained
+ *        in a single list sorted by its bit-reversed hash, the buckets
+ *        are shortcuts into it, created on first use, so that growing
+ *        the table never moves an element
+ *
+ * @param dict
+ *     (input) dict to initialize
+ * @param size
+ *     (input) initial number of buckets, rounded up to a power of two
+ * @param f_hash
+ *     (input) function use to create the hash
+ *             @param key
+ *                 (input) key to hash
+ *             @param key_len
+ *                 (input) length of the key
+ *
+ *             @result Return a fresh hash
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int dict_lf_init(
+	  t_dict_lf ** dict
+	, size_t size
+	, size_t (*f_hash)(unsigned char * key, size_t key_len)
+);
+
+/*! Lock-free Dictionary destroy
+ *
+ * @brief Dealloc a lock-free dictionary
+ *
+ * @note No other thread may use the dictionary anymore
+ *
+ * @param dict
+ *     (input) dictionary to free
+ * @param f_free
+ *     (input) function to free the data
+ *             @param data
+ *                 (input) data to free
+ *             @result NaN
+ *
+ * @result NaN
+*/
+void dict_lf_destroy(
+	  t_dict_lf * dict
+	, void (*f_free)(void * data)
+);
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+/*! Lock-free Dictionary size
+ *
+ * @brief Return the number of elements of the dictionary
+ *
+ * @param dict
+ *     (input) dictionary
+ *
+ * @result If successful, size is returned.
+ *         Otherwise, a 0 is returned.
+*/
+size_t dict_lf_size(const t_dict_lf * dict);
+
+/*! Lock-free Dictionary insert
+ *
+ * @brief Insert an element into the dictionary with a single CAS,
+ *        doubling the number of buckets once the elements outnumber them
+ *
+ * @param dict
+ *     (input) dictionary
+ * @param data
+ *     (input) data to add to the dictionary
+ * @param size
+ *     (input) size of the content to allocate.
+ *             If the size is 0, no copy occurs
+ * @param key
+ *     (input) key to use
+ * @param key_len
+ *     (input) length of the key
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int dict_lf_insert(
+	  t_dict_lf * dict
+	, void * data
+	, size_t size
+	, unsigned char * key
+	, size_t key_len
+);
+
+/*! Lock-free Dictionary search
+ *
+ * @brief Search an element into the dictionary. A search never takes
+ *        a lock nor writes to the dictionary: a bucket not created yet
+ *        is read through its parent
+ *
+ * @note The data returned stays valid until the epoch_exit of a critical
+ *       section entered by the caller around the search (ms_epoch.h),
+ *       otherwise only as long as no other thread removes it
+ *
+ * @param dict
+ *     (input) dictionary
+ * @param key
+ *     (input) key to use
+ * @param key_len
+ *     (input) length of the key
+ * @param f_compare
+ *     (input) function use to compare the key with the data
+ *             @param data
+ *                 (input) data to compare
+ *             @param key
+ *                 (input) key to compare
+ *             @param key_len
+ *                 (input) length of the key
+ *
+ *             @result If equals, 0 is returned.
+ *                     If greater, 1 is returned.
+ *                     If smaller, -1 is returned.
+ *
+ * @result If successful, the data is returned.
+ *         Otherwise, NULL is returned.
+*/
+void * dict_lf_search(
+	  t_dict_lf * dict
+	, unsigned char * key
+	, size_t key_len
+	, int (*f_compare)(void * data, unsigned char * key, size_t key_len)
+);
+
+/*! Lock-free Dictionary remove
+ *
+ * @brief Remove an element from the dictionary. The element is marked
+ *        then unlinked, its memory and data are retired to ms_epoch.h
+ *        and only freed once no thread can still read them
+ *
+ * @param dict
+ *     (input) dictionary
+ * @param key
+ *     (input) key to use
+ * @param key_len
+ *     (input) length of the key
+ * @param f_compare
+ *     (input) function use to compare the key with the data
+ *             @param data
+ *                 (input) data to compare
+ *             @param key
+ *                 (input) key to compare
+ *             @param key_len
+ *                 (input) length of the key
+ *
+ *             @result If equals, 0 is returned.
+ *                     If greater, 1 is returned.
+ *                     If smaller, -1 is returned.
+ * @param f_free
+ *     (input) function to free the data, once no thread can read it
+ *             @param data
+ *                 (input) data to free
+ *             @result NaN
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int dict_lf_remove(
+	  t_dict_lf * dict
+	, unsigned char * key
+	, size_t key_len
+	, int (*f_compare)(void * data, unsigned char * key, size_t key_len)
+	, void (*f_free)(void * data)
+);
+
+/*! Lock-free Dictionary function
+ *
+ * @brief Apply a function to each element of the dictionary,
+ *        concurrently with the other threads
+ *
+ * @param dict
+ *     (input) dictionary
+ * @param content
+ *     (output) data to retrieve
+ * @param f_fct
+ *     (input) function to apply on the data
+ *             @param data
+ *                 (input) data
+ *             @param content
+ *                 (output) data to retrieve
+ *             @result If successful, 0 is returned.
+ *                     Otherwise, a number is returned.
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a number is returned.
+*/
+int dict_lf_foreach(
+	  t_dict_lf * dict
+	, void ** content
+	, int (*f_fct)(void * data, void ** content)
+);
+
+#endif /* !MS_DICT_LOCKFREE_H */
+
+/* EOF */
\ No newline at end of file
@@ -0,0 +1,180 @@
+#ifndef MS_DICT_SHARDED_H
+# define MS_DICT_SHARDED_H
+
+# include <ms_struct.h>
+# include <ms_dict.h>
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+struct s_dict_sh;
+
+/* Type opaque */
+typedef struct s_dict_sh t_dict_sh;
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+/*! Sharded Dictionary init
+ *
+ * @brief Initialize a dictionary safe to use from several threads.
+ *        The high bits of the hash select one of the shards, each one
+ *        a dictionary behind its own cache-aligned reader-writer lock,
+ *        which grows on its own
+ *
+ * @param dict
+ *     (input) dict to initialize
+ * @param shards
+ *     (input) number of shards, rounded up to a power of two
+ * @param size
+ *     (input) initial number of buckets, split between the shards
+ * @param f_hash
+ *     (input) function use to create the hash
+ *             @param key
+ *                 (input) key to hash
+ *             @param key_len
+ *                 (input) length of the key
+ *
+ *             @result Return a fresh hash
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int dict_sh_init(
+	  t_dict_sh ** dict
+	, size_t shards
+	, size_t size
+	, size_t (*f_hash)(unsigned char * key, size_t key_len)
+);
+
+/*! Sharded Dictionary destroy
+ *
+ * @brief Dealloc a sharded dictionary
+ *
+ * @note No other thread may use the dictionary anymore
+ *
+ * @param dict
+ *     (input) dictionary to free
+ * @param f_free
+ *     (input) function to free the data
+ *             @param data
+ *                 (input) data to free
+ *             @result NaN
+ *
+ * @result NaN
+*/
+void dict_sh_destroy(
+	  t_dict_sh * dict
+	, void (*f_free)(void * data)
+);
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+/*! Sharded Dictionary size
+ *
+ * @brief Return the number of elements of the dictionary,
+ *        shard by shard (not an atomic snapshot)
+ *
+ * @param dict
+ *     (input) dictionary
+ *
+ * @result If successful, size is returned.
+ *         Otherwise, a 0 is returned.
+*/
+size_t dict_sh_size(t_dict_sh * dict);
+
+/*! Sharded Dictionary insert
+ *
+ * @brief Insert an element into the dictionary
+ *
+ * @param dict
+ *     (input) dictionary
+ * @param data
+ *     (input) data to add to the dictionary
+ * @param size
+ *     (input) size of the content to allocate.
+ *             If the size is 0, no copy occurs
+ * @param key
+ *     (input) key to use
+ * @param key_len
+ *     (input) length of the key
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int dict_sh_insert(
+	  t_dict_sh * dict
+	, void * data
+	, size_t size
+	, unsigned char * key
+	, size_t key_len
+);
+
+/*! Sharded Dictionary search
+ *
+ * @brief Search an element into the dictionary. Searches of different
+ *        threads only share the read side of a lock
+ *
+ * @note The data returned is not protected by the dictionary anymore,
+ *       the caller must ensure no other thread frees it meanwhile
+ *
+ * @param dict
+ *     (input) dictionary
+ * @param key
+ *     (input) key to use
+ * @param key_len
+ *     (input) length of the key
+ * @param flag
+ *     (input) if bit set to MS_ELEMENT_REMOVE remove it while returned
+ * @param f_compare
+ *     (input) function use to compare the key with the data
+ *             @param data
+ *                 (input) data to compare
+ *             @param key
+ *                 (input) key to compare
+ *             @param key_len
+ *                 (input) length of the key
+ *
+ *             @result If equals, 0 is returned.
+ *                     If greater, 1 is returned.
+ *                     If smaller, -1 is returned.
+ *
+ * @result If successful, the data is returned.
+ *         Otherwise, NULL is returned.
+*/
+void * dict_sh_search(
+	  t_dict_sh * dict
+	, unsigned char * key
+	, size_t key_len
+	, int flag
+	, int (*f_compare)(void * data, unsigned char * key, size_t key_len)
+);
+
+/*! Sharded Dictionary function
+ *
+ * @brief Apply a function to each element of the dictionary,
+ *        holding the read lock of one shard at a time
+ *
+ * @param dict
+ *     (input) dictionary
+ * @param content
+ *     (output) data to retrieve
+ * @param f_fct
+ *     (input) function to apply on the data
+ *             @param data
+ *                 (input) data
+ *             @param content
+ *                 (output) data to retrieve
+ *             @result If successful, 0 is returned.
+ *                     Otherwise, a number is returned.
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a number is returned.
+*/
+int dict_sh_foreach(
+	  t_dict_sh * dict
+	, void ** content
+	, int (*f_fct)(void * data, void ** content)
+);
+
+#endif /* !MS_DICT_SHARDED_H */
+
+/* EOF */
\ No newline at end of file
@@ -0,0 +1,290 @@
+#ifndef MS_DICT_TYPED_H
+# define MS_DICT_TYPED_H
+
+# include <ms_struct.h>
+# include <ms_hash.h>
+
+/*
+ * Equality of keys comparable with ==
+*/
+# define MS_DICT_EQ(a, b)             ((a) == (b))
+
+/*
+ * A full table is grown once it is 3/4 full
+*/
+# define MS_DICT_FULL(count, size)    ((count) * 4 >= (size) * 3)
+
+/*! Typed Dictionary declare
+ *
+ * @brief Generate a dictionary specialized for a key and a value type.
+ *        The keys and the values are stored by value in flat arrays,
+ *        with open addressing (linear probing, backward shift deletion)
+ *        over a power of two number of slots.
+ *        hash_fn and eq_fn are expanded in place, so they are inlined.
+ *
+ *        The generated API is:
+ *            t_dict_<name>
+ *            int     dict_<name>_init(t_dict_<name> ** dict, size_t size)
+ *            void    dict_<name>_destroy(t_dict_<name> * dict)
+ *            size_t  dict_<name>_size(const t_dict_<name> * dict)
+ *            int     dict_<name>_resize(t_dict_<name> * dict, size_t size)
+ *            int     dict_<name>_insert(t_dict_<name> * dict, key_t key, val_t val)
+ *            val_t * dict_<name>_search(t_dict_<name> * dict, key_t key)
+ *            int     dict_<name>_remove(t_dict_<name> * dict, key_t key, val_t * val)
+ *
+ *        insert replaces the value of an existing key, search returns the
+ *        slot of the value (valid until the next insert or remove),
+ *        remove optionally retrieves the removed value
+ *
+ * @param name
+ *     (input) suffix of the generated type and functions
+ * @param key_t
+ *     (input) type of the keys
+ * @param val_t
+ *     (input) type of the values
+ * @param hash_fn
+ *     (input) function or macro hashing a key, e.g. hash_int
+ *             @param key
+ *                 (input) key to hash
+ *             @result Return a fresh hash
+ * @param eq_fn
+ *     (input) function or macro comparing two keys, e.g. MS_DICT_EQ
+ *             @param a
+ *                 (input) key to compare
+ *             @param b
+ *                 (input) key to compare
+ *             @result If equals, 1 is returned.
+ *                     Otherwise, a 0 is returned.
+ *
+ * @result Functions return 0 if successful, 1 otherwise.
+*/
+# define MS_DICT_DECLARE(name, key_t, val_t, hash_fn, eq_fn)                   \
+                                                                              \
+struct s_dict_##name                                                          \
+{                                                                             \
+	size_t          size;                                                     \
+	size_t          count;                                                    \
+	unsigned char * used;                                                     \
+	key_t         * keys;                                                     \
+	val_t         * vals;                                                     \
+};                                                                            \
+                                                                              \
+typedef struct s_dict_##name t_dict_##name;                                   \
+                                                                              \
+static inline                                                                 \
+int __dict_##name##_alloc(                                                    \
+	  t_dict_##name * dict                                                    \
+	, size_t size                                                             \
+) {                                                                           \
+	dict->used = MS_CAST(unsigned char *, MS_ALLOC(size));                    \
+	dict->keys = MS_CAST(key_t *, MS_ALLOC(size * sizeof(key_t)));            \
+	dict->vals = MS_CAST(val_t *, MS_ALLOC(size * sizeof(val_t)));            \
+	if (                                                                      \
+		   MS_ADDRNULL(dict->used)                                            \
+		|| MS_ADDRNULL(dict->keys)                                            \
+		|| MS_ADDRNULL(dict->vals)                                            \
+	) {                                                                       \
+		MS_DEALLOC(dict->used);                                               \
+		MS_DEALLOC(dict->keys);                                               \
+		MS_DEALLOC(dict->vals);                                               \
+		return (1);                                                           \
+	}                                                                         \
+	MS_MEMSET(dict->used, 0, size);                                           \
+	dict->size = size;                                                        \
+	return (0);                                                               \
+}                                                                             \
+                                                                              \
+/* Slot of the key, or the empty slot ending its probe sequence */            \
+static inline                                                                 \
+size_t __dict_##name##_probe(                                                 \
+	  const t_dict_##name * dict                                              \
+	, key_t key                                                               \
+) {                                                                           \
+	size_t i;                                                                 \
+	size_t mask;                                                              \
+                                                                              \
+	mask = dict->size - 1;                                                    \
+	i = MS_CAST(size_t, hash_fn(key)) & mask;                                 \
+	while (                                                                   \
+		   0 != dict->used[i]                                                 \
+		&& !(eq_fn(dict->keys[i], key))                                       \
+	) {                                                                       \
+		i = (i + 1) & mask;                                                   \
+	}                                                                         \
+	return (i);                                                               \
+}                                                                             \
+                                                                              \
+static inline                                                                 \
+int dict_##name##_init(                                                       \
+	  t_dict_##name ** dict                                                   \
+	, size_t size                                                             \
+) {                                                                           \
+	size_t round;                                                             \
+                                                                              \
+	if (MS_ADDRCK(dict)) {                                                    \
+		*dict = MS_CAST(t_dict_##name *, MS_ALLOC(sizeof(t_dict_##name)));    \
+		if (MS_ADDRCK(*dict)) {                                               \
+			round = 4;                                                        \
+			while (MS_DICT_FULL(size, round)) {                               \
+				round <<= 1;                                                  \
+			}                                                                 \
+			(*dict)->count = 0;                                               \
+			if (0 == __dict_##name##_alloc(*dict, round)) {                   \
+				return (0);                                                   \
+			}                                                                 \
+			MS_DEALLOC(*dict);                                                \
+			*dict = NULL;                                                     \
+		}                                                                     \
+	}                                                                         \
+	return (1);                                                               \
+}                                                                             \
+                                                                              \
+static inline                                                                 \
+void dict_##name##_destroy(t_dict_##name * dict)                              \
+{                                                                             \
+	if (MS_ADDRCK(dict)) {                                                    \
+		MS_DEALLOC(dict->used);                                               \
+		MS_DEALLOC(dict->keys);                                               \
+		MS_DEALLOC(dict->vals);                                               \
+		MS_DEALLOC(dict);                                                     \
+	}                                                                         \
+}                                                                             \
+                                                                              \
+static inline                                                                 \
+size_t dict_##name##_size(const t_dict_##name * dict)                         \
+{                                                                             \
+	if (MS_ADDRCK(dict)) {                                                    \
+		return (dict->count);                                                 \
+	}                                                                         \
+	return (0);                                                               \
+}                                                                             \
+                                                                              \
+static inline                                                                 \
+int dict_##name##_resize(                                                     \
+	  t_dict_##name * dict                                                    \
+	, size_t size                                                             \
+) {                                                                           \
+	size_t          i;                                                        \
+	size_t          j;                                                        \
+	size_t          round;                                                    \
+	t_dict_##name   old;                                                      \
+                                                                              \
+	if (MS_ADDRNULL(dict)) {                                                  \
+		return (1);                                                           \
+	}                                                                         \
+	if (size < dict->count) {                                                 \
+		size = dict->count;                                                   \
+	}                                                                         \
+	round = 4;                                                                \
+	while (MS_DICT_FULL(size, round)) {                                       \
+		round <<= 1;                                                          \
+	}                                                                         \
+	if (round == dict->size) {                                                \
+		return (0);                                                           \
+	}                                                                         \
+	old = *dict;                                                              \
+	if (0 != __dict_##name##_alloc(dict, round)) {                            \
+		*dict = old;                                                          \
+		return (1);                                                           \
+	}                                                                         \
+	i = 0;                                                                    \
+	while (i < old.size) {                                                    \
+		if (0 != old.used[i]) {                                               \
+			j = __dict_##name##_probe(dict, old.keys[i]);                     \
+			dict->used[j] = 1;                                                \
+			dict->keys[j] = old.keys[i];                                      \
+			dict->vals[j] = old.vals[i];                                      \
+		}                                                                     \
+		++i;                                                                  \
+	}                                                                         \
+	MS_DEALLOC(old.used);                                                     \
+	MS_DEALLOC(old.keys);                                                     \
+	MS_DEALLOC(old.vals);                                                     \
+	return (0);                                                               \
+}                                                                             \
+                                                                              \
+static inline                                                                 \
+int dict_##name##_insert(                                                     \
+	  t_dict_##name * dict                                                    \
+	, key_t key                                                               \
+	, val_t val                                                               \
+) {                                                                           \
+	size_t i;                                                                 \
+                                                                              \
+	if (MS_ADDRNULL(dict)) {                                                  \
+		return (1);                                                           \
+	}                                                                         \
+	i = __dict_##name##_probe(dict, key);                                     \
+	if (0 == dict->used[i]) {                                                 \
+		if (MS_DICT_FULL(dict->count + 1, dict->size)) {                      \
+			if (0 != dict_##name##_resize(dict, dict->count + 1)) {           \
+				return (1);                                                   \
+			}                                                                 \
+			i = __dict_##name##_probe(dict, key);                             \
+		}                                                                     \
+		dict->used[i] = 1;                                                    \
+		dict->keys[i] = key;                                                  \
+		++dict->count;                                                        \
+	}                                                                         \
+	dict->vals[i] = val;                                                      \
+	return (0);                                                               \
+}                                                                             \
+                                                                              \
+static inline                                                                 \
+val_t * dict_##name##_search(                                                 \
+	  t_dict_##name * dict                                                    \
+	, key_t key                                                               \
+) {                                                                           \
+	size_t i;                                                                 \
+                                                                              \
+	if (MS_ADDRCK(dict)) {                                                    \
+		i = __dict_##name##_probe(dict, key);                                 \
+		if (0 != dict->used[i]) {                                             \
+			return (dict->vals + i);                                          \
+		}                                                                     \
+	}                                                                         \
+	return (NULL);                                                            \
+}                                                                             \
+                                                                              \
+/* Backward shift: no tombstone is left, probe sequences stay short */       \
+static inline                                                                 \
+int dict_##name##_remove(                                                     \
+	  t_dict_##name * dict                                                    \
+	, key_t key                                                               \
+	, val_t * val                                                             \
+) {                                                                           \
+	size_t i;                                                                 \
+	size_t j;                                                                 \
+	size_t k;                                                                 \
+	size_t mask;                                                              \
+                                                                              \
+	if (MS_ADDRNULL(dict)) {                                                  \
+		return (1);                                                           \
+	}                                                                         \
+	i = __dict_##name##_probe(dict, key);                                     \
+	if (0 == dict->used[i]) {                                                 \
+		return (1);                                                           \
+	}                                                                         \
+	if (MS_ADDRCK(val)) {                                                     \
+		*val = dict->vals[i];                                                 \
+	}                                                                         \
+	mask = dict->size - 1;                                                    \
+	j = (i + 1) & mask;                                                       \
+	while (0 != dict->used[j]) {                                              \
+		k = MS_CAST(size_t, hash_fn(dict->keys[j])) & mask;                   \
+		/* Move j into the hole unless its home lies in (i, j] */             \
+		if (((j - k) & mask) >= ((j - i) & mask)) {                           \
+			dict->keys[i] = dict->keys[j];                                    \
+			dict->vals[i] = dict->vals[j];                                    \
+			i = j;                                                            \
+		}                                                                     \
+		j = (j + 1) & mask;                                                   \
+	}                                                                         \
+	dict->used[i] = 0;                                                        \
+	--dict->count;                                                            \
+	return (0);                                                               \
+}
+
+#endif /* !MS_DICT_TYPED_H */
+
+/* EOF */
\ No newline at end of file
@@ -0,0 +1,138 @@
+#ifndef MS_EPOCH_H
+# define MS_EPOCH_H
+
+# include <ms_struct.h>
+
+/*
+ * Epoch-based reclamation: memory unlinked from a concurrent structure
+ * is retired instead of freed, and freed once every thread which was
+ * inside a critical section at that time has left it.
+ *
+ * The epochs are shared by the whole process, a thread is registered
+ * on its first critical section and released when it exits
+*/
+
+/*
+ * Elements retired by a thread between two attempts to reclaim
+*/
+# define MS_EPOCH_BATCH               64
+
+/*
+ * Elements retired by a thread, not freed yet, above which a thread
+ * outside of a critical section waits for them before going on
+*/
+# define MS_EPOCH_LIMIT               4096
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+/*! Epoch register
+ *
+ * @brief Register the calling thread, reusing the record of an exited
+ *        thread if any. Done by the first epoch_enter otherwise
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int epoch_register(void);
+
+/*! Epoch unregister
+ *
+ * @brief Release the record of the calling thread before it exits.
+ *        The elements it retired and not freed yet are left to the
+ *        next thread using the record
+ *
+ * @note The thread must be outside of any critical section
+ *
+ * @result NaN
+*/
+void epoch_unregister(void);
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+/*! Epoch enter
+ *
+ * @brief Enter a critical section: the elements read from a concurrent
+ *        structure until the matching epoch_exit are not freed meanwhile.
+ *        Sections nest, only the outermost one publishes the epoch
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int epoch_enter(void);
+
+/*! Epoch exit
+ *
+ * @brief Leave a critical section entered by epoch_enter
+ *
+ * @result NaN
+*/
+void epoch_exit(void);
+
+/*! Epoch reserve
+ *
+ * @brief Ensure that the next `count` epoch_retire of the calling thread
+ *        succeed, so that an element is never unlinked without being
+ *        able to retire it
+ *
+ * @param count
+ *     (input) number of elements, at most MS_EPOCH_BATCH
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int epoch_reserve(size_t count);
+
+/*! Epoch retire
+ *
+ * @brief Give an element unlinked from a concurrent structure to f_free,
+ *        once no thread can still read it
+ *
+ * @param data
+ *     (input) data to free
+ * @param f_free
+ *     (input) function to free the data
+ *             @param data
+ *                 (input) data to free
+ *             @result NaN
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int epoch_retire(
+	  void * data
+	, void (*f_free)(void * data)
+);
+
+/*! Epoch free
+ *
+ * @brief Deferred MS_DEALLOC, to use wherever a f_free is expected
+ *
+ * @param data
+ *     (input) data to free
+ *
+ * @result NaN
+*/
+void epoch_free(void * data);
+
+/*! Epoch synchronize
+ *
+ * @brief Wait until every element retired by the calling thread is freed
+ *
+ * @note The thread must be outside of any critical section
+ *
+ * @result NaN
+*/
+void epoch_synchronize(void);
+
+/*! Epoch pending
+ *
+ * @brief Return the number of elements retired by the calling thread
+ *        and not freed yet
+ *
+ * @result The number of elements is returned.
+*/
+size_t epoch_pending(void);
+
+#endif /* !MS_EPOCH_H */
+
+/* EOF */
\ No newline at end of file
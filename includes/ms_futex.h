@@ -0,0 +1,76 @@
+#ifndef MS_FUTEX_H
+# define MS_FUTEX_H
+
+# include <ms_struct.h>
+# include <time.h>
+
+/*
+ * Checks of the word by a waiting thread before it sleeps
+*/
+# define MS_FUTEX_SPIN                128
+
+/*
+ * Timeout waiting forever
+*/
+# define MS_FUTEX_INFINITE            -1
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+/*! Futex deadline
+ *
+ * @brief Compute the deadline of a timeout on the monotonic clock
+ *
+ * @param deadline
+ *     (output) deadline to fill
+ * @param timeout
+ *     (input) timeout in milliseconds, or MS_FUTEX_INFINITE
+ *
+ * @result The deadline is returned.
+ *         NULL is returned for MS_FUTEX_INFINITE.
+*/
+const struct timespec * futex_deadline(
+	  struct timespec * deadline
+	, long timeout
+);
+
+/*! Futex wait
+ *
+ * @brief Wait while the word at `addr` holds `expected`: spin briefly,
+ *        then sleep until futex_wake or the deadline. The caller checks
+ *        its condition again afterwards, a wake may be spurious
+ *
+ * @param addr
+ *     (input) address of the word
+ * @param expected
+ *     (input) value to wait on
+ * @param deadline
+ *     (input) deadline from futex_deadline, or NULL
+ *
+ * @result If woken or if the word changed, 0 is returned.
+ *         If the deadline passed, a 1 is returned.
+*/
+int futex_wait(
+	  int * addr
+	, int expected
+	, const struct timespec * deadline
+);
+
+/*! Futex wake
+ *
+ * @brief Wake up to `count` threads sleeping on the word at `addr`
+ *
+ * @param addr
+ *     (input) address of the word
+ * @param count
+ *     (input) number of threads to wake
+ *
+ * @result NaN
+*/
+void futex_wake(
+	  int * addr
+	, int count
+);
+
+#endif /* !MS_FUTEX_H */
+
+/* EOF */
\ No newline at end of file
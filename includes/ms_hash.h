@@ -16,6 +16,54 @@ size_t hash_fnv_onea(
 	, size_t key_len
 );
 
+/*! Hash integer
+ *
+ * @brief Mix every bit of an integer key into the hash (murmur3
+ *        finalizer), so that the low bits can index a table.
+ *        Inlined, for the typed dictionaries
+ *
+ * @param key
+ *     (input) key to hash
+ *
+ * @result Return a fresh hash
+*/
+static inline
+size_t hash_int(unsigned long long key)
+{
+	key ^= key >> 33;
+	key *= 0xFF51AFD7ED558CCDULL;
+	key ^= key >> 33;
+	key *= 0xC4CEB9FE1A85EC53ULL;
+	key ^= key >> 33;
+	return (MS_CAST(size_t, key));
+}
+
+/*! Hash round size
+ *
+ * @brief Round a number of buckets up to a power of two, so that the
+ *        bucket of a hash is `hash & (size - 1)`. Shared by the
+ *        dictionaries
+ *
+ * @param size
+ *     (input) number of buckets wanted
+ *
+ * @result Return the power of two, at least 1
+*/
+static inline
+size_t hash_round_size(size_t size)
+{
+	size_t round;
+
+	round = 1;
+	while (
+		   round < size
+		&& round <= (~MS_CAST(size_t, 0) >> 1)
+	) {
+		round <<= 1;
+	}
+	return (round);
+}
+
 #endif /* !MS_HASH_H */
 
 /* EOF */
\ No newline at end of file
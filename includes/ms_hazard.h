@@ -0,0 +1,157 @@
+#ifndef MS_HAZARD_H
+# define MS_HAZARD_H
+
+# include <ms_struct.h>
+
+/*
+ * Hazard pointers: a thread publishes, in one of its slots, each node
+ * it is about to read from a concurrent structure. A retired node is
+ * freed once no slot holds it, so that a stalled thread only holds
+ * back the few nodes of its slots (unlike ms_epoch.h).
+ *
+ * Where membarrier(2) is available, publishing a node costs no fence:
+ * the thread scanning the slots forces one on every other thread
+*/
+
+/*
+ * Slots per thread
+*/
+# define MS_HAZARD_SLOTS              4
+
+/*
+ * Elements retired by a thread before the slots are scanned. A thread
+ * keeps at most the larger of it and four times the slots of all the
+ * threads, however long another thread stalls
+*/
+# define MS_HAZARD_BATCH              64
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+/*! Hazard register
+ *
+ * @brief Register the calling thread, reusing the record of an exited
+ *        thread if any. Done by the first hazard_protect otherwise
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int hazard_register(void);
+
+/*! Hazard unregister
+ *
+ * @brief Clear the slots of the calling thread and release its record
+ *        before it exits. The elements it retired and not freed yet are
+ *        left to the next thread using the record
+ *
+ * @result NaN
+*/
+void hazard_unregister(void);
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+/*! Hazard protect
+ *
+ * @brief Load the pointer at `addr` and publish it in a slot, until
+ *        the pointer read back is the one published: it cannot be freed
+ *        before the slot is cleared or reused
+ *
+ * @param slot
+ *     (input) slot of the calling thread, below MS_HAZARD_SLOTS
+ * @param addr
+ *     (input) address of the shared pointer
+ *
+ * @result The pointer protected is returned.
+ *         NULL is returned if the thread could not be registered.
+*/
+void * hazard_protect(
+	  size_t slot
+	, void ** addr
+);
+
+/*! Hazard set
+ *
+ * @brief Publish a pointer in a slot as is, when it is already protected
+ *        by another slot or known to be reachable
+ *
+ * @param slot
+ *     (input) slot of the calling thread, below MS_HAZARD_SLOTS
+ * @param data
+ *     (input) pointer to publish
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int hazard_set(
+	  size_t slot
+	, void * data
+);
+
+/*! Hazard clear
+ *
+ * @brief Clear a slot of the calling thread
+ *
+ * @param slot
+ *     (input) slot of the calling thread, below MS_HAZARD_SLOTS
+ *
+ * @result NaN
+*/
+void hazard_clear(size_t slot);
+
+/*! Hazard retire
+ *
+ * @brief Give an element unlinked from a concurrent structure to f_free,
+ *        once no slot holds it. When the list of the retired elements
+ *        cannot grow, the thread waits for the element to be released
+ *        and frees it at once
+ *
+ * @note The slots of the calling thread are not checked by that wait,
+ *       the element must not be read anymore once retired
+ *
+ * @param data
+ *     (input) data to free
+ * @param f_free
+ *     (input) function to free the data
+ *             @param data
+ *                 (input) data to free
+ *             @result NaN
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int hazard_retire(
+	  void * data
+	, void (*f_free)(void * data)
+);
+
+/*! Hazard free
+ *
+ * @brief Deferred MS_DEALLOC, to use wherever a f_free is expected
+ *
+ * @param data
+ *     (input) data to free
+ *
+ * @result NaN
+*/
+void hazard_free(void * data);
+
+/*! Hazard collect
+ *
+ * @brief Scan the slots and free every element retired by the calling
+ *        thread that no slot holds anymore
+ *
+ * @result NaN
+*/
+void hazard_collect(void);
+
+/*! Hazard pending
+ *
+ * @brief Return the number of elements retired by the calling thread
+ *        and not freed yet
+ *
+ * @result The number of elements is returned.
+*/
+size_t hazard_pending(void);
+
+#endif /* !MS_HAZARD_H */
+
+/* EOF */
\ No newline at end of file
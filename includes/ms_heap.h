@@ -0,0 +1,149 @@
+#ifndef MS_HEAP_H
+# define MS_HEAP_H
+
+# include <ms_struct.h>
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+struct s_heap;
+
+/* Type opaque */
+typedef struct s_heap t_heap;
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+/*! Heap init
+ *
+ * @brief Initialize an empty priority queue, the smallest element first.
+ *        The heap is 4-ary and stored in a single cache-aligned array,
+ *        the 4 children of a node side by side on one cache line
+ *
+ * @param heap
+ *     (input) heap to initialize
+ * @param capacity
+ *     (input) initial number of elements, the array grows past it
+ * @param f_compare
+ *     (input) function use to compare two data
+ *             @param elem
+ *                 (input) elem to compare
+ *             @param data
+ *                 (input) data to compare
+ *
+ *             @result If equals, 0 is returned.
+ *                     If greater, 1 is returned.
+ *                     If smaller, -1 is returned.
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int heap_init(
+	  t_heap ** heap
+	, size_t capacity
+	, int (*f_compare)(void * elem, void * data)
+);
+
+/*! Heap destroy
+ *
+ * @brief Dealloc a heap
+ *
+ * @param heap
+ *     (input) heap to free
+ * @param f_free
+ *     (input) function to free the data
+ *             @param data
+ *                 (input) data to free
+ *             @result NaN
+ *
+ * @result NaN.
+*/
+void heap_destroy(
+	  t_heap * heap
+	, void (*f_free)(void * data)
+);
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+/*! Heap size
+ *
+ * @brief Return the number of elements of the heap
+ *
+ * @param heap
+ *     (input) heap
+ *
+ * @result If successful, size is returned.
+ *         Otherwise, a 0 is returned.
+*/
+size_t heap_size(const t_heap * heap);
+
+/*! Heap peek
+ *
+ * @brief Return the smallest element of the heap, in O(1)
+ *
+ * @param heap
+ *     (input) heap
+ *
+ * @result If successful, the data is returned.
+ *         Otherwise, NULL is returned.
+*/
+void * heap_peek(const t_heap * heap);
+
+/*! Heap push
+ *
+ * @brief Add an element to the heap, in O(log(n))
+ *
+ * @param heap
+ *     (input) heap
+ * @param data
+ *     (input) data to add to the heap, not NULL
+ * @param size
+ *     (input) size of the content to allocate.
+ *             If the size is 0, no copy occurs
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int heap_push(
+	  t_heap * heap
+	, void * data
+	, size_t size
+);
+
+/*! Heap push batch
+ *
+ * @brief Add several elements to the heap. When they are at least as many
+ *        as the elements already there, the whole heap is rebuilt bottom-up
+ *        in O(n), as for a heap built from an array, instead of sifting
+ *        each one up
+ *
+ * @param heap
+ *     (input) heap
+ * @param datas
+ *     (input) data to add to the heap, not NULL, no copy occurs
+ * @param count
+ *     (input) number of data
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned and nothing is added.
+*/
+int heap_push_batch(
+	  t_heap * heap
+	, void ** datas
+	, size_t count
+);
+
+/*! Heap pop
+ *
+ * @brief Return the smallest element of the heap and remove it,
+ *        in O(log(n))
+ *
+ * @param heap
+ *     (input) heap
+ *
+ * @result If successful, the data is returned.
+ *         Otherwise, NULL is returned.
+*/
+void * heap_pop(t_heap * heap);
+
+#endif /* !MS_HEAP_H */
+
+/* EOF */
\ No newline at end of file
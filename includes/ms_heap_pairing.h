@@ -0,0 +1,204 @@
+#ifndef MS_HEAP_PAIRING_H
+# define MS_HEAP_PAIRING_H
+
+# include <ms_struct.h>
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+struct s_heap_pa;
+struct s_heap_pa_node;
+
+/* Type opaque */
+typedef struct s_heap_pa t_heap_pa;
+
+/* Handle of an element, valid until it is popped or removed */
+typedef struct s_heap_pa_node t_heap_pa_node;
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+/*! Heap pairing init
+ *
+ * @brief Initialize an empty addressable priority queue, the smallest
+ *        element first. The heap is a pairing heap: each push returns
+ *        a handle, with which the element can be moved up or removed.
+ *        The nodes are taken from blocks owned by the heap and recycled,
+ *        a push allocates only once per block
+ *
+ * @param heap
+ *     (input) heap to initialize
+ * @param f_compare
+ *     (input) function use to compare two data
+ *             @param elem
+ *                 (input) elem to compare
+ *             @param data
+ *                 (input) data to compare
+ *
+ *             @result If equals, 0 is returned.
+ *                     If greater, 1 is returned.
+ *                     If smaller, -1 is returned.
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int heap_pa_init(
+	  t_heap_pa ** heap
+	, int (*f_compare)(void * elem, void * data)
+);
+
+/*! Heap pairing destroy
+ *
+ * @brief Dealloc a heap and its nodes
+ *
+ * @param heap
+ *     (input) heap to free
+ * @param f_free
+ *     (input) function to free the data
+ *             @param data
+ *                 (input) data to free
+ *             @result NaN
+ *
+ * @result NaN.
+*/
+void heap_pa_destroy(
+	  t_heap_pa * heap
+	, void (*f_free)(void * data)
+);
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+/*! Heap pairing size
+ *
+ * @brief Return the number of elements of the heap
+ *
+ * @param heap
+ *     (input) heap
+ *
+ * @result If successful, size is returned.
+ *         Otherwise, a 0 is returned.
+*/
+size_t heap_pa_size(const t_heap_pa * heap);
+
+/*! Heap pairing peek
+ *
+ * @brief Return the smallest element of the heap, in O(1)
+ *
+ * @param heap
+ *     (input) heap
+ *
+ * @result If successful, the data is returned.
+ *         Otherwise, NULL is returned.
+*/
+void * heap_pa_peek(const t_heap_pa * heap);
+
+/*! Heap pairing data
+ *
+ * @brief Return the data of a handle
+ *
+ * @param node
+ *     (input) handle returned by heap_pa_push
+ *
+ * @result If successful, the data is returned.
+ *         Otherwise, NULL is returned.
+*/
+void * heap_pa_data(const t_heap_pa_node * node);
+
+/*! Heap pairing push
+ *
+ * @brief Add an element to the heap, in O(1)
+ *
+ * @param heap
+ *     (input) heap
+ * @param data
+ *     (input) data to add to the heap, not NULL
+ * @param size
+ *     (input) size of the content to allocate.
+ *             If the size is 0, no copy occurs
+ * @param node
+ *     (output) handle of the element, or NULL
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int heap_pa_push(
+	  t_heap_pa * heap
+	, void * data
+	, size_t size
+	, t_heap_pa_node ** node
+);
+
+/*! Heap pairing pop
+ *
+ * @brief Return the smallest element of the heap and remove it,
+ *        in O(log(n)) amortized. Its handle is no longer valid
+ *
+ * @param heap
+ *     (input) heap
+ *
+ * @result If successful, the data is returned.
+ *         Otherwise, NULL is returned.
+*/
+void * heap_pa_pop(t_heap_pa * heap);
+
+/*! Heap pairing decrease
+ *
+ * @brief Give a smaller key to an element, in O(1), the element
+ *        keeping its handle. For an element holding its own key,
+ *        the key is changed in place and `data` is the same data
+ *
+ * @param heap
+ *     (input) heap holding the element
+ * @param node
+ *     (input) handle of the element
+ * @param data
+ *     (input) new data of the element, not NULL and not greater
+ *             than the previous one
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int heap_pa_decrease(
+	  t_heap_pa * heap
+	, t_heap_pa_node * node
+	, void * data
+);
+
+/*! Heap pairing remove
+ *
+ * @brief Remove any element from the heap, in O(log(n)) amortized.
+ *        Its handle is no longer valid
+ *
+ * @param heap
+ *     (input) heap holding the element
+ * @param node
+ *     (input) handle of the element
+ *
+ * @result If successful, the data is returned.
+ *         Otherwise, NULL is returned.
+*/
+void * heap_pa_remove(
+	  t_heap_pa * heap
+	, t_heap_pa_node * node
+);
+
+/*! Heap pairing meld
+ *
+ * @brief Move all the elements of `other` into `heap`, in O(1), and
+ *        dealloc `other`. The handles of its elements stay valid and
+ *        belong to `heap`
+ *
+ * @param heap
+ *     (input) heap receiving the elements
+ * @param other
+ *     (input) heap to meld, with the same f_compare
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned and nothing is moved.
+*/
+int heap_pa_meld(
+	  t_heap_pa * heap
+	, t_heap_pa * other
+);
+
+#endif /* !MS_HEAP_PAIRING_H */
+
+/* EOF */
\ No newline at end of file
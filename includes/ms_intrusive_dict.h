@@ -0,0 +1,210 @@
+#ifndef MS_INTRUSIVE_DICT_H
+# define MS_INTRUSIVE_DICT_H
+
+# include <ms_struct.h>
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+/*
+ * Hook to embed in the user structure (retrieved with MS_CONTAINER_OF).
+ * `pprev` points to the link referencing the hook, so that it can be
+ * unlinked in O(1) without walking its chain
+*/
+struct s_idict_node
+{
+	struct s_idict_node  * next;
+	struct s_idict_node ** pprev;
+	size_t                 hash;
+};
+
+typedef struct s_idict_node t_idict_node;
+
+struct s_idict;
+
+/* Type opaque */
+typedef struct s_idict t_idict;
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+/*! Intrusive Dictionary init
+ *
+ * @brief Initialize an intrusive dictionary of a given size.
+ *        The number of buckets is rounded up to a power of two
+ *        and doubles when it is outgrown by the number of hooks
+ *
+ * @param dict
+ *     (input) dict to initialize
+ * @param size
+ *     (input) initial number of buckets of the dictionary
+ * @param f_hash
+ *     (input) function use to create the hash
+ *             @param key
+ *                 (input) key to hash
+ *             @param key_len
+ *                 (input) length of the key
+ *
+ *             @result Return a fresh hash
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int idict_init(
+	  t_idict ** dict
+	, size_t size
+	, size_t (*f_hash)(unsigned char * key, size_t key_len)
+);
+
+/*! Intrusive Dictionary destroy
+ *
+ * @brief Dealloc an intrusive dictionary. The hooks are unlinked
+ *        then given to f_free, which owns their structure
+ *
+ * @param dict
+ *     (input) dictionary to free
+ * @param f_free
+ *     (input) function to free the structure of a hook
+ *             @param node
+ *                 (input) hook to free
+ *             @result NaN
+ *
+ * @result NaN
+*/
+void idict_destroy(
+	  t_idict * dict
+	, void (*f_free)(t_idict_node * node)
+);
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+/*! Intrusive Dictionary size
+ *
+ * @brief Return the number of hooks of the dictionary
+ *
+ * @param dict
+ *     (input) dictionary
+ *
+ * @result If successful, size is returned.
+ *         Otherwise, a 0 is returned.
+*/
+size_t idict_size(const t_idict * dict);
+
+/*! Intrusive Dictionary resize
+ *
+ * @brief Grow or shrink the number of buckets of the dictionary,
+ *        rounded up to a power of two
+ *
+ * @param dict
+ *     (input) dictionary
+ * @param size
+ *     (input) new number of buckets
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int idict_resize(
+	  t_idict * dict
+	, size_t size
+);
+
+/*! Intrusive Dictionary insert
+ *
+ * @brief Link a hook into the dictionary, without allocating it
+ *
+ * @param dict
+ *     (input) dictionary
+ * @param node
+ *     (input) hook to link
+ * @param key
+ *     (input) key to use
+ * @param key_len
+ *     (input) length of the key
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int idict_insert(
+	  t_idict * dict
+	, t_idict_node * node
+	, unsigned char * key
+	, size_t key_len
+);
+
+/*! Intrusive Dictionary search
+ *
+ * @brief Search a hook into the dictionary.
+ *        The most recently inserted match is returned
+ *
+ * @param dict
+ *     (input) dictionary
+ * @param key
+ *     (input) key to use
+ * @param key_len
+ *     (input) length of the key
+ * @param f_compare
+ *     (input) function use to compare the key with a hook
+ *             @param node
+ *                 (input) hook to compare
+ *             @param key
+ *                 (input) key to compare
+ *             @param key_len
+ *                 (input) length of the key
+ *
+ *             @result If equals, 0 is returned.
+ *                     Otherwise, a number is returned.
+ *
+ * @result If successful, the hook is returned.
+ *         Otherwise, NULL is returned.
+*/
+t_idict_node * idict_search(
+	  t_idict * dict
+	, unsigned char * key
+	, size_t key_len
+	, int (*f_compare)(t_idict_node * node, unsigned char * key, size_t key_len)
+);
+
+/*! Intrusive Dictionary remove
+ *
+ * @brief Unlink a hook from the dictionary in O(1), without hashing
+ *
+ * @param dict
+ *     (input) dictionary holding the hook
+ * @param node
+ *     (input) hook to unlink
+ *
+ * @result NaN
+*/
+void idict_remove(
+	  t_idict * dict
+	, t_idict_node * node
+);
+
+/*! Intrusive Dictionary function
+ *
+ * @brief Apply a function to each hook of the dictionary.
+ *        The function may remove the hook it is given
+ *
+ * @param dict
+ *     (input) dictionary
+ * @param content
+ *     (output) data to retrieve
+ * @param f_fct
+ *     (input) function to apply on the hook
+ *             @param node
+ *                 (input) hook
+ *             @param content
+ *                 (output) data to retrieve
+ *             @result If successful, 0 is returned.
+ *                     Otherwise, a number is returned.
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a number is returned.
+*/
+int idict_foreach(
+	  t_idict * dict
+	, void ** content
+	, int (*f_fct)(t_idict_node * node, void ** content)
+);
+
+#endif /* !MS_INTRUSIVE_DICT_H */
+
+/* EOF */
\ No newline at end of file
@@ -2,6 +2,7 @@
 # define MS_DOUBLY_LINKED_H
 
 # include <ms_struct.h>
+# include <ms_list/ms_sort.h>
 
 /*----------------------------------- STRUCTURES ------------------------------------*/
 
@@ -180,6 +181,70 @@ void *list_d_nth_element(
 	, int flag
 );
 
+/*! Doubly-linked List sort
+ *
+ * @brief Sort the doubly-linked list in increasing order, stable, relinking its
+ *        nodes without allocating (ms_sort.h)
+ *
+ * @param list
+ *     (input) address of the doubly-linked list
+ * @param f_compare
+ *     (input) function use to compare two data
+ *             @param elem
+ *                 (input) elem to compare
+ *             @param data
+ *                 (input) data to compare
+ *
+ *             @result If equals, 0 is returned.
+ *                     If greater, 1 is returned.
+ *                     If smaller, -1 is returned.
+ * @param flags
+ *     (input) 0, or MS_SORT_NATURAL for a list nearly sorted
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int list_d_sort(
+	  t_list_d ** list
+	, int (*f_compare)(void * elem, void * data)
+	, int flags
+);
+
+/*! Doubly-linked List sort parallel
+ *
+ * @brief Sort the doubly-linked list as list_d_sort, its parts sorted by the
+ *        threads of a pool
+ *
+ * @param list
+ *     (input) address of the doubly-linked list
+ * @param f_compare
+ *     (input) function use to compare two data, called concurrently
+ *             @param elem
+ *                 (input) elem to compare
+ *             @param data
+ *                 (input) data to compare
+ *
+ *             @result If equals, 0 is returned.
+ *                     If greater, 1 is returned.
+ *                     If smaller, -1 is returned.
+ * @param flags
+ *     (input) 0, or MS_SORT_NATURAL for a list nearly sorted
+ * @param pool
+ *     (input) pool, or NULL to sort on the calling thread only
+ * @param grain
+ *     (input) nodes of a task, 0 for MS_POOL_GRAIN
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int list_d_sort_parallel(
+	  t_list_d ** list
+	, int (*f_compare)(void * elem, void * data)
+	, int flags
+	, t_pool * pool
+	, size_t grain
+);
+
 #endif /* !MS_DOUBLY_LINKED_H */
 
 /* EOF */
\ No newline at end of file
@@ -0,0 +1,197 @@
+#ifndef MS_INTRUSIVE_LINKED_H
+# define MS_INTRUSIVE_LINKED_H
+
+# include <ms_struct.h>
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+/*
+ * Hook to embed in the user structure (retrieved with MS_CONTAINER_OF).
+ * A list is a circular ring around a sentinel hook, so that
+ * no operation has to test for the ends of the list
+*/
+struct s_ilist
+{
+	struct s_ilist * next;
+	struct s_ilist * prev;
+};
+
+typedef struct s_ilist t_ilist;
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+/*! Intrusive List init
+ *
+ * @brief Initialize a sentinel (an empty list) or an unlinked hook
+ *
+ * @param head
+ *     (input) hook to initialize
+ *
+ * @result NaN.
+*/
+void ilist_init(t_ilist * head);
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+/*! Intrusive List is empty
+ *
+ * @brief Check if the intrusive list is empty
+ *
+ * @param head
+ *     (input) sentinel of the list
+ *
+ * @result If successful, 1 is returned.
+ *         Otherwise, a 0 is returned.
+*/
+int ilist_is_empty(const t_ilist * head);
+
+/*! Intrusive List is linked
+ *
+ * @brief Check if a hook is currently on a list
+ *
+ * @param node
+ *     (input) hook initialized with ilist_init
+ *
+ * @result If successful, 1 is returned.
+ *         Otherwise, a 0 is returned.
+*/
+int ilist_is_linked(const t_ilist * node);
+
+/*! Intrusive List size
+ *
+ * @brief Return the size of the intrusive list
+ *
+ * @param head
+ *     (input) sentinel of the list
+ *
+ * @result If successful, size is returned.
+ *         Otherwise, a 0 is returned.
+*/
+size_t ilist_size(const t_ilist * head);
+
+/*! Intrusive List push front
+ *
+ * @brief Link a hook at the beginning of the list, without allocation
+ *
+ * @param head
+ *     (input) sentinel of the list
+ * @param node
+ *     (input) hook to link
+ *
+ * @result NaN.
+*/
+void ilist_push_front(
+	  t_ilist * head
+	, t_ilist * node
+);
+
+/*! Intrusive List push back
+ *
+ * @brief Link a hook at the end of the list, without allocation
+ *
+ * @param head
+ *     (input) sentinel of the list
+ * @param node
+ *     (input) hook to link
+ *
+ * @result NaN.
+*/
+void ilist_push_back(
+	  t_ilist * head
+	, t_ilist * node
+);
+
+/*! Intrusive List remove
+ *
+ * @brief Unlink a hook from its list in O(1). The hook is left
+ *        initialized, so removing it twice is harmless
+ *
+ * @param node
+ *     (input) hook to unlink
+ *
+ * @result NaN.
+*/
+void ilist_remove(t_ilist * node);
+
+/*! Intrusive List pop front
+ *
+ * @brief Unlink and return the first hook of the list
+ *
+ * @param head
+ *     (input) sentinel of the list
+ *
+ * @result If successful, the hook is returned.
+ *         Otherwise, NULL is returned.
+*/
+t_ilist * ilist_pop_front(t_ilist * head);
+
+/*! Intrusive List front
+ *
+ * @brief Return the first hook of the list
+ *
+ * @param head
+ *     (input) sentinel of the list
+ *
+ * @result If successful, the hook is returned.
+ *         Otherwise, NULL is returned.
+*/
+t_ilist * ilist_front(const t_ilist * head);
+
+/*! Intrusive List back
+ *
+ * @brief Return the last hook of the list
+ *
+ * @param head
+ *     (input) sentinel of the list
+ *
+ * @result If successful, the hook is returned.
+ *         Otherwise, NULL is returned.
+*/
+t_ilist * ilist_back(const t_ilist * head);
+
+/*! Intrusive List splice
+ *
+ * @brief Move every hook of a list at the end of another one in O(1)
+ *
+ * @param head
+ *     (input) sentinel of the destination list
+ * @param list
+ *     (input) sentinel of the list to empty
+ *
+ * @result NaN.
+*/
+void ilist_splice(
+	  t_ilist * head
+	, t_ilist * list
+);
+
+/*! Intrusive List function
+ *
+ * @brief Apply a function to each hook of the list, front to back.
+ *        The function may remove the hook it is given
+ *
+ * @param head
+ *     (input) sentinel of the list
+ * @param content
+ *     (output) data to retrieve
+ * @param f_fct
+ *     (input) function to apply on the hook
+ *             @param node
+ *                 (input) hook
+ *             @param content
+ *                 (output) data to retrieve
+ *             @result If successful, 0 is returned.
+ *                     Otherwise, a number is returned.
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a number is returned.
+*/
+int ilist_fct(
+	  t_ilist * head
+	, void ** content
+	, int (*f_fct)(t_ilist * node, void ** content)
+);
+
+#endif /* !MS_INTRUSIVE_LINKED_H */
+
+/* EOF */
\ No newline at end of file
@@ -2,6 +2,7 @@
 # define MS_SINGLY_LINKED_H
 
 # include <ms_struct.h>
+# include <ms_list/ms_sort.h>
 
 /*----------------------------------- STRUCTURES ------------------------------------*/
 
@@ -84,6 +85,37 @@ int list_s_fct(
 	, int (*f_fct)(void * data)
 );
 
+/*! Singly-linked List function parallel
+ *
+ * @brief Apply a function to each nodes of singly-linked list, chunks of
+ *        nodes shared by the threads of a pool, in no given order. Once
+ *        f_fct fails, the nodes not reached yet are skipped
+ *
+ * @note The list may not be modified meanwhile
+ *
+ * @param list
+ *     (input) singly-linked list
+ * @param f_fct
+ *     (input) function to apply on the data, called concurrently
+ *             @param data
+ *                 (input) data
+ *             @result If successful, 0 is returned.
+ *                     Otherwise, a number is returned.
+ * @param pool
+ *     (input) pool, or NULL to run on the calling thread only
+ * @param grain
+ *     (input) nodes of a task, 0 for MS_POOL_GRAIN
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, the first number returned by f_fct is returned.
+*/
+int list_s_fct_parallel(
+	  t_list_s ** list
+	, int (*f_fct)(void * data)
+	, t_pool * pool
+	, size_t grain
+);
+
 /*! Singly-linked List push front
  *
  * @brief Push an element on top of singly-linked list
@@ -180,6 +212,70 @@ void *list_s_nth_element(
 	, int flag
 );
 
+/*! Singly-linked List sort
+ *
+ * @brief Sort the singly-linked list in increasing order, stable, relinking its
+ *        nodes without allocating (ms_sort.h)
+ *
+ * @param list
+ *     (input) address of the singly-linked list
+ * @param f_compare
+ *     (input) function use to compare two data
+ *             @param elem
+ *                 (input) elem to compare
+ *             @param data
+ *                 (input) data to compare
+ *
+ *             @result If equals, 0 is returned.
+ *                     If greater, 1 is returned.
+ *                     If smaller, -1 is returned.
+ * @param flags
+ *     (input) 0, or MS_SORT_NATURAL for a list nearly sorted
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int list_s_sort(
+	  t_list_s ** list
+	, int (*f_compare)(void * elem, void * data)
+	, int flags
+);
+
+/*! Singly-linked List sort parallel
+ *
+ * @brief Sort the singly-linked list as list_s_sort, its parts sorted by the
+ *        threads of a pool
+ *
+ * @param list
+ *     (input) address of the singly-linked list
+ * @param f_compare
+ *     (input) function use to compare two data, called concurrently
+ *             @param elem
+ *                 (input) elem to compare
+ *             @param data
+ *                 (input) data to compare
+ *
+ *             @result If equals, 0 is returned.
+ *                     If greater, 1 is returned.
+ *                     If smaller, -1 is returned.
+ * @param flags
+ *     (input) 0, or MS_SORT_NATURAL for a list nearly sorted
+ * @param pool
+ *     (input) pool, or NULL to sort on the calling thread only
+ * @param grain
+ *     (input) nodes of a task, 0 for MS_POOL_GRAIN
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int list_s_sort_parallel(
+	  t_list_s ** list
+	, int (*f_compare)(void * elem, void * data)
+	, int flags
+	, t_pool * pool
+	, size_t grain
+);
+
 #endif /* !MS_SINGLY_LINKED_H */
 
 /* EOF */
\ No newline at end of file
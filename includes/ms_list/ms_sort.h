@@ -0,0 +1,96 @@
+#ifndef MS_SORT_H
+# define MS_SORT_H
+
+# include <ms_struct.h>
+# include <ms_pool.h>
+
+/*
+ * Flag of the list sorts: take the runs already in order, increasing or
+ * strictly decreasing, instead of single nodes. A sorted or reversed
+ * list is then sorted in a single pass
+*/
+# define MS_SORT_NATURAL              MS_CAST(int, 0x01)
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+/*! Sort chain
+ *
+ * @brief Stable merge sort of a chain of nodes, in increasing order. The
+ *        nodes are relinked, nothing is allocated: the sort is bottom-up,
+ *        each run merged into bins of sorted runs, as a binary counter
+ *
+ * @note The `prev` links, if any, are left to the caller
+ *
+ * @param first
+ *     (input) first node of the chain, the last one ends with NULL
+ * @param next
+ *     (input) offset of the pointer to the next node in a node
+ * @param data
+ *     (input) offset of the pointer to the data in a node
+ * @param f_compare
+ *     (input) function use to compare two data
+ *             @param elem
+ *                 (input) elem to compare
+ *             @param data
+ *                 (input) data to compare
+ *
+ *             @result If equals, 0 is returned.
+ *                     If greater, 1 is returned.
+ *                     If smaller, -1 is returned.
+ * @param flags
+ *     (input) 0 or MS_SORT_NATURAL
+ *
+ * @result The first node of the sorted chain is returned.
+*/
+void * list_sort_chain(
+	  void * first
+	, size_t next
+	, size_t data
+	, int (*f_compare)(void * elem, void * data)
+	, int flags
+);
+
+/*! Sort chain parallel
+ *
+ * @brief Sort a chain as list_sort_chain: the chain is cut in halves,
+ *        forked on a pool, until its parts hold `grain` nodes, then the
+ *        parts sorted are merged back
+ *
+ * @param first
+ *     (input) first node of the chain, the last one ends with NULL
+ * @param next
+ *     (input) offset of the pointer to the next node in a node
+ * @param data
+ *     (input) offset of the pointer to the data in a node
+ * @param f_compare
+ *     (input) function use to compare two data, called concurrently
+ *             @param elem
+ *                 (input) elem to compare
+ *             @param data
+ *                 (input) data to compare
+ *
+ *             @result If equals, 0 is returned.
+ *                     If greater, 1 is returned.
+ *                     If smaller, -1 is returned.
+ * @param flags
+ *     (input) 0 or MS_SORT_NATURAL
+ * @param pool
+ *     (input) pool, or NULL to sort on the calling thread only
+ * @param grain
+ *     (input) nodes of a task, 0 for MS_POOL_GRAIN
+ *
+ * @result The first node of the sorted chain is returned.
+*/
+void * list_sort_chain_parallel(
+	  void * first
+	, size_t next
+	, size_t data
+	, int (*f_compare)(void * elem, void * data)
+	, int flags
+	, t_pool * pool
+	, size_t grain
+);
+
+#endif /* !MS_SORT_H */
+
+/* EOF */
\ No newline at end of file
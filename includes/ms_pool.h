@@ -0,0 +1,172 @@
+#ifndef MS_POOL_H
+# define MS_POOL_H
+
+# include <ms_struct.h>
+# include <ms_list/ms_intrusive_linked.h>
+
+/*
+ * Work stealing: every worker forks its tasks on its own deque and takes
+ * them back from the bottom, the idle workers steal the oldest ones from
+ * the top of the others. A thread joining a task runs other tasks
+ * meanwhile, so that fork-join never blocks a core
+*/
+
+/*
+ * Tasks a worker holds at once, past them a fork runs the task directly
+*/
+# define MS_POOL_DEQUE                256
+
+/*
+ * Default number of elements of a task of pool_parallel_for
+*/
+# define MS_POOL_GRAIN                1024
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+struct s_pool;
+
+/* Type opaque */
+typedef struct s_pool t_pool;
+
+/*
+ * A task forked by pool_fork, usually on the stack of the thread that
+ * joins it. `hook` queues the tasks forked by threads out of the pool
+*/
+typedef struct s_pool_task
+{
+	void    (*f_run)(void * arg);
+	void    * arg;
+	int       done;
+	t_ilist   hook;
+} t_pool_task;
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+/*! Pool init
+ *
+ * @brief Start a pool of worker threads. The thread calling pool_join or
+ *        pool_parallel_for works as well while it waits
+ *
+ * @param pool
+ *     (input) pool to initialize
+ * @param threads
+ *     (input) number of workers, 0 for one per online core
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int pool_init(
+	  t_pool ** pool
+	, size_t threads
+);
+
+/*! Pool destroy
+ *
+ * @brief Stop the workers and dealloc a pool
+ *
+ * @note Every task forked must have been joined
+ *
+ * @param pool
+ *     (input) pool to free
+ *
+ * @result NaN
+*/
+void pool_destroy(t_pool * pool);
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+/*! Pool size
+ *
+ * @brief Return the number of workers of the pool
+ *
+ * @param pool
+ *     (input) pool
+ *
+ * @result If successful, the number of workers is returned.
+ *         Otherwise, a 0 is returned.
+*/
+size_t pool_size(const t_pool * pool);
+
+/*! Pool fork
+ *
+ * @brief Make a task available to the pool, to be run by any thread.
+ *        Without a pool, or once the deque of the worker is full,
+ *        the task is run at once
+ *
+ * @param pool
+ *     (input) pool, or NULL
+ * @param task
+ *     (input) task, valid until pool_join returns
+ * @param f_run
+ *     (input) function of the task
+ *             @param arg
+ *                 (input) argument of the task
+ *             @result NaN
+ * @param arg
+ *     (input) argument of the task
+ *
+ * @result NaN
+*/
+void pool_fork(
+	  t_pool * pool
+	, t_pool_task * task
+	, void (*f_run)(void * arg)
+	, void * arg
+);
+
+/*! Pool join
+ *
+ * @brief Wait for a task forked, running the tasks of the pool meanwhile
+ *
+ * @param pool
+ *     (input) pool the task was forked on, or NULL
+ * @param task
+ *     (input) task
+ *
+ * @result NaN
+*/
+void pool_join(
+	  t_pool * pool
+	, t_pool_task * task
+);
+
+/*! Pool parallel for
+ *
+ * @brief Apply a function to every index of [begin, end): the range is
+ *        split in halves, forked, until its parts hold `grain` indexes
+ *
+ * @param pool
+ *     (input) pool, or NULL to run on the calling thread only
+ * @param begin
+ *     (input) first index
+ * @param end
+ *     (input) index after the last one
+ * @param grain
+ *     (input) indexes of a task, 0 for MS_POOL_GRAIN
+ * @param f_range
+ *     (input) function applied to a part, concurrently with the others
+ *             @param begin
+ *                 (input) first index of the part
+ *             @param end
+ *                 (input) index after the last one of the part
+ *             @param arg
+ *                 (input) argument given to pool_parallel_for
+ *             @result NaN
+ * @param arg
+ *     (input) argument of f_range
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int pool_parallel_for(
+	  t_pool * pool
+	, size_t begin
+	, size_t end
+	, size_t grain
+	, void (*f_range)(size_t begin, size_t end, void * arg)
+	, void * arg
+);
+
+#endif /* !MS_POOL_H */
+
+/* EOF */
\ No newline at end of file
@@ -0,0 +1,168 @@
+#ifndef MS_QUEUE_BLOCKING_H
+# define MS_QUEUE_BLOCKING_H
+
+# include <ms_struct.h>
+# include <ms_futex.h>
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+struct s_queue_bk;
+
+/* Type opaque */
+typedef struct s_queue_bk t_queue_bk;
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+/*! Blocking Queue init
+ *
+ * @brief Initialize a bounded queue shared by several threads: a producer
+ *        waits for room once the queue is full, a consumer for an element
+ *        once it is empty. A thread waiting spins briefly then sleeps on a
+ *        futex (ms_futex.h), and is only woken when it may go on
+ *
+ * @param queue
+ *     (input) queue to initialize
+ * @param capacity
+ *     (input) maximum number of elements
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int queue_bk_init(
+	  t_queue_bk ** queue
+	, size_t capacity
+);
+
+/*! Blocking Queue destroy
+ *
+ * @brief Dealloc a queue
+ *
+ * @note No other thread may use the queue anymore
+ *
+ * @param queue
+ *     (input) queue to free
+ * @param f_free
+ *     (input) function to free the data
+ *             @param data
+ *                 (input) data to free
+ *             @result NaN
+ *
+ * @result NaN
+*/
+void queue_bk_destroy(
+	  t_queue_bk * queue
+	, void (*f_free)(void * data)
+);
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+/*! Blocking Queue size
+ *
+ * @brief Return the number of elements of the queue
+ *
+ * @param queue
+ *     (input) queue
+ *
+ * @result If successful, size is returned.
+ *         Otherwise, a 0 is returned.
+*/
+size_t queue_bk_size(t_queue_bk * queue);
+
+/*! Blocking Queue enqueue wait
+ *
+ * @brief Add an element at the end of the queue, waiting for room
+ *
+ * @param queue
+ *     (input) queue
+ * @param data
+ *     (input) data to add to the queue, not NULL
+ * @param size
+ *     (input) size of the content to allocate.
+ *             If the size is 0, no copy occurs
+ * @param timeout
+ *     (input) timeout in milliseconds, 0 to not wait,
+ *             or MS_FUTEX_INFINITE
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int queue_bk_enqueue_wait(
+	  t_queue_bk * queue
+	, void * data
+	, size_t size
+	, long timeout
+);
+
+/*! Blocking Queue enqueue batch
+ *
+ * @brief Add several elements at the end of the queue, as many at once as
+ *        there is room for, waiting for room for the others. The consumers
+ *        waiting are woken once per group of elements added, not once per
+ *        element
+ *
+ * @param queue
+ *     (input) queue
+ * @param datas
+ *     (input) data to add to the queue, not NULL, no copy occurs
+ * @param count
+ *     (input) number of data
+ * @param timeout
+ *     (input) timeout in milliseconds, 0 to not wait,
+ *             or MS_FUTEX_INFINITE
+ *
+ * @result Return the number of elements added.
+*/
+size_t queue_bk_enqueue_batch(
+	  t_queue_bk * queue
+	, void ** datas
+	, size_t count
+	, long timeout
+);
+
+/*! Blocking Queue dequeue wait
+ *
+ * @brief Return the first element of the queue and remove it,
+ *        waiting for one
+ *
+ * @param queue
+ *     (input) queue
+ * @param timeout
+ *     (input) timeout in milliseconds, 0 to not wait,
+ *             or MS_FUTEX_INFINITE
+ *
+ * @result If successful, the data is returned.
+ *         Otherwise, NULL is returned.
+*/
+void * queue_bk_dequeue_wait(
+	  t_queue_bk * queue
+	, long timeout
+);
+
+/*! Blocking Queue dequeue batch
+ *
+ * @brief Remove up to `count` elements from the front of the queue,
+ *        waiting for at least one. The producers waiting are woken once
+ *        for all the room made
+ *
+ * @param queue
+ *     (input) queue
+ * @param datas
+ *     (output) elements removed, in order
+ * @param count
+ *     (input) maximum number of elements
+ * @param timeout
+ *     (input) timeout in milliseconds, 0 to not wait,
+ *             or MS_FUTEX_INFINITE
+ *
+ * @result Return the number of elements removed.
+*/
+size_t queue_bk_dequeue_batch(
+	  t_queue_bk * queue
+	, void ** datas
+	, size_t count
+	, long timeout
+);
+
+#endif /* !MS_QUEUE_BLOCKING_H */
+
+/* EOF */
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef MS_STRUCT_H
 # define MS_STRUCT_H
 
+# include <stddef.h>
 # include <stdlib.h>
 # include <string.h>
 
@@ -9,22 +10,62 @@
 */
 # define __SYS_MEMSET(dst, c, size)   memset(dst, c, size)
 # define __SYS_MEMCPY(dst, src, size) memcpy(dst, src, size)
+# define __SYS_MEMMOVE(dst, src, len) memmove(dst, src, len)
+# define __SYS_MEMCMP(s1, s2, size)   memcmp(s1, s2, size)
 # define __SYS_MALLOC(size)           malloc(size)
+# define __SYS_MALLOC_ALIGN(a, size)  aligned_alloc(a, ((size) + (a) - 1) & ~((a) - 1))
 # define __SYS_DEALLOC(addr)          free(addr)
 # define __SYS_CAST(type, content)    (type)content
 # define __SYS_UNUSED(content)        (void)content
+# define __SYS_OFFSETOF(type, member) offsetof(type, member)
+# define __SYS_PREFETCH(addr)         __builtin_prefetch(addr)
+# define __SYS_ALIGNED(a)             __attribute__((aligned(a)))
+# define __SYS_ATOMIC_INC(addr)       __atomic_add_fetch(addr, 1, __ATOMIC_RELAXED)
+# define __SYS_ATOMIC_DEC(addr)       __atomic_sub_fetch(addr, 1, __ATOMIC_ACQ_REL)
+# define __SYS_ATOMIC_LOAD(addr)      __atomic_load_n(addr, __ATOMIC_ACQUIRE)
+# define __SYS_ATOMIC_STORE(addr, v)  __atomic_store_n(addr, v, __ATOMIC_RELEASE)
+# define __SYS_ATOMIC_CAS(addr, o, n) __atomic_compare_exchange_n(addr, o, n, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+# define __SYS_ATOMIC_FENCE()         __atomic_thread_fence(__ATOMIC_SEQ_CST)
+# define __SYS_COMPILER_FENCE()       __atomic_signal_fence(__ATOMIC_SEQ_CST)
+# if defined(__x86_64__) || defined(__i386__)
+#  define __SYS_CPU_RELAX()           __builtin_ia32_pause()
+# else
+#  define __SYS_CPU_RELAX()           __SYS_COMPILER_FENCE()
+# endif
 
 /*
  * MS_STRUCT specific define
 */
-# define MS_ADDRNULL(addr)            (addr == NULL) ? 1 : 0
-# define MS_ADDRCK(addr)              (addr == NULL) ? 0 : 1
+# define MS_ADDRNULL(addr)            ((addr == NULL) ? 1 : 0)
+# define MS_ADDRCK(addr)              ((addr == NULL) ? 0 : 1)
 # define MS_CAST(type, content)       __SYS_CAST(type, content)
 # define MS_UNUSED(content)           __SYS_UNUSED(content)
 # define MS_ALLOC(size)               __SYS_MALLOC(size)
+# define MS_ALLOC_ALIGN(a, size)      __SYS_MALLOC_ALIGN(a, size)
 # define MS_DEALLOC(addr)             __SYS_DEALLOC(addr)
 # define MS_MEMSET(dst, c, size)      __SYS_MEMSET(dst, c, size)
 # define MS_MEMCPY(dst, src, size)    __SYS_MEMCPY(dst, src, size)
+# define MS_MEMMOVE(dst, src, len)    __SYS_MEMMOVE(dst, src, len)
+# define MS_MEMCMP(s1, s2, size)      __SYS_MEMCMP(s1, s2, size)
+# define MS_PREFETCH(addr)            __SYS_PREFETCH(addr)
+# define MS_ALIGNED(a)                __SYS_ALIGNED(a)
+# define MS_OFFSETOF(type, member)    __SYS_OFFSETOF(type, member)
+# define MS_ATOMIC_INC(addr)          __SYS_ATOMIC_INC(addr)
+# define MS_ATOMIC_DEC(addr)          __SYS_ATOMIC_DEC(addr)
+# define MS_ATOMIC_LOAD(addr)         __SYS_ATOMIC_LOAD(addr)
+# define MS_ATOMIC_STORE(addr, v)     __SYS_ATOMIC_STORE(addr, v)
+# define MS_ATOMIC_CAS(addr, o, n)    __SYS_ATOMIC_CAS(addr, o, n)
+# define MS_ATOMIC_FENCE()            __SYS_ATOMIC_FENCE()
+# define MS_COMPILER_FENCE()          __SYS_COMPILER_FENCE()
+# define MS_CPU_RELAX()               __SYS_CPU_RELAX()
+
+/*
+ * Structure embedding the hook `ptr` as its field `member`
+*/
+# define MS_CONTAINER_OF(ptr, type, member) \
+	((type *)(MS_CAST(char *, (ptr)) - __SYS_OFFSETOF(type, member)))
+
+# define MS_CACHE_LINE                64
 
 # define MS_ELEMENT_REMOVE            MS_CAST(int, 0x01)
 
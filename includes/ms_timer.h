@@ -0,0 +1,185 @@
+#ifndef MS_TIMER_H
+# define MS_TIMER_H
+
+# include <ms_struct.h>
+# include <ms_list/ms_intrusive_linked.h>
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+/*
+ * Hook to embed in the user structure (retrieved with MS_CONTAINER_OF).
+ * `list` links the timer in its slot, `expires` is counted in ticks,
+ * `level` is 0 when the timer is not armed, its level + 1 otherwise
+*/
+struct s_timer
+{
+	t_ilist list;
+	size_t  expires;
+	size_t  level;
+};
+
+typedef struct s_timer t_timer;
+
+struct s_timer_wheel;
+
+/* Type opaque */
+typedef struct s_timer_wheel t_timer_wheel;
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+/*! Timer init
+ *
+ * @brief Initialize a timer, not armed
+ *
+ * @param timer
+ *     (input) timer to initialize
+ *
+ * @result NaN.
+*/
+void timer_init(t_timer * timer);
+
+/*! Timer wheel init
+ *
+ * @brief Initialize a hierarchical timing wheel: 5 levels of 64 slots,
+ *        each slot of a level covering a whole turn of the level below.
+ *        A timer is armed in the level matching how far it expires,
+ *        and cascades down one level each time the level below turns
+ *
+ * @param wheel
+ *     (input) wheel to initialize
+ * @param now
+ *     (input) current tick
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int timer_wheel_init(
+	  t_timer_wheel ** wheel
+	, size_t now
+);
+
+/*! Timer wheel destroy
+ *
+ * @brief Dealloc a wheel, the timers still armed are disarmed
+ *
+ * @param wheel
+ *     (input) wheel to free
+ *
+ * @result NaN.
+*/
+void timer_wheel_destroy(t_timer_wheel * wheel);
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+/*! Timer wheel size
+ *
+ * @brief Return the number of timers armed
+ *
+ * @param wheel
+ *     (input) wheel
+ *
+ * @result If successful, size is returned.
+ *         Otherwise, a 0 is returned.
+*/
+size_t timer_wheel_size(const t_timer_wheel * wheel);
+
+/*! Timer wheel now
+ *
+ * @brief Return the current tick of the wheel
+ *
+ * @param wheel
+ *     (input) wheel
+ *
+ * @result If successful, the tick is returned.
+ *         Otherwise, a 0 is returned.
+*/
+size_t timer_wheel_now(const t_timer_wheel * wheel);
+
+/*! Timer is armed
+ *
+ * @brief Return whether a timer is armed in a wheel
+ *
+ * @param timer
+ *     (input) timer
+ *
+ * @result If armed, 1 is returned.
+ *         Otherwise, a 0 is returned.
+*/
+int timer_is_armed(const t_timer * timer);
+
+/*! Timer wheel arm
+ *
+ * @brief Arm a timer, in O(1). A timer already armed is moved.
+ *        A timer expiring past the last level waits in it and
+ *        cascades again, a timer already expired expires at the
+ *        next tick
+ *
+ * @param wheel
+ *     (input) wheel
+ * @param timer
+ *     (input) timer to arm
+ * @param expires
+ *     (input) tick at which the timer expires
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int timer_wheel_arm(
+	  t_timer_wheel * wheel
+	, t_timer * timer
+	, size_t expires
+);
+
+/*! Timer wheel cancel
+ *
+ * @brief Disarm a timer, in O(1)
+ *
+ * @param wheel
+ *     (input) wheel holding the timer
+ * @param timer
+ *     (input) timer to disarm
+ *
+ * @result If the timer was armed, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int timer_wheel_cancel(
+	  t_timer_wheel * wheel
+	, t_timer * timer
+);
+
+/*! Timer wheel advance
+ *
+ * @brief Move the wheel forward to a tick, in O(1) per tick and per
+ *        timer cascaded, the ticks of the empty lower levels skipped.
+ *        The timers expired are disarmed and handed over in a single
+ *        batch, in order of expiry
+ *
+ * @param wheel
+ *     (input) wheel
+ * @param now
+ *     (input) new current tick, not before the current one
+ * @param f_expire
+ *     (input) function called once with the timers expired, or NULL
+ *             @param expired
+ *                 (input) sentinel of the list of the timers, linked
+ *                         by their `list`. The timers may be popped
+ *                         and armed again, the others are unlinked
+ *                         when the function returns
+ *             @param arg
+ *                 (input) argument passed to the function
+ *             @result NaN
+ * @param arg
+ *     (input) argument passed to f_expire
+ *
+ * @result The number of timers expired is returned.
+*/
+size_t timer_wheel_advance(
+	  t_timer_wheel * wheel
+	, size_t now
+	, void (*f_expire)(t_ilist * expired, void * arg)
+	, void * arg
+);
+
+#endif /* !MS_TIMER_H */
+
+/* EOF */
\ No newline at end of file
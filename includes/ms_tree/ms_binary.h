@@ -188,6 +188,42 @@ void * tree_search(
 	, int (*f_compare)(void * elem, void * data)
 );
 
+/*! Tree search batch
+ *
+ * @brief Find several elements on the tree at once.
+ *        The descents advance in lockstep, one level per round,
+ *        and the next node of each descent is prefetched so that
+ *        the cache misses of the different keys overlap
+ *
+ * @param tree
+ *     (input) tree
+ * @param datas
+ *     (input) data to find on the tree
+ * @param count
+ *     (input) number of data
+ * @param elems
+ *     (output) element found for each data, or NULL
+ * @param f_compare
+ *     (input) function use to compare two data
+ *             @param elem
+ *                 (input) elem to compare
+ *             @param data
+ *                 (input) data to compare
+ *
+ *             @result If equals, 0 is returned.
+ *                     If greater, 1 is returned.
+ *                     If smaller, -1 is returned.
+ *
+ * @result Return the number of elements found.
+*/
+size_t tree_search_batch(
+	  t_tree ** tree
+	, void ** datas
+	, size_t count
+	, void ** elems
+	, int (*f_compare)(void * elem, void * data)
+);
+
 /*! Tree function (pre-order)
  *
  * @brief Apply a function to each leef of tree
@@ -0,0 +1,216 @@
+#ifndef MS_FROZEN_H
+# define MS_FROZEN_H
+
+# include <ms_struct.h>
+# include <ms_pool.h>
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+struct s_tree_fz;
+
+/* Type opaque */
+typedef struct s_tree_fz t_tree_fz;
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+/*! Frozen Tree init
+ *
+ * @brief Build an immutable search tree from a sorted array.
+ *        The elements are stored in Eytzinger (BFS) order
+ *        in a single cache-aligned array, without any pointer per node
+ *
+ * @param tree
+ *     (input) tree to initialize
+ * @param datas
+ *     (input) array of data sorted in increasing order
+ * @param count
+ *     (input) number of data in the array
+ * @param f_key
+ *     (input) optional function extracting an integer key from the data.
+ *             If set, the keys are stored next to the data
+ *             and tree_fz_search_key(s) can be used
+ *             @param data
+ *                 (input) data
+ *             @result Return the key of the data
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int tree_fz_init(
+	  t_tree_fz ** tree
+	, void ** datas
+	, size_t count
+	, long (*f_key)(void * data)
+);
+
+/*! Frozen Tree init parallel
+ *
+ * @brief Build a frozen tree as tree_fz_init, its subtrees filled
+ *        by the threads of a pool
+ *
+ * @param tree
+ *     (input) tree to initialize
+ * @param datas
+ *     (input) array of data sorted in increasing order
+ * @param count
+ *     (input) number of data in the array
+ * @param f_key
+ *     (input) optional function extracting an integer key from the data,
+ *             called concurrently
+ *             @param data
+ *                 (input) data
+ *             @result Return the key of the data
+ * @param pool
+ *     (input) pool, or NULL to build on the calling thread only
+ * @param grain
+ *     (input) nodes of a task, 0 for MS_POOL_GRAIN
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int tree_fz_init_parallel(
+	  t_tree_fz ** tree
+	, void ** datas
+	, size_t count
+	, long (*f_key)(void * data)
+	, t_pool * pool
+	, size_t grain
+);
+
+/*! Frozen Tree destroy
+ *
+ * @brief Dealloc a frozen tree
+ *
+ * @note The data are shared with the source of the tree,
+ *       only one of them should free it
+ *
+ * @param tree
+ *     (input) tree to free
+ * @param f_free
+ *     (input) function to free the data
+ *             @param data
+ *                 (input) data to free
+ *             @result NaN
+ *
+ * @result NaN.
+*/
+void tree_fz_destroy(
+	  t_tree_fz * tree
+	, void (*f_free)(void * data)
+);
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+/*! Frozen Tree size
+ *
+ * @brief Return the size of the tree
+ *
+ * @param tree
+ *     (input) tree
+ *
+ * @result If successful, size is returned.
+ *         Otherwise, a 0 is returned.
+*/
+size_t tree_fz_size(const t_tree_fz * tree);
+
+/*! Frozen Tree search
+ *
+ * @brief Find an element on the tree (branch-free descent)
+ *
+ * @param tree
+ *     (input) tree
+ * @param data
+ *     (input) data to find on the tree
+ * @param f_compare
+ *     (input) function use to compare two data
+ *             @param elem
+ *                 (input) elem to compare
+ *             @param data
+ *                 (input) data to compare
+ *
+ *             @result If equals, 0 is returned.
+ *                     If greater, 1 is returned.
+ *                     If smaller, -1 is returned.
+ *
+ * @result If successful, the element is returned.
+ *         Otherwise, NULL is returned.
+*/
+void * tree_fz_search(
+	  const t_tree_fz * tree
+	, void * data
+	, int (*f_compare)(void * elem, void * data)
+);
+
+/*! Frozen Tree search key
+ *
+ * @brief Find an element on the tree from its integer key
+ *
+ * @note Only available if the tree was built with f_key
+ *
+ * @param tree
+ *     (input) tree
+ * @param key
+ *     (input) key to find on the tree
+ *
+ * @result If successful, the element is returned.
+ *         Otherwise, NULL is returned.
+*/
+void * tree_fz_search_key(
+	  const t_tree_fz * tree
+	, long key
+);
+
+/*! Frozen Tree search keys
+ *
+ * @brief Find several elements on the tree from their integer keys.
+ *        The descents run in lockstep, with AVX2 when available
+ *
+ * @note Only available if the tree was built with f_key
+ *
+ * @param tree
+ *     (input) tree
+ * @param keys
+ *     (input) keys to find on the tree
+ * @param count
+ *     (input) number of keys
+ * @param elems
+ *     (output) element found for each key, or NULL
+ *
+ * @result Return the number of elements found.
+*/
+size_t tree_fz_search_keys(
+	  const t_tree_fz * tree
+	, const long * keys
+	, size_t count
+	, void ** elems
+);
+
+/*! Frozen Tree function (in-order)
+ *
+ * @brief Apply a function to each leef of tree
+ *
+ * @param tree
+ *     (input) tree
+ * @param content
+ *     (output) data to retrieve
+ * @param f_fct
+ *     (input) function to apply on the data
+ *             @param data
+ *                 (input) data
+ *             @param content
+ *                 (output) data to retrieve
+ *             @result If successful, 0 is returned.
+ *                     Otherwise, a number is returned.
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a number is returned.
+*/
+int tree_fz_in_order(
+	  const t_tree_fz * tree
+	, void ** content
+	, int (*f_fct)(void * data, void ** content)
+);
+
+#endif /* !MS_FROZEN_H */
+
+/* EOF */
\ No newline at end of file
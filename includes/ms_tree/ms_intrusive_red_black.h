@@ -0,0 +1,217 @@
+#ifndef MS_INTRUSIVE_RED_BLACK_H
+# define MS_INTRUSIVE_RED_BLACK_H
+
+# include <ms_struct.h>
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+/*
+ * Hook to embed in the user structure (retrieved with MS_CONTAINER_OF)
+*/
+struct s_itree_rb
+{
+	struct s_itree_rb * left;
+	struct s_itree_rb * right;
+	struct s_itree_rb * parent;
+	int                 color;
+};
+
+typedef struct s_itree_rb t_itree_rb;
+
+struct s_itree_rb_root
+{
+	t_itree_rb * root;
+	size_t       size;
+};
+
+typedef struct s_itree_rb_root t_itree_rb_root;
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+/*! Intrusive Red Black Tree init
+ *
+ * @brief Initialize an empty tree
+ *
+ * @param tree
+ *     (input) tree to initialize
+ *
+ * @result NaN.
+*/
+void itree_rb_init(t_itree_rb_root * tree);
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+/*! Intrusive Red Black Tree is empty
+ *
+ * @brief Check if the tree is empty
+ *
+ * @param tree
+ *     (input) tree
+ *
+ * @result If successful, 1 is returned.
+ *         Otherwise, a 0 is returned.
+*/
+int itree_rb_is_empty(const t_itree_rb_root * tree);
+
+/*! Intrusive Red Black Tree size
+ *
+ * @brief Return the size of the tree
+ *
+ * @param tree
+ *     (input) tree
+ *
+ * @result If successful, size is returned.
+ *         Otherwise, a 0 is returned.
+*/
+size_t itree_rb_size(const t_itree_rb_root * tree);
+
+/*! Intrusive Red Black Tree insert
+ *
+ * @brief Link a hook into the tree, without allocation
+ *
+ * @param tree
+ *     (input) tree
+ * @param node
+ *     (input) hook to link
+ * @param f_compare
+ *     (input) function use to compare two hooks
+ *             @param elem
+ *                 (input) hook of the tree to compare
+ *             @param node
+ *                 (input) hook to insert
+ *
+ *             @result If equals, 0 is returned.
+ *                     If greater, 1 is returned.
+ *                     If smaller, -1 is returned.
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int itree_rb_insert(
+	  t_itree_rb_root * tree
+	, t_itree_rb * node
+	, int (*f_compare)(t_itree_rb * elem, t_itree_rb * node)
+);
+
+/*! Intrusive Red Black Tree remove
+ *
+ * @brief Unlink a hook from the tree in O(log(n)), without searching it
+ *
+ * @param tree
+ *     (input) tree holding the hook
+ * @param node
+ *     (input) hook to unlink
+ *
+ * @result NaN.
+*/
+void itree_rb_remove(
+	  t_itree_rb_root * tree
+	, t_itree_rb * node
+);
+
+/*! Intrusive Red Black Tree search
+ *
+ * @brief Find a hook on the tree
+ *
+ * @param tree
+ *     (input) tree
+ * @param data
+ *     (input) data to find on the tree
+ * @param f_compare
+ *     (input) function use to compare a hook with the data
+ *             @param elem
+ *                 (input) hook of the tree to compare
+ *             @param data
+ *                 (input) data to compare
+ *
+ *             @result If equals, 0 is returned.
+ *                     If greater, 1 is returned.
+ *                     If smaller, -1 is returned.
+ *
+ * @result If successful, the hook is returned.
+ *         Otherwise, NULL is returned.
+*/
+t_itree_rb * itree_rb_search(
+	  const t_itree_rb_root * tree
+	, void * data
+	, int (*f_compare)(t_itree_rb * elem, void * data)
+);
+
+/*! Intrusive Red Black Tree first
+ *
+ * @brief Return the first hook of the tree (in-order)
+ *
+ * @param tree
+ *     (input) tree
+ *
+ * @result If successful, the hook is returned.
+ *         Otherwise, NULL is returned.
+*/
+t_itree_rb * itree_rb_first(const t_itree_rb_root * tree);
+
+/*! Intrusive Red Black Tree last
+ *
+ * @brief Return the last hook of the tree (in-order)
+ *
+ * @param tree
+ *     (input) tree
+ *
+ * @result If successful, the hook is returned.
+ *         Otherwise, NULL is returned.
+*/
+t_itree_rb * itree_rb_last(const t_itree_rb_root * tree);
+
+/*! Intrusive Red Black Tree next
+ *
+ * @brief Return the hook following another one (in-order)
+ *
+ * @param node
+ *     (input) hook linked on a tree
+ *
+ * @result If successful, the hook is returned.
+ *         Otherwise, NULL is returned.
+*/
+t_itree_rb * itree_rb_next(const t_itree_rb * node);
+
+/*! Intrusive Red Black Tree prev
+ *
+ * @brief Return the hook preceding another one (in-order)
+ *
+ * @param node
+ *     (input) hook linked on a tree
+ *
+ * @result If successful, the hook is returned.
+ *         Otherwise, NULL is returned.
+*/
+t_itree_rb * itree_rb_prev(const t_itree_rb * node);
+
+/*! Intrusive Red Black Tree function (in-order)
+ *
+ * @brief Apply a function to each hook of the tree.
+ *        The function may remove the hook it is given
+ *
+ * @param tree
+ *     (input) tree
+ * @param content
+ *     (output) data to retrieve
+ * @param f_fct
+ *     (input) function to apply on the hook
+ *             @param node
+ *                 (input) hook
+ *             @param content
+ *                 (output) data to retrieve
+ *             @result If successful, 0 is returned.
+ *                     Otherwise, a number is returned.
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a number is returned.
+*/
+int itree_rb_in_order(
+	  t_itree_rb_root * tree
+	, void ** content
+	, int (*f_fct)(t_itree_rb * node, void ** content)
+);
+
+#endif /* !MS_INTRUSIVE_RED_BLACK_H */
+
+/* EOF */
\ No newline at end of file
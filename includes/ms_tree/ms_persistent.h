@@ -0,0 +1,167 @@
+#ifndef MS_PERSISTENT_H
+# define MS_PERSISTENT_H
+
+# include <ms_struct.h>
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+struct s_tree_prb;
+
+/* Type opaque */
+typedef struct s_tree_prb t_tree_prb;
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+/*! Persistent Red Black Tree snapshot
+ *
+ * @brief Take a new reference on a version of the tree in O(1).
+ *        The version stays readable until the reference is destroyed
+ *
+ * @note The caller must already own a reference on the version
+ *
+ * @param tree
+ *     (input) version of the tree
+ *
+ * @result Return the same version.
+*/
+t_tree_prb * tree_prb_snapshot(t_tree_prb * tree);
+
+/*! Persistent Red Black Tree destroy
+ *
+ * @brief Release a reference on a version of the tree.
+ *        Only the nodes (and data) no longer shared with
+ *        another version are freed
+ *
+ * @param tree
+ *     (input) version of the tree to release
+ * @param f_free
+ *     (input) function to free the data
+ *             @param data
+ *                 (input) data to free
+ *             @result NaN
+ *
+ * @result NaN.
+*/
+void tree_prb_destroy(
+	  t_tree_prb ** tree
+	, void (*f_free)(void * data)
+);
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+/*! Persistent Red Black Tree is empty
+ *
+ * @brief Check if the tree is empty
+ *
+ * @param tree
+ *     (input) version of the tree
+ *
+ * @result If successful, 1 is returned.
+ *         Otherwise, a 0 is returned.
+*/
+int tree_prb_is_empty(const t_tree_prb * tree);
+
+/*! Persistent Red Black Tree size
+ *
+ * @brief Return the size of the tree
+ *
+ * @param tree
+ *     (input) version of the tree
+ *
+ * @result If successful, size is returned.
+ *         Otherwise, a 0 is returned.
+*/
+size_t tree_prb_size(const t_tree_prb * tree);
+
+/*! Persistent Red Black Tree insert
+ *
+ * @brief Create a new version of the tree containing the data.
+ *        Only the path from the root to the new leef is copied,
+ *        every other subtree is shared with the given version
+ *        which stays valid and unchanged
+ *
+ * @param tree
+ *     (input) version of the tree (NULL for an empty tree)
+ * @param data
+ *     (input) data to insert on the tree
+ * @param size
+ *     (input) size of the content to allocate.
+ *             If the size is 0, no copy occurs
+ * @param f_compare
+ *     (input) function use to compare two data
+ *             @param elem
+ *                 (input) elem to compare
+ *             @param data
+ *                 (input) data to compare
+ *
+ *             @result If equals, 0 is returned.
+ *                     If greater, 1 is returned.
+ *                     If smaller, -1 is returned.
+ *
+ * @result If successful, the new version is returned.
+ *         Otherwise, NULL is returned.
+*/
+t_tree_prb * tree_prb_insert(
+	  t_tree_prb * tree
+	, void * data
+	, size_t size
+	, int (*f_compare)(void * elem, void * data)
+);
+
+/*! Persistent Red Black Tree search
+ *
+ * @brief Find an element on a version of the tree
+ *
+ * @param tree
+ *     (input) version of the tree
+ * @param data
+ *     (input) data to find on the tree
+ * @param f_compare
+ *     (input) function use to compare two data
+ *             @param elem
+ *                 (input) elem to compare
+ *             @param data
+ *                 (input) data to compare
+ *
+ *             @result If equals, 0 is returned.
+ *                     If greater, 1 is returned.
+ *                     If smaller, -1 is returned.
+ *
+ * @result If successful, the element is returned.
+ *         Otherwise, NULL is returned.
+*/
+void * tree_prb_search(
+	  const t_tree_prb * tree
+	, void * data
+	, int (*f_compare)(void * elem, void * data)
+);
+
+/*! Persistent Red Black Tree function (in-order)
+ *
+ * @brief Apply a function to each leef of a version of the tree
+ *
+ * @param tree
+ *     (input) version of the tree
+ * @param content
+ *     (output) data to retrieve
+ * @param f_fct
+ *     (input) function to apply on the data
+ *             @param data
+ *                 (input) data
+ *             @param content
+ *                 (output) data to retrieve
+ *             @result If successful, 0 is returned.
+ *                     Otherwise, a number is returned.
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a number is returned.
+*/
+int tree_prb_in_order(
+	  const t_tree_prb * tree
+	, void ** content
+	, int (*f_fct)(void * data, void ** content)
+);
+
+#endif /* !MS_PERSISTENT_H */
+
+/* EOF */
\ No newline at end of file
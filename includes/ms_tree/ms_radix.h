@@ -0,0 +1,186 @@
+#ifndef MS_RADIX_H
+# define MS_RADIX_H
+
+# include <ms_struct.h>
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+struct s_tree_art;
+
+/* Type opaque */
+typedef struct s_tree_art t_tree_art;
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+/*! Adaptive Radix Tree init
+ *
+ * @brief Initialize an empty adaptive radix tree
+ *
+ * @param tree
+ *     (input) tree to initialize
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int tree_art_init(t_tree_art ** tree);
+
+/*! Adaptive Radix Tree destroy
+ *
+ * @brief Dealloc an adaptive radix tree
+ *
+ * @param tree
+ *     (input) tree to free
+ * @param f_free
+ *     (input) function to free the data
+ *             @param data
+ *                 (input) data to free
+ *             @result NaN
+ *
+ * @result NaN.
+*/
+void tree_art_destroy(
+	  t_tree_art * tree
+	, void (*f_free)(void * data)
+);
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+/*! Adaptive Radix Tree is empty
+ *
+ * @brief Check if the tree is empty
+ *
+ * @param tree
+ *     (input) tree
+ *
+ * @result If successful, 1 is returned.
+ *         Otherwise, a 0 is returned.
+*/
+int tree_art_is_empty(const t_tree_art * tree);
+
+/*! Adaptive Radix Tree size
+ *
+ * @brief Return the number of keys stored in the tree
+ *
+ * @param tree
+ *     (input) tree
+ *
+ * @result If successful, size is returned.
+ *         Otherwise, a 0 is returned.
+*/
+size_t tree_art_size(const t_tree_art * tree);
+
+/*! Adaptive Radix Tree insert
+ *
+ * @brief Insert an element into the tree
+ *
+ * @note The key is copied into the tree, keys may be prefixes of each other
+ *
+ * @param tree
+ *     (input) tree
+ * @param data
+ *     (input) data to add to the tree
+ * @param size
+ *     (input) size of the content to allocate.
+ *             If the size is 0, no copy occurs
+ * @param key
+ *     (input) key to use
+ * @param key_len
+ *     (input) length of the key
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise (or if the key already exists), a 1 is returned.
+*/
+int tree_art_insert(
+	  t_tree_art * tree
+	, void * data
+	, size_t size
+	, unsigned char * key
+	, size_t key_len
+);
+
+/*! Adaptive Radix Tree search
+ *
+ * @brief Search an element into the tree
+ *
+ * @param tree
+ *     (input) tree
+ * @param key
+ *     (input) key to use
+ * @param key_len
+ *     (input) length of the key
+ * @param flag
+ *     (input) if bit set to MS_ELEMENT_REMOVE remove it while returned
+ *
+ * @result If successful, the data is returned.
+ *         Otherwise, NULL is returned.
+*/
+void * tree_art_search(
+	  t_tree_art * tree
+	, unsigned char * key
+	, size_t key_len
+	, int flag
+);
+
+/*! Adaptive Radix Tree function (in-order)
+ *
+ * @brief Apply a function to each element of the tree
+ *        following the lexicographic order of the keys
+ *
+ * @param tree
+ *     (input) tree
+ * @param content
+ *     (output) data to retrieve
+ * @param f_fct
+ *     (input) function to apply on the data
+ *             @param data
+ *                 (input) data
+ *             @param content
+ *                 (output) data to retrieve
+ *             @result If successful, 0 is returned.
+ *                     Otherwise, a number is returned.
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a number is returned.
+*/
+int tree_art_in_order(
+	  t_tree_art * tree
+	, void ** content
+	, int (*f_fct)(void * data, void ** content)
+);
+
+/*! Adaptive Radix Tree function (prefix)
+ *
+ * @brief Apply a function, in lexicographic order, to each element
+ *        whose key starts with the given prefix
+ *
+ * @param tree
+ *     (input) tree
+ * @param prefix
+ *     (input) prefix of the keys to visit
+ * @param prefix_len
+ *     (input) length of the prefix
+ * @param content
+ *     (output) data to retrieve
+ * @param f_fct
+ *     (input) function to apply on the data
+ *             @param data
+ *                 (input) data
+ *             @param content
+ *                 (output) data to retrieve
+ *             @result If successful, 0 is returned.
+ *                     Otherwise, a number is returned.
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a number is returned.
+*/
+int tree_art_prefix(
+	  t_tree_art * tree
+	, unsigned char * prefix
+	, size_t prefix_len
+	, void ** content
+	, int (*f_fct)(void * data, void ** content)
+);
+
+#endif /* !MS_RADIX_H */
+
+/* EOF */
\ No newline at end of file
@@ -2,6 +2,8 @@
 # define MS_RED_BLACK_H
 
 # include <ms_struct.h>
+# include <ms_pool.h>
+# include <ms_tree/ms_frozen.h>
 
 /*----------------------------------- STRUCTURES ------------------------------------*/
 
@@ -49,6 +51,32 @@ void tree_rb_destroy(
 	, void (*f_free)(void * data)
 );
 
+/*! Red Black Tree destroy parallel
+ *
+ * @brief Dealloc a tree, its subtrees freed by the threads of a pool
+ *
+ * @param tree
+ *     (input) tree to free
+ * @param f_free
+ *     (input) function to free the data, called concurrently
+ *             @param data
+ *                 (input) data to free
+ *             @result NaN
+ * @param pool
+ *     (input) pool, or NULL to free on the calling thread only
+ * @param grain
+ *     (input) approximate number of nodes of a task,
+ *             0 for MS_POOL_GRAIN
+ *
+ * @result NaN.
+*/
+void tree_rb_destroy_parallel(
+	  t_tree_rb ** tree
+	, void (*f_free)(void * data)
+	, t_pool * pool
+	, size_t grain
+);
+
 /*------------------------------------- METHODS -------------------------------------*/
 
 /*! Red Black Tree is empty
@@ -147,6 +175,42 @@ void * tree_rb_search(
 	, int (*f_compare)(void * elem, void * data)
 );
 
+/*! Red Black Tree search batch
+ *
+ * @brief Find several elements on the tree at once.
+ *        The descents advance in lockstep, one level per round,
+ *        and the next node of each descent is prefetched so that
+ *        the cache misses of the different keys overlap
+ *
+ * @param tree
+ *     (input) tree
+ * @param datas
+ *     (input) data to find on the tree
+ * @param count
+ *     (input) number of data
+ * @param elems
+ *     (output) element found for each data, or NULL
+ * @param f_compare
+ *     (input) function use to compare two data
+ *             @param elem
+ *                 (input) elem to compare
+ *             @param data
+ *                 (input) data to compare
+ *
+ *             @result If equals, 0 is returned.
+ *                     If greater, 1 is returned.
+ *                     If smaller, -1 is returned.
+ *
+ * @result Return the number of elements found.
+*/
+size_t tree_rb_search_batch(
+	  t_tree_rb ** tree
+	, void ** datas
+	, size_t count
+	, void ** elems
+	, int (*f_compare)(void * elem, void * data)
+);
+
 /*! Red Black Tree function (pre-order)
  *
  * @brief Apply a function to each leef of tree
@@ -199,6 +263,91 @@ int tree_rb_in_order(
 	, int (*f_fct)(void * data, void ** content)
 );
 
+/*! Red Black Tree function parallel (in-order)
+ *
+ * @brief Apply a function to each leef of tree, its subtrees shared by the
+ *        threads of a pool. Each task visits its subtree in order, the
+ *        tasks run concurrently. Once f_fct fails, the subtrees not started
+ *        yet are skipped
+ *
+ * @note The tree may not be modified meanwhile
+ *
+ * @param tree
+ *     (input) tree
+ * @param content
+ *     (output) data to retrieve, shared by every call
+ * @param f_fct
+ *     (input) function to apply on the data, called concurrently
+ *             @param data
+ *                 (input) data
+ *             @param content
+ *                 (output) data to retrieve
+ *             @result If successful, 0 is returned.
+ *                     Otherwise, a number is returned.
+ * @param pool
+ *     (input) pool, or NULL to run on the calling thread only
+ * @param grain
+ *     (input) approximate number of nodes of a task,
+ *             0 for MS_POOL_GRAIN
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, the first number returned by f_fct is returned.
+*/
+int tree_rb_in_order_parallel(
+	  t_tree_rb ** tree
+	, void ** content
+	, int (*f_fct)(void * data, void ** content)
+	, t_pool * pool
+	, size_t grain
+);
+
+/*! Red Black Tree reduce parallel
+ *
+ * @brief Fold the data of the tree, in order, into a single result. Each
+ *        task folds its subtree into a partial result of its own, then the
+ *        partial results are combined in the order of their subtrees, so
+ *        that f_combine only has to be associative
+ *
+ * @param tree
+ *     (input) tree
+ * @param result
+ *     (input/output) identity of the reduction, then its result
+ * @param size
+ *     (input) size of a result
+ * @param f_map
+ *     (input) function folding a data into a result, called concurrently
+ *             on distinct results
+ *             @param partial
+ *                 (input/output) result
+ *             @param data
+ *                 (input) data
+ *             @result NaN
+ * @param f_combine
+ *     (input) function folding a result into the one before it
+ *             @param partial
+ *                 (input/output) result of the data before
+ *             @param other
+ *                 (input) result of the data after
+ *             @result NaN
+ * @param pool
+ *     (input) pool, or NULL to run on the calling thread only
+ * @param grain
+ *     (input) approximate number of nodes of a task,
+ *             0 for MS_POOL_GRAIN
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int tree_rb_reduce_parallel(
+	  t_tree_rb ** tree
+	, void * result
+	, size_t size
+	, void (*f_map)(void * partial, void * data)
+	, void (*f_combine)(void * partial, const void * other)
+	, t_pool * pool
+	, size_t grain
+);
+
 /*! Red Black Tree function (out-order)
  *
  * @brief Apply a function to each leef of tree
@@ -251,6 +400,31 @@ int tree_rb_post_order(
 	, int (*f_fct)(void * data, void ** content)
 );
 
+/*! Red Black Tree freeze
+ *
+ * @brief Build an immutable, search-optimized copy of the tree
+ *        (see ms_frozen.h). The tree itself is left untouched
+ *        and shares its data with the frozen tree
+ *
+ * @param tree
+ *     (input) tree
+ * @param frozen
+ *     (output) frozen tree to initialize
+ * @param f_key
+ *     (input) optional function extracting an integer key from the data
+ *             @param data
+ *                 (input) data
+ *             @result Return the key of the data
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int tree_rb_freeze(
+	  t_tree_rb ** tree
+	, t_tree_fz ** frozen
+	, long (*f_key)(void * data)
+);
+
 #endif /* !MS_RED_BLACK_H */
 
 /* EOF */
\ No newline at end of file
@@ -0,0 +1,332 @@
+#ifndef MS_RED_BLACK_TYPED_H
+# define MS_RED_BLACK_TYPED_H
+
+# include <ms_struct.h>
+
+/*
+ * Three-way comparison of keys ordered by < and >
+*/
+# define MS_TREE_CMP(a, b)            (((a) > (b)) - ((a) < (b)))
+
+/*! Typed Red Black Tree declare
+ *
+ * @brief Generate a red black tree specialized for a key and a value type.
+ *        The key and the value are stored inside the node and cmp is
+ *        expanded in place, so that each level of a descent is a single
+ *        inlined comparison. Insertion and traversal are iterative.
+ *
+ *        The generated API is:
+ *            t_tree_rb_<name>
+ *            int     tree_rb_<name>_init(t_tree_rb_<name> ** tree)
+ *            void    tree_rb_<name>_destroy(t_tree_rb_<name> * tree)
+ *            int     tree_rb_<name>_is_empty(const t_tree_rb_<name> * tree)
+ *            size_t  tree_rb_<name>_size(const t_tree_rb_<name> * tree)
+ *            int     tree_rb_<name>_insert(t_tree_rb_<name> * tree, key_t key, val_t val)
+ *            val_t * tree_rb_<name>_search(t_tree_rb_<name> * tree, key_t key)
+ *            int     tree_rb_<name>_in_order(t_tree_rb_<name> * tree, void ** content,
+ *                        int (*f_fct)(key_t key, val_t * val, void ** content))
+ *
+ *        insert replaces the value of an existing key, search returns the
+ *        slot of the value (valid until the tree is destroyed)
+ *
+ * @param name
+ *     (input) suffix of the generated type and functions
+ * @param key_t
+ *     (input) type of the keys
+ * @param val_t
+ *     (input) type of the values
+ * @param cmp
+ *     (input) function or macro comparing two keys, e.g. MS_TREE_CMP
+ *             @param a
+ *                 (input) key to compare
+ *             @param b
+ *                 (input) key to compare
+ *             @result If equals, 0 is returned.
+ *                     If a is greater, a positive number is returned.
+ *                     If a is smaller, a negative number is returned.
+ *
+ * @result Functions return 0 if successful, 1 otherwise.
+*/
+# define MS_TREE_RB_DECLARE(name, key_t, val_t, cmp)                            \
+                                                                              \
+typedef struct s_tree_rb_##name##_node                                        \
+{                                                                             \
+	key_t                           key;                                      \
+	val_t                           val;                                      \
+	struct s_tree_rb_##name##_node * left;                                    \
+	struct s_tree_rb_##name##_node * right;                                   \
+	struct s_tree_rb_##name##_node * parent;                                  \
+	int                             red;                                      \
+} t_tree_rb_##name##_node;                                                    \
+                                                                              \
+struct s_tree_rb_##name                                                       \
+{                                                                             \
+	size_t                    size;                                           \
+	t_tree_rb_##name##_node * root;                                           \
+};                                                                            \
+                                                                              \
+typedef struct s_tree_rb_##name t_tree_rb_##name;                             \
+                                                                              \
+/* Rotate node down to the left (dir 0) or to the right (dir 1) */           \
+static inline                                                                 \
+void __tree_rb_##name##_rotate(                                               \
+	  t_tree_rb_##name * tree                                                 \
+	, t_tree_rb_##name##_node * node                                          \
+	, int dir                                                                 \
+) {                                                                           \
+	t_tree_rb_##name##_node * child;                                          \
+                                                                              \
+	if (0 == dir) {                                                           \
+		child = node->right;                                                  \
+		node->right = child->left;                                            \
+		if (MS_ADDRCK(child->left)) {                                         \
+			child->left->parent = node;                                       \
+		}                                                                     \
+		child->left = node;                                                   \
+	} else {                                                                  \
+		child = node->left;                                                   \
+		node->left = child->right;                                            \
+		if (MS_ADDRCK(child->right)) {                                        \
+			child->right->parent = node;                                      \
+		}                                                                     \
+		child->right = node;                                                  \
+	}                                                                         \
+	child->parent = node->parent;                                             \
+	if (MS_ADDRNULL(node->parent)) {                                          \
+		tree->root = child;                                                   \
+	} else if (node == node->parent->left) {                                  \
+		node->parent->left = child;                                           \
+	} else {                                                                  \
+		node->parent->right = child;                                          \
+	}                                                                         \
+	node->parent = child;                                                     \
+}                                                                             \
+                                                                              \
+/* Once rotated, grand hangs under a black node and the loop ends */         \
+static inline                                                                 \
+void __tree_rb_##name##_fixup(                                                \
+	  t_tree_rb_##name * tree                                                 \
+	, t_tree_rb_##name##_node * node                                          \
+) {                                                                           \
+	t_tree_rb_##name##_node * parent;                                         \
+	t_tree_rb_##name##_node * grand;                                          \
+	t_tree_rb_##name##_node * uncle;                                          \
+                                                                              \
+	while (                                                                   \
+		   MS_ADDRCK(node->parent)                                            \
+		&& node->parent->red                                                  \
+	) {                                                                       \
+		parent = node->parent;                                                \
+		grand = parent->parent;                                               \
+		uncle = (parent == grand->left) ? grand->right : grand->left;         \
+		if (MS_ADDRCK(uncle) && uncle->red) {                                 \
+			parent->red = 0;                                                  \
+			uncle->red = 0;                                                   \
+			grand->red = 1;                                                   \
+			node = grand;                                                     \
+		} else if (parent == grand->left) {                                   \
+			if (node == parent->right) {                                      \
+				__tree_rb_##name##_rotate(tree, parent, 0);                   \
+				parent = node;                                                \
+			}                                                                 \
+			parent->red = 0;                                                  \
+			grand->red = 1;                                                   \
+			__tree_rb_##name##_rotate(tree, grand, 1);                        \
+			node = grand;                                                     \
+		} else {                                                              \
+			if (node == parent->left) {                                       \
+				__tree_rb_##name##_rotate(tree, parent, 1);                   \
+				parent = node;                                                \
+			}                                                                 \
+			parent->red = 0;                                                  \
+			grand->red = 1;                                                   \
+			__tree_rb_##name##_rotate(tree, grand, 0);                        \
+			node = grand;                                                     \
+		}                                                                     \
+	}                                                                         \
+	tree->root->red = 0;                                                      \
+}                                                                             \
+                                                                              \
+static inline                                                                 \
+int tree_rb_##name##_init(t_tree_rb_##name ** tree)                           \
+{                                                                             \
+	if (MS_ADDRCK(tree)) {                                                    \
+		*tree = MS_CAST(t_tree_rb_##name *, MS_ALLOC(sizeof(t_tree_rb_##name))); \
+		if (MS_ADDRCK(*tree)) {                                               \
+			MS_MEMSET(*tree, 0, sizeof(t_tree_rb_##name));                    \
+			return (0);                                                       \
+		}                                                                     \
+	}                                                                         \
+	return (1);                                                               \
+}                                                                             \
+                                                                              \
+/* Post-order walk through the parent links, without a stack */              \
+static inline                                                                 \
+void tree_rb_##name##_destroy(t_tree_rb_##name * tree)                        \
+{                                                                             \
+	t_tree_rb_##name##_node * node;                                           \
+	t_tree_rb_##name##_node * parent;                                         \
+                                                                              \
+	if (MS_ADDRCK(tree)) {                                                    \
+		node = tree->root;                                                    \
+		while (MS_ADDRCK(node)) {                                             \
+			if (MS_ADDRCK(node->left)) {                                      \
+				node = node->left;                                            \
+			} else if (MS_ADDRCK(node->right)) {                              \
+				node = node->right;                                           \
+			} else {                                                          \
+				parent = node->parent;                                        \
+				if (MS_ADDRCK(parent)) {                                      \
+					if (node == parent->left) {                               \
+						parent->left = NULL;                                  \
+					} else {                                                  \
+						parent->right = NULL;                                 \
+					}                                                         \
+				}                                                             \
+				MS_DEALLOC(node);                                             \
+				node = parent;                                                \
+			}                                                                 \
+		}                                                                     \
+		MS_DEALLOC(tree);                                                     \
+	}                                                                         \
+}                                                                             \
+                                                                              \
+static inline                                                                 \
+int tree_rb_##name##_is_empty(const t_tree_rb_##name * tree)                  \
+{                                                                             \
+	if (                                                                      \
+		   MS_ADDRCK(tree)                                                    \
+		&& 0 != tree->size                                                    \
+	) {                                                                       \
+		return (0);                                                           \
+	}                                                                         \
+	return (1);                                                               \
+}                                                                             \
+                                                                              \
+static inline                                                                 \
+size_t tree_rb_##name##_size(const t_tree_rb_##name * tree)                   \
+{                                                                             \
+	if (MS_ADDRCK(tree)) {                                                    \
+		return (tree->size);                                                  \
+	}                                                                         \
+	return (0);                                                               \
+}                                                                             \
+                                                                              \
+static inline                                                                 \
+int tree_rb_##name##_insert(                                                  \
+	  t_tree_rb_##name * tree                                                 \
+	, key_t key                                                               \
+	, val_t val                                                               \
+) {                                                                           \
+	int                        ret;                                           \
+	t_tree_rb_##name##_node  * node;                                          \
+	t_tree_rb_##name##_node  * parent;                                        \
+	t_tree_rb_##name##_node ** link;                                          \
+                                                                              \
+	if (MS_ADDRNULL(tree)) {                                                  \
+		return (1);                                                           \
+	}                                                                         \
+	parent = NULL;                                                            \
+	link = &tree->root;                                                       \
+	while (MS_ADDRCK(*link)) {                                                \
+		parent = *link;                                                       \
+		ret = cmp(key, parent->key);                                          \
+		if (ret < 0) {                                                        \
+			link = &parent->left;                                             \
+		} else if (ret > 0) {                                                 \
+			link = &parent->right;                                            \
+		} else {                                                              \
+			parent->val = val;                                                \
+			return (0);                                                       \
+		}                                                                     \
+	}                                                                         \
+	node = MS_CAST(t_tree_rb_##name##_node *,                                 \
+		MS_ALLOC(sizeof(t_tree_rb_##name##_node)));                           \
+	if (MS_ADDRNULL(node)) {                                                  \
+		return (1);                                                           \
+	}                                                                         \
+	node->key    = key;                                                       \
+	node->val    = val;                                                       \
+	node->left   = NULL;                                                      \
+	node->right  = NULL;                                                      \
+	node->parent = parent;                                                    \
+	node->red    = 1;                                                         \
+	*link = node;                                                             \
+	++tree->size;                                                             \
+	__tree_rb_##name##_fixup(tree, node);                                     \
+	return (0);                                                               \
+}                                                                             \
+                                                                              \
+static inline                                                                 \
+val_t * tree_rb_##name##_search(                                              \
+	  t_tree_rb_##name * tree                                                 \
+	, key_t key                                                               \
+) {                                                                           \
+	int                       ret;                                            \
+	t_tree_rb_##name##_node * node;                                           \
+                                                                              \
+	if (MS_ADDRCK(tree)) {                                                    \
+		node = tree->root;                                                    \
+		while (MS_ADDRCK(node)) {                                             \
+			ret = cmp(key, node->key);                                        \
+			if (ret < 0) {                                                    \
+				node = node->left;                                            \
+			} else if (ret > 0) {                                             \
+				node = node->right;                                           \
+			} else {                                                          \
+				return (&node->val);                                          \
+			}                                                                 \
+		}                                                                     \
+	}                                                                         \
+	return (NULL);                                                            \
+}                                                                             \
+                                                                              \
+static inline                                                                 \
+int tree_rb_##name##_in_order(                                                \
+	  t_tree_rb_##name * tree                                                 \
+	, void ** content                                                         \
+	, int (*f_fct)(key_t key, val_t * val, void ** content)                   \
+) {                                                                           \
+	int                       ret;                                            \
+	t_tree_rb_##name##_node * node;                                           \
+	t_tree_rb_##name##_node * prev;                                           \
+                                                                              \
+	ret = 0;                                                                  \
+	if (                                                                      \
+		   MS_ADDRCK(tree)                                                    \
+		&& MS_ADDRCK(f_fct)                                                   \
+		&& MS_ADDRCK(tree->root)                                              \
+	) {                                                                       \
+		node = tree->root;                                                    \
+		while (MS_ADDRCK(node->left)) {                                       \
+			node = node->left;                                                \
+		}                                                                     \
+		while (                                                               \
+			   0 == ret                                                       \
+			&& MS_ADDRCK(node)                                                \
+		) {                                                                   \
+			ret = f_fct(node->key, &node->val, content);                      \
+			if (MS_ADDRCK(node->right)) {                                     \
+				node = node->right;                                           \
+				while (MS_ADDRCK(node->left)) {                               \
+					node = node->left;                                        \
+				}                                                             \
+			} else {                                                          \
+				prev = node;                                                  \
+				node = node->parent;                                          \
+				while (                                                       \
+					   MS_ADDRCK(node)                                        \
+					&& prev == node->right                                    \
+				) {                                                           \
+					prev = node;                                              \
+					node = node->parent;                                      \
+				}                                                             \
+			}                                                                 \
+		}                                                                     \
+	}                                                                         \
+	return (ret);                                                             \
+}
+
+#endif /* !MS_RED_BLACK_TYPED_H */
+
+/* EOF */
\ No newline at end of file
@@ -0,0 +1,216 @@
+#ifndef MS_SKIP_LIST_H
+# define MS_SKIP_LIST_H
+
+# include <ms_struct.h>
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+struct s_tree_sl;
+
+/* Type opaque */
+typedef struct s_tree_sl t_tree_sl;
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+/*! Skip List init
+ *
+ * @brief Initialize an ordered map safe to use from several threads
+ *        without any lock. Every element is chained on the bottom level,
+ *        sorted, and on a random number of levels above it, each one
+ *        skipping about three elements out of four of the level below.
+ *        A node is linked or removed level by level with a single CAS
+ *
+ * @param tree
+ *     (input) skip list to initialize
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int tree_sl_init(t_tree_sl ** tree);
+
+/*! Skip List destroy
+ *
+ * @brief Dealloc a skip list
+ *
+ * @note No other thread may use the skip list anymore
+ *
+ * @param tree
+ *     (input) skip list to free
+ * @param f_free
+ *     (input) function to free the data
+ *             @param data
+ *                 (input) data to free
+ *             @result NaN
+ *
+ * @result NaN
+*/
+void tree_sl_destroy(
+	  t_tree_sl * tree
+	, void (*f_free)(void * data)
+);
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+/*! Skip List size
+ *
+ * @brief Return the number of elements of the skip list
+ *
+ * @param tree
+ *     (input) skip list
+ *
+ * @result If successful, size is returned.
+ *         Otherwise, a 0 is returned.
+*/
+size_t tree_sl_size(const t_tree_sl * tree);
+
+/*! Skip List insert
+ *
+ * @brief Insert an element into the skip list, unless an equal element
+ *        is already there
+ *
+ * @param tree
+ *     (input) skip list
+ * @param data
+ *     (input) data to insert on the skip list
+ * @param size
+ *     (input) size of the content to allocate.
+ *             If the size is 0, no copy occurs
+ * @param f_compare
+ *     (input) function use to compare two data
+ *             @param elem
+ *                 (input) elem to compare
+ *             @param data
+ *                 (input) data to compare
+ *
+ *             @result If equals, 0 is returned.
+ *                     If greater, 1 is returned.
+ *                     If smaller, -1 is returned.
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int tree_sl_insert(
+	  t_tree_sl * tree
+	, void * data
+	, size_t size
+	, int (*f_compare)(void * elem, void * data)
+);
+
+/*! Skip List search
+ *
+ * @brief Find an element on the skip list. A search never writes to
+ *        the skip list
+ *
+ * @note The data returned stays valid until the epoch_exit of a critical
+ *       section entered by the caller around the search (ms_epoch.h),
+ *       otherwise only as long as no other thread removes it
+ *
+ * @param tree
+ *     (input) skip list
+ * @param data
+ *     (input) data to find on the skip list
+ * @param f_compare
+ *     (input) function use to compare two data
+ *             @param elem
+ *                 (input) elem to compare
+ *             @param data
+ *                 (input) data to compare
+ *
+ *             @result If equals, 0 is returned.
+ *                     If greater, 1 is returned.
+ *                     If smaller, -1 is returned.
+ *
+ * @result If successful, the element is returned.
+ *         Otherwise, NULL is returned.
+*/
+void * tree_sl_search(
+	  t_tree_sl * tree
+	, void * data
+	, int (*f_compare)(void * elem, void * data)
+);
+
+/*! Skip List remove
+ *
+ * @brief Remove an element from the skip list. The element is marked
+ *        from its top level down, then unlinked, its memory and data are
+ *        retired to ms_epoch.h and only freed once no thread can still
+ *        read them
+ *
+ * @param tree
+ *     (input) skip list
+ * @param data
+ *     (input) data to remove from the skip list
+ * @param f_compare
+ *     (input) function use to compare two data
+ *             @param elem
+ *                 (input) elem to compare
+ *             @param data
+ *                 (input) data to compare
+ *
+ *             @result If equals, 0 is returned.
+ *                     If greater, 1 is returned.
+ *                     If smaller, -1 is returned.
+ * @param f_free
+ *     (input) function to free the data, once no thread can read it
+ *             @param data
+ *                 (input) data to free
+ *             @result NaN
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a 1 is returned.
+*/
+int tree_sl_remove(
+	  t_tree_sl * tree
+	, void * data
+	, int (*f_compare)(void * elem, void * data)
+	, void (*f_free)(void * data)
+);
+
+/*! Skip List range
+ *
+ * @brief Apply a function, in order, to each element between min and max
+ *        included, concurrently with the other threads. An element
+ *        inserted or removed meanwhile may or may not be seen
+ *
+ * @param tree
+ *     (input) skip list
+ * @param min
+ *     (input) lower bound, or NULL from the first element
+ * @param max
+ *     (input) upper bound, or NULL up to the last element
+ * @param content
+ *     (output) data to retrieve
+ * @param f_fct
+ *     (input) function to apply on the data
+ *             @param data
+ *                 (input) data
+ *             @param content
+ *                 (output) data to retrieve
+ *             @result If successful, 0 is returned.
+ *                     Otherwise, a number is returned.
+ * @param f_compare
+ *     (input) function use to compare two data, only used with a bound
+ *             @param elem
+ *                 (input) elem to compare
+ *             @param data
+ *                 (input) data to compare
+ *
+ *             @result If equals, 0 is returned.
+ *                     If greater, 1 is returned.
+ *                     If smaller, -1 is returned.
+ *
+ * @result If successful, 0 is returned.
+ *         Otherwise, a number is returned.
+*/
+int tree_sl_range(
+	  t_tree_sl * tree
+	, void * min
+	, void * max
+	, void ** content
+	, int (*f_fct)(void * data, void ** content)
+	, int (*f_compare)(void * elem, void * data)
+);
+
+#endif /* !MS_SKIP_LIST_H */
+
+/* EOF */
\ No newline at end of file
@@ -0,0 +1,302 @@
+#include <stdio.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <ms_dict.h>
+#include <ms_dict_sharded.h>
+#include <ms_dict_lockfree.h>
+#include <ms_hash.h>
+#include <ms_combining.h>
+#include <ms_tree/ms_red_black.h>
+#include <ms_tree/ms_skip_list.h>
+
+# define BENCH_KEYS    (1 << 16)
+# define BENCH_OPS     (1 << 20)
+# define BENCH_SHARDS  64
+# define BENCH_THREADS 64
+# define BENCH_WRITES  10
+
+/*
+ * Scalability of concurrent lookups: a t_dict behind one global mutex
+ * against a sharded and a lock-free dictionary, from 1 thread to twice
+ * the cores. Then of an ordered map taking BENCH_WRITES % of inserts:
+ * a t_tree_rb behind one global mutex or flat combining against the
+ * lock-free skip list
+*/
+
+typedef struct s_bench
+{
+	size_t            seed;
+	t_dict          * dict;
+	t_dict_sh       * dict_sh;
+	t_dict_lf       * dict_lf;
+	t_tree_rb      ** tree;
+	t_tree_sl       * tree_sl;
+	t_combining     * comb;
+	pthread_mutex_t * lock;
+	size_t            found;
+} t_bench;
+
+static char keys[BENCH_KEYS][16];
+
+static int f_compare(
+	  void * data
+	, unsigned char * key
+	, size_t key_len
+) {
+	MS_UNUSED(key_len);
+	return (strcmp(MS_CAST(char *, data), MS_CAST(char *, key)));
+}
+
+static int f_compare_tree(
+	  void * elem
+	, void * data
+) {
+	return (strcmp(MS_CAST(char *, data), MS_CAST(char *, elem)));
+}
+
+static int f_tree_search(
+	  void * container
+	, void * arg
+) {
+	return (MS_ADDRCK(tree_rb_search(MS_CAST(t_tree_rb **, container), arg, &f_compare_tree)));
+}
+
+static int f_tree_insert(
+	  void * container
+	, void * arg
+) {
+	if (MS_ADDRCK(tree_rb_search(MS_CAST(t_tree_rb **, container), arg, &f_compare_tree))) {
+		return (1);
+	}
+	tree_rb_insert(MS_CAST(t_tree_rb **, container), arg, 0, &f_compare_tree);
+	return (0);
+}
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec + ts.tv_nsec * 1e-9);
+}
+
+static size_t next(size_t * seed)
+{
+	*seed = *seed * 6364136223846793005ULL + 1442695040888963407ULL;
+	return ((*seed >> 33) % BENCH_KEYS);
+}
+
+static void * run(void * arg)
+{
+	size_t    i;
+	size_t    k;
+	t_bench * bench;
+
+	bench = MS_CAST(t_bench *, arg);
+	i = 0;
+	while (i < BENCH_OPS) {
+		k = next(&bench->seed);
+		if (MS_ADDRCK(bench->dict_lf)) {
+			bench->found += MS_ADDRCK(dict_lf_search(
+				  bench->dict_lf
+				, MS_CAST(unsigned char *, keys[k])
+				, strlen(keys[k])
+				, &f_compare
+			));
+		} else if (MS_ADDRCK(bench->dict_sh)) {
+			bench->found += MS_ADDRCK(dict_sh_search(
+				  bench->dict_sh
+				, MS_CAST(unsigned char *, keys[k])
+				, strlen(keys[k])
+				, 0
+				, &f_compare
+			));
+		} else {
+			pthread_mutex_lock(bench->lock);
+			bench->found += MS_ADDRCK(dict_search(
+				  bench->dict
+				, MS_CAST(unsigned char *, keys[k])
+				, strlen(keys[k])
+				, 0
+				, &f_compare
+			));
+			pthread_mutex_unlock(bench->lock);
+		}
+		++i;
+	}
+	return (NULL);
+}
+
+/*
+ * The three trees get the same operations: one in 100 / BENCH_WRITES
+ * inserts its key when missing, the others search it
+*/
+static void * run_tree(void * arg)
+{
+	size_t    i;
+	size_t    k;
+	int       ret;
+	t_bench * bench;
+
+	bench = MS_CAST(t_bench *, arg);
+	i = 0;
+	while (i < BENCH_OPS) {
+		k = next(&bench->seed);
+		if (MS_ADDRCK(bench->comb)) {
+			ret = 0;
+			if (0 == i % (100 / BENCH_WRITES)) {
+				combining_apply(bench->comb, &f_tree_insert, keys[k], &ret);
+			} else {
+				combining_apply(bench->comb, &f_tree_search, keys[k], &ret);
+			}
+			bench->found += ret;
+		} else if (MS_ADDRCK(bench->tree_sl)) {
+			if (0 == i % (100 / BENCH_WRITES)) {
+				bench->found += (0 != tree_sl_insert(bench->tree_sl, keys[k], 0, &f_compare_tree));
+			} else {
+				bench->found += MS_ADDRCK(tree_sl_search(bench->tree_sl, keys[k], &f_compare_tree));
+			}
+		} else {
+			pthread_mutex_lock(bench->lock);
+			if (0 == i % (100 / BENCH_WRITES)) {
+				bench->found += f_tree_insert(bench->tree, keys[k]);
+			} else {
+				bench->found += f_tree_search(bench->tree, keys[k]);
+			}
+			pthread_mutex_unlock(bench->lock);
+		}
+		++i;
+	}
+	return (NULL);
+}
+
+static double measure(
+	  size_t threads
+	, t_dict * dict
+	, t_dict_sh * dict_sh
+	, t_dict_lf * dict_lf
+	, pthread_mutex_t * lock
+) {
+	size_t    i;
+	double    start;
+	pthread_t tids[BENCH_THREADS];
+	t_bench   benchs[BENCH_THREADS];
+
+	start = now();
+	i = 0;
+	while (i < threads) {
+		benchs[i].seed    = i + 1;
+		benchs[i].dict    = dict;
+		benchs[i].dict_sh = dict_sh;
+		benchs[i].dict_lf = dict_lf;
+		benchs[i].tree    = NULL;
+		benchs[i].tree_sl = NULL;
+		benchs[i].comb    = NULL;
+		benchs[i].lock    = lock;
+		benchs[i].found   = 0;
+		pthread_create(&tids[i], NULL, &run, &benchs[i]);
+		++i;
+	}
+	i = 0;
+	while (i < threads) {
+		pthread_join(tids[i], NULL);
+		++i;
+	}
+	return (threads * BENCH_OPS / (now() - start) / 1e6);
+}
+
+static double measure_tree(
+	  size_t threads
+	, t_tree_rb ** tree
+	, t_tree_sl * tree_sl
+	, t_combining * comb
+	, pthread_mutex_t * lock
+) {
+	size_t    i;
+	double    start;
+	pthread_t tids[BENCH_THREADS];
+	t_bench   benchs[BENCH_THREADS];
+
+	start = now();
+	i = 0;
+	while (i < threads) {
+		benchs[i].seed    = i + 1;
+		benchs[i].tree    = tree;
+		benchs[i].tree_sl = tree_sl;
+		benchs[i].comb    = comb;
+		benchs[i].lock    = lock;
+		benchs[i].found   = 0;
+		pthread_create(&tids[i], NULL, &run_tree, &benchs[i]);
+		++i;
+	}
+	i = 0;
+	while (i < threads) {
+		pthread_join(tids[i], NULL);
+		++i;
+	}
+	return (threads * BENCH_OPS / (now() - start) / 1e6);
+}
+
+int main(void)
+{
+	size_t          i;
+	size_t          cores;
+	t_dict        * dict;
+	t_dict_sh     * dict_sh;
+	t_dict_lf     * dict_lf;
+	t_tree_rb     * tree;
+	t_tree_sl     * tree_sl;
+	t_combining   * comb;
+	pthread_mutex_t lock;
+
+	if (
+		   0 != dict_init(&dict, BENCH_KEYS, &hash_fnv_onea)
+		|| 0 != dict_sh_init(&dict_sh, BENCH_SHARDS, BENCH_KEYS, &hash_fnv_onea)
+		|| 0 != dict_lf_init(&dict_lf, BENCH_KEYS, &hash_fnv_onea)
+		|| 0 != tree_sl_init(&tree_sl)
+		|| 0 != combining_init(&comb, &tree)
+	) {
+		return (1);
+	}
+	tree = NULL;
+	pthread_mutex_init(&lock, NULL);
+	i = 0;
+	while (i < BENCH_KEYS) {
+		snprintf(keys[i], sizeof(keys[i]), "key-%zu", i);
+		dict_insert(dict, keys[i], 0, MS_CAST(unsigned char *, keys[i]), strlen(keys[i]));
+		dict_sh_insert(dict_sh, keys[i], 0, MS_CAST(unsigned char *, keys[i]), strlen(keys[i]));
+		dict_lf_insert(dict_lf, keys[i], 0, MS_CAST(unsigned char *, keys[i]), strlen(keys[i]));
+		if (0 == (i & 1)) {
+			tree_rb_insert(&tree, keys[i], 0, &f_compare_tree);
+			tree_sl_insert(tree_sl, keys[i], 0, &f_compare_tree);
+		}
+		++i;
+	}
+	cores = MS_CAST(size_t, sysconf(_SC_NPROCESSORS_ONLN));
+	printf("%8s %16s %16s %16s\n", "threads", "mutex Mops/s", "sharded Mops/s", "lock-free Mops/s");
+	i = 1;
+	while (i <= 2 * cores && i <= BENCH_THREADS) {
+		printf("%8zu %16.2f", i, measure(i, dict, NULL, NULL, &lock));
+		printf(" %16.2f", measure(i, NULL, dict_sh, NULL, NULL));
+		printf(" %16.2f\n", measure(i, NULL, NULL, dict_lf, NULL));
+		i <<= 1;
+	}
+	printf("%8s %16s %16s %16s\n", "threads", "rb-mutex Mops/s", "rb-fc Mops/s", "skip list Mops/s");
+	i = 1;
+	while (i <= 2 * cores && i <= BENCH_THREADS) {
+		printf("%8zu %16.2f", i, measure_tree(i, &tree, NULL, NULL, &lock));
+		printf(" %16.2f", measure_tree(i, NULL, NULL, comb, NULL));
+		printf(" %16.2f\n", measure_tree(i, NULL, tree_sl, NULL, NULL));
+		i <<= 1;
+	}
+	pthread_mutex_destroy(&lock);
+	dict_destroy(dict, NULL);
+	dict_sh_destroy(dict_sh, NULL);
+	dict_lf_destroy(dict_lf, NULL);
+	combining_destroy(comb);
+	tree_rb_destroy(&tree, NULL);
+	tree_sl_destroy(tree_sl, NULL);
+	return (0);
+}
\ No newline at end of file
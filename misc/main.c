@@ -1,15 +1,39 @@
 #include <stdio.h>
+#include <pthread.h>
+#include <sched.h>
 #include <strings.h>
+#include <limits.h>
 
 #include <ms_list/ms_singly_linked.h>
 #include <ms_list/ms_doubly_linked.h>
 #include <ms_list/ms_circular_linked.h>
+#include <ms_list/ms_intrusive_linked.h>
+#include <ms_content.h>
+#include <ms_epoch.h>
+#include <ms_hazard.h>
+#include <ms_combining.h>
+#include <ms_pool.h>
 #include <ms_stack.h>
 #include <ms_queue.h>
+#include <ms_queue_blocking.h>
+#include <ms_heap.h>
+#include <ms_heap_pairing.h>
+#include <ms_channel.h>
+#include <ms_timer.h>
 #include <ms_dict.h>
+#include <ms_dict_sharded.h>
+#include <ms_dict_lockfree.h>
 #include <ms_hash.h>
+#include <ms_dict_typed.h>
+#include <ms_intrusive_dict.h>
+#include <ms_cache.h>
 #include <ms_tree/ms_binary.h>
 #include <ms_tree/ms_red_black.h>
+#include <ms_tree/ms_red_black_typed.h>
+#include <ms_tree/ms_intrusive_red_black.h>
+#include <ms_tree/ms_radix.h>
+#include <ms_tree/ms_persistent.h>
+#include <ms_tree/ms_skip_list.h>
 
 # define SUCCESS 0
 # define FAILURE 1
@@ -358,6 +382,180 @@ int unit_queue(void)
 	return (SUCCESS);
 }
 
+static void * unit_queue_blocking_run(void * arg)
+{
+	size_t       i;
+	t_queue_bk * queue;
+
+	queue = MS_CAST(t_queue_bk *, arg);
+	i = 0;
+	while (i < size) {
+		queue_bk_enqueue_wait(queue, MS_CAST(void *, str[i]), 0, MS_FUTEX_INFINITE);
+		++i;
+	}
+	queue_bk_enqueue_batch(queue, MS_CAST(void **, str), size, MS_FUTEX_INFINITE);
+	return (NULL);
+}
+
+int unit_queue_blocking(void)
+{
+	size_t       i;
+	size_t       j;
+	size_t       count;
+	pthread_t    tid;
+	void       * datas[3];
+	t_queue_bk * queue;
+
+	if (0 != queue_bk_init(&queue, 4)) {
+		printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	if (
+		   MS_ADDRCK(queue_bk_dequeue_wait(queue, 0))
+		|| MS_ADDRCK(queue_bk_dequeue_wait(queue, 10))
+	) {
+		printf("\n%s: %d - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	pthread_create(&tid, NULL, &unit_queue_blocking_run, queue);
+	i = 0;
+	while (i < size) {
+		if (str[i] != queue_bk_dequeue_wait(queue, MS_FUTEX_INFINITE)) {
+			printf("\n%s: %d => %zu - ", __FILE__, __LINE__, i);
+			return (FAILURE);
+		}
+		++i;
+	}
+	i = 0;
+	while (i < size) {
+		count = queue_bk_dequeue_batch(queue, datas, 3, MS_FUTEX_INFINITE);
+		j = 0;
+		while (j < count) {
+			if (str[i] != datas[j]) {
+				printf("\n%s: %d => %zu - ", __FILE__, __LINE__, i);
+				return (FAILURE);
+			}
+			++i;
+			++j;
+		}
+	}
+	pthread_join(tid, NULL);
+	if (
+		   4 != queue_bk_enqueue_batch(queue, MS_CAST(void **, str), size, 0)
+		|| 0 == queue_bk_enqueue_wait(queue, MS_CAST(void *, str[0]), 0, 10)
+		|| 4 != queue_bk_size(queue)
+	) {
+		printf("\n%s: %d => %zu - ", __FILE__, __LINE__, queue_bk_size(queue));
+		return (FAILURE);
+	}
+	queue_bk_destroy(queue, NULL);
+	return (SUCCESS);
+}
+
+static void * unit_channel_run(void * arg)
+{
+	size_t       i;
+	t_channel ** channels;
+
+	channels = MS_CAST(t_channel **, arg);
+	i = 0;
+	while (i < size) {
+		channel_send(channels[0], MS_CAST(void *, str[i]), MS_FUTEX_INFINITE);
+		++i;
+	}
+	i = 0;
+	while (i < size) {
+		channel_send(channels[i % 2], MS_CAST(void *, str[i]), MS_FUTEX_INFINITE);
+		++i;
+	}
+	channel_close(channels[0]);
+	channel_close(channels[1]);
+	return (NULL);
+}
+
+int unit_channel(void)
+{
+	int            ret;
+	size_t         i;
+	size_t         next[2];
+	void         * data;
+	pthread_t      tid;
+	t_channel    * channels[2];
+	t_channel_case cases[2];
+
+	if (
+		   0 != channel_init(&channels[0], 0)
+		|| 0 != channel_init(&channels[1], 2)
+	) {
+		printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	if (
+		   MS_CHANNEL_TIMEOUT != channel_recv(channels[0], &data, 0)
+		|| MS_CHANNEL_TIMEOUT != channel_send(channels[0], MS_CAST(void *, str[0]), 10)
+		|| 0 != channel_send(channels[1], MS_CAST(void *, str[0]), 0)
+		|| 0 != channel_send(channels[1], MS_CAST(void *, str[1]), 0)
+		|| MS_CHANNEL_TIMEOUT != channel_send(channels[1], MS_CAST(void *, str[2]), 10)
+		|| 0 != channel_recv(channels[1], &data, 0)
+		|| str[0] != data
+		|| 0 != channel_recv(channels[1], &data, 0)
+		|| str[1] != data
+	) {
+		printf("\n%s: %d - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	pthread_create(&tid, NULL, &unit_channel_run, channels);
+	i = 0;
+	while (i < size) {
+		if (
+			   0 != channel_recv(channels[0], &data, MS_FUTEX_INFINITE)
+			|| str[i] != data
+		) {
+			printf("\n%s: %d => %zu - ", __FILE__, __LINE__, i);
+			return (FAILURE);
+		}
+		++i;
+	}
+	next[0] = 0;
+	next[1] = 1;
+	while (
+		   next[0] < size
+		|| next[1] < size
+	) {
+		cases[0].channel = channels[0];
+		cases[0].op      = MS_CHANNEL_RECV;
+		cases[1].channel = channels[1];
+		cases[1].op      = MS_CHANNEL_RECV;
+		ret = channel_select(cases, 2, MS_FUTEX_INFINITE);
+		if (
+			   ret < 0
+			|| 0 != cases[ret].closed
+			|| str[next[ret]] != cases[ret].data
+		) {
+			printf("\n%s: %d => %d - ", __FILE__, __LINE__, ret);
+			return (FAILURE);
+		}
+		next[ret] += 2;
+	}
+	pthread_join(tid, NULL);
+	cases[0].channel = channels[0];
+	cases[0].op      = MS_CHANNEL_SEND;
+	cases[0].data    = MS_CAST(void *, str[0]);
+	if (
+		   0 != channel_select(cases, 1, 0)
+		|| 0 == cases[0].closed
+		|| MS_CHANNEL_CLOSED != channel_send(channels[1], MS_CAST(void *, str[0]), MS_FUTEX_INFINITE)
+		|| MS_CHANNEL_CLOSED != channel_recv(channels[1], &data, MS_FUTEX_INFINITE)
+		|| 1 != channel_close(channels[1])
+	) {
+		printf("\n%s: %d - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	channel_destroy(channels[0], NULL);
+	channel_destroy(channels[1], NULL);
+	return (SUCCESS);
+}
+
 static int f_compare(
 	  void * data
 	, unsigned char * key
@@ -367,6 +565,221 @@ static int f_compare(
 	return (strcmp(MS_CAST(char *, data), MS_CAST(char *, key)));
 }
 
+static int unit_dictionary_batch(t_dict * dict)
+{
+	size_t          i;
+	size_t          found;
+	void          * datas[32];
+	size_t          key_lens[32];
+	unsigned char * keys[32];
+
+	i = 0;
+	while (i < 2 * size) {
+		if (i < size) {
+			keys[i] = MS_CAST(unsigned char *, str[i]);
+		} else {
+			keys[i] = MS_CAST(unsigned char *, "Potato");
+		}
+		key_lens[i] = strlen(MS_CAST(char *, keys[i]));
+		++i;
+	}
+	found = dict_search_batch(dict, keys, key_lens, 2 * size, datas, &f_compare);
+	if (size != found) {
+		printf("\n%s: %d => %zu != %zu - ", __FILE__, __LINE__, found, size);
+		return (FAILURE);
+	}
+	i = 0;
+	while (i < 2 * size) {
+		if ((i < size) != MS_ADDRCK(datas[i]) || (i < size && datas[i] != str[i])) {
+			printf("\n%s: %d => %zu - ", __FILE__, __LINE__, i);
+			return (FAILURE);
+		}
+		++i;
+	}
+	return (SUCCESS);
+}
+
+static int f_seen(void * data, void ** content)
+{
+	size_t i;
+
+	i = 0;
+	while (i < size && 0 != strcmp(str[i], MS_CAST(char *, data))) {
+		++i;
+	}
+	if (i == size) {
+		return (1);
+	}
+	++(MS_CAST(size_t *, content))[i];
+	return (0);
+}
+
+static int unit_dictionary_scan(t_dict * dict)
+{
+	size_t i;
+	size_t step;
+	size_t cursor;
+	size_t seen[16];
+
+	MS_MEMSET(seen, 0, sizeof(seen));
+	if (0 != dict_foreach(dict, MS_CAST(void **, seen), &f_seen)) {
+		printf("\n%s: %d - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	i = 0;
+	while (i < size) {
+		if (1 != seen[i]) {
+			printf("\n%s: %d => %s %zu - ", __FILE__, __LINE__, str[i], seen[i]);
+			return (FAILURE);
+		}
+		++i;
+	}
+	MS_MEMSET(seen, 0, sizeof(seen));
+	step = 0;
+	cursor = 0;
+	while (0 == step || 0 != cursor) {
+		cursor = dict_scan(dict, cursor, MS_CAST(void **, seen), &f_seen);
+		++step;
+		if (2 == step && 0 != dict_resize(dict, 64)) {
+			printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+			return (FAILURE);
+		}
+		if (9 == step && 0 != dict_resize(dict, 2)) {
+			printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+			return (FAILURE);
+		}
+	}
+	i = 0;
+	while (i < size) {
+		if (0 == seen[i]) {
+			printf("\n%s: %d => %s - ", __FILE__, __LINE__, str[i]);
+			return (FAILURE);
+		}
+		++i;
+	}
+	if (size != dict_size(dict)) {
+		printf("\n%s: %d => %zu != %zu - ", __FILE__, __LINE__, dict_size(dict), size);
+		return (FAILURE);
+	}
+	return (SUCCESS);
+}
+
+typedef struct s_word
+{
+	const char * word;
+	size_t       count;
+} t_word;
+
+static int f_compare_word(
+	  void * data
+	, unsigned char * key
+	, size_t key_len
+) {
+	MS_UNUSED(key_len);
+	return (strcmp((MS_CAST(t_word *, data))->word, MS_CAST(char *, key)));
+}
+
+static t_word * unit_dictionary_count(
+	  t_dict * dict
+	, const char * word
+) {
+	t_word   init;
+	void  ** slot;
+
+	init.word  = word;
+	init.count = 0;
+	slot = dict_get_or_insert(
+		  dict
+		, &init
+		, sizeof(t_word)
+		, MS_CAST(unsigned char *, word)
+		, strlen(word)
+		, &f_compare_word
+	);
+	if (MS_ADDRNULL(slot)) {
+		return (NULL);
+	}
+	return (MS_CAST(t_word *, *slot));
+}
+
+static int unit_dictionary_upsert(void)
+{
+	size_t   i;
+	t_word   word;
+	t_word * tmp;
+	t_dict * dict;
+
+	dict = NULL;
+	if (0 != dict_init(&dict, 2, &hash_fnv_onea)) {
+		printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	i = 0;
+	while (i < 2 * size) {
+		tmp = unit_dictionary_count(dict, str[i % size]);
+		if (MS_ADDRNULL(tmp)) {
+			printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+			return (FAILURE);
+		}
+		++tmp->count;
+		++i;
+	}
+	i = 0;
+	while (i < size) {
+		tmp = unit_dictionary_count(dict, str[i]);
+		if (MS_ADDRNULL(tmp) || 2 != tmp->count) {
+			printf("\n%s: %d => %s - ", __FILE__, __LINE__, str[i]);
+			return (FAILURE);
+		}
+		word.word  = str[i];
+		word.count = i;
+		if (0 != dict_upsert(
+			  dict
+			, &word
+			, sizeof(t_word)
+			, MS_CAST(unsigned char *, str[i])
+			, strlen(str[i])
+			, &f_compare_word
+			, &free
+		)) {
+			printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+			return (FAILURE);
+		}
+		++i;
+	}
+	if (size != dict_size(dict)) {
+		printf("\n%s: %d => %zu != %zu - ", __FILE__, __LINE__, dict_size(dict), size);
+		return (FAILURE);
+	}
+	tmp = unit_dictionary_count(dict, str[0]);
+	if (
+		   0 != dict_upsert(
+			  dict
+			, tmp
+			, 0
+			, MS_CAST(unsigned char *, str[0])
+			, strlen(str[0])
+			, &f_compare_word
+			, &free
+		)
+		|| tmp != unit_dictionary_count(dict, str[0])
+	) {
+		printf("\n%s: %d => %s - ", __FILE__, __LINE__, str[0]);
+		return (FAILURE);
+	}
+	i = 0;
+	while (i < size) {
+		tmp = unit_dictionary_count(dict, str[i]);
+		if (MS_ADDRNULL(tmp) || i != tmp->count) {
+			printf("\n%s: %d => %s - ", __FILE__, __LINE__, str[i]);
+			return (FAILURE);
+		}
+		++i;
+	}
+	dict_destroy(dict, &free);
+	return (SUCCESS);
+}
+
 int unit_dictionary(void)
 {
 	size_t   i;
@@ -414,6 +827,26 @@ int unit_dictionary(void)
 		}
 		++i;
 	}
+	if (0 != unit_dictionary_batch(dict)) {
+		return (FAILURE);
+	}
+	if (0 != unit_dictionary_scan(dict)) {
+		return (FAILURE);
+	}
+	if (0 != unit_dictionary_upsert()) {
+		return (FAILURE);
+	}
+	tmp = MS_CAST(char *, dict_search(
+		  dict
+		, MS_CAST(unsigned char *, str[0])
+		, strlen(str[0])
+		, MS_ELEMENT_REMOVE
+		, &f_compare
+	));
+	if (tmp != str[0] || size - 1 != dict_size(dict)) {
+		printf("\n%s: %d => %s != %s - ", __FILE__, __LINE__, tmp, str[0]);
+		return (FAILURE);
+	}
 	tmp = MS_CAST(char *, dict_search(
 		  dict
 		, MS_CAST(unsigned char *, "Potato")
@@ -447,6 +880,53 @@ static int f_print_2(void * data, void ** content)
 	return (0);
 }
 
+static int unit_tree_batch(
+	  t_tree ** tree
+	, t_tree_rb ** tree_rb
+) {
+	size_t      i;
+	size_t      found;
+	void      * datas[32];
+	void      * elems[32];
+	t_tree    * empty;
+	t_tree_rb * empty_rb;
+
+	i = 0;
+	while (i < 2 * size) {
+		datas[i] = (i < size) ? MS_CAST(void *, str[i]) : MS_CAST(void *, "Potato");
+		++i;
+	}
+	empty = NULL;
+	empty_rb = NULL;
+	elems[0] = datas[0];
+	if (
+		   0 != tree_search_batch(&empty, datas, 2 * size, elems, &f_compare_2)
+		|| MS_ADDRCK(elems[0])
+		|| 0 != tree_rb_search_batch(&empty_rb, datas, 2 * size, elems, &f_compare_2)
+	) {
+		printf("\n%s: %d => EMPTY - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	if (MS_ADDRCK(tree)) {
+		found = tree_search_batch(tree, datas, 2 * size, elems, &f_compare_2);
+	} else {
+		found = tree_rb_search_batch(tree_rb, datas, 2 * size, elems, &f_compare_2);
+	}
+	if (size != found) {
+		printf("\n%s: %d => %zu != %zu - ", __FILE__, __LINE__, found, size);
+		return (FAILURE);
+	}
+	i = 0;
+	while (i < 2 * size) {
+		if ((i < size) != MS_ADDRCK(elems[i]) || (i < size && elems[i] != str[i])) {
+			printf("\n%s: %d => %zu - ", __FILE__, __LINE__, i);
+			return (FAILURE);
+		}
+		++i;
+	}
+	return (SUCCESS);
+}
+
 int unit_tree(void)
 {
 	size_t   i;
@@ -473,6 +953,10 @@ int unit_tree(void)
 		}
 		++i;
 	}
+	ret = unit_tree_batch(&tree, NULL);
+	if (0 != ret) {
+		return (FAILURE);
+	}
 	ret = tree_in_order(
 		  &tree
 		, NULL
@@ -522,6 +1006,10 @@ int unit_tree_rb(void)
 		}
 		++i;
 	}
+	ret = unit_tree_batch(NULL, &tree);
+	if (0 != ret) {
+		return (FAILURE);
+	}
 	ret = tree_rb_in_order(
 		  &tree
 		, NULL
@@ -545,37 +1033,2091 @@ int unit_tree_rb(void)
 	return (SUCCESS);
 }
 
-int main(void)
+MS_DICT_DECLARE(long, long, long, hash_int, MS_DICT_EQ)
+
+int unit_dictionary_typed(void)
 {
-	printf("TEST: Singly-linked list: ");
-	if (SUCCESS == unit_list_singly()) {
-		printf("SUCESS\n");
-	} else {
-		printf("FAILURE\n");
-	}
-	printf("TEST: Doubly-linked list: ");
-	if (SUCCESS == unit_list_doubly()) {
-		printf("SUCESS\n");
-	} else {
-		printf("FAILURE\n");
+	long          i;
+	long          val;
+	long        * tmp;
+	t_dict_long * dict;
+
+	dict = NULL;
+	if (0 != dict_long_init(&dict, 0)) {
+		printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+		return (FAILURE);
 	}
-	printf("TEST: Circular Linked list: ");
-	if (SUCCESS == unit_list_circular()) {
-		printf("SUCESS\n");
-	} else {
-		printf("FAILURE\n");
+	i = 0;
+	while (i < 1000) {
+		if (0 != dict_long_insert(dict, i * 7, i)) {
+			printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+			return (FAILURE);
+		}
+		++i;
 	}
-	printf("TEST: Stack: ");
-	if (SUCCESS == unit_stack()) {
-		printf("SUCESS\n");
-	} else {
-		printf("FAILURE\n");
+	i = 0;
+	while (i < 1000) {
+		dict_long_insert(dict, i * 7, i * 2);
+		i += 2;
 	}
-	printf("TEST: Queue: ");
-	if (SUCCESS == unit_queue()) {
-		printf("SUCESS\n");
-	} else {
-		printf("FAILURE\n");
+	if (1000 != dict_long_size(dict)) {
+		printf("\n%s: %d => %zu - ", __FILE__, __LINE__, dict_long_size(dict));
+		return (FAILURE);
+	}
+	i = 0;
+	while (i < 1000) {
+		if (0 == i % 3 && 0 != dict_long_remove(dict, i * 7, &val)) {
+			printf("\n%s: %d => %ld - ", __FILE__, __LINE__, i);
+			return (FAILURE);
+		}
+		++i;
+	}
+	i = 0;
+	while (i < 7000) {
+		tmp = dict_long_search(dict, i);
+		if (0 != i % 7 || 0 == (i / 7) % 3) {
+			if (MS_ADDRCK(tmp)) {
+				printf("\n%s: %d => %ld - ", __FILE__, __LINE__, i);
+				return (FAILURE);
+			}
+		} else if (MS_ADDRNULL(tmp) || *tmp != (i / 7) * (((i / 7) % 2) ? 1 : 2)) {
+			printf("\n%s: %d => %ld - ", __FILE__, __LINE__, i);
+			return (FAILURE);
+		}
+		++i;
+	}
+	if (666 != dict_long_size(dict) || 0 == dict_long_remove(dict, 0, NULL)) {
+		printf("\n%s: %d => %zu - ", __FILE__, __LINE__, dict_long_size(dict));
+		return (FAILURE);
+	}
+	dict_long_destroy(dict);
+	return (SUCCESS);
+}
+
+static int f_count(void * data, void ** content)
+{
+	MS_UNUSED(data);
+	++*MS_CAST(size_t *, content);
+	return (0);
+}
+
+static int f_sorted(void * data, void ** content)
+{
+	if (
+		   MS_ADDRCK(*content)
+		&& strcmp(MS_CAST(char *, *content), MS_CAST(char *, data)) >= 0
+	) {
+		return (1);
+	}
+	*content = data;
+	return (0);
+}
+
+int unit_tree_art(void)
+{
+	size_t       i;
+	size_t       count;
+	int          ret;
+	char       * tmp;
+	char         key[64];
+	t_tree_art * tree;
+
+	tree = NULL;
+	ret = tree_art_is_empty(tree);
+	if (0 == ret) {
+		printf("\n%s: %d - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	ret = tree_art_init(&tree);
+	if (1 == ret) {
+		printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	i = 0;
+	while (i < size) {
+		ret = tree_art_insert(
+			  tree
+			, MS_CAST(void *, str[i])
+			, 0
+			, MS_CAST(unsigned char *, str[i])
+			, strlen(str[i])
+		);
+		if (0 != ret) {
+			printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+			return (FAILURE);
+		}
+		++i;
+	}
+	ret = tree_art_insert(tree, "Pea", 0, MS_CAST(unsigned char *, "Pea"), 3);
+	ret |= tree_art_insert(tree, "P", 0, MS_CAST(unsigned char *, "P"), 1);
+	if (0 != ret) {
+		printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	ret = tree_art_insert(tree, "Peach", 0, MS_CAST(unsigned char *, "Peach"), 5);
+	if (1 != ret || size + 2 != tree_art_size(tree)) {
+		printf("\n%s: %d => duplicate inserted - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	i = 0;
+	while (i < size) {
+		tmp = MS_CAST(char *, tree_art_search(
+			  tree
+			, MS_CAST(unsigned char *, str[i])
+			, strlen(str[i])
+			, 0x00
+		));
+		if (MS_ADDRNULL(tmp) || 0 != strcmp(str[i], tmp)) {
+			printf("\n%s: %d => %s != %s - ", __FILE__, __LINE__, tmp, str[i]);
+			return (FAILURE);
+		}
+		++i;
+	}
+	tmp = MS_CAST(char *, tree_art_search(tree, MS_CAST(unsigned char *, "Pe"), 2, 0x00));
+	if (MS_ADDRCK(tmp)) {
+		printf("\n%s: %d => %s != NULL - ", __FILE__, __LINE__, tmp);
+		return (FAILURE);
+	}
+	count = 0;
+	ret = tree_art_prefix(tree, MS_CAST(unsigned char *, "Pe"), 2, MS_CAST(void **, &count), &f_count);
+	if (0 != ret || 3 != count) {
+		printf("\n%s: %d => %zu != 3 - ", __FILE__, __LINE__, count);
+		return (FAILURE);
+	}
+	count = 0;
+	ret = tree_art_prefix(tree, MS_CAST(unsigned char *, "P"), 1, MS_CAST(void **, &count), &f_count);
+	if (0 != ret || 5 != count) {
+		printf("\n%s: %d => %zu != 5 - ", __FILE__, __LINE__, count);
+		return (FAILURE);
+	}
+	tmp = NULL;
+	ret = tree_art_in_order(tree, MS_CAST(void **, &tmp), &f_sorted);
+	if (0 != ret) {
+		printf("\n%s: %d => not sorted - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	i = 0;
+	while (i < 4096) {
+		snprintf(key, sizeof(key), "/a/rather/long/shared/path/%zu/%zu", i % 7, i);
+		ret = tree_art_insert(tree, key, strlen(key) + 1, MS_CAST(unsigned char *, key), strlen(key));
+		if (0 != ret) {
+			printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+			return (FAILURE);
+		}
+		++i;
+	}
+	i = 0;
+	while (i < 4096) {
+		snprintf(key, sizeof(key), "/a/rather/long/shared/path/%zu/%zu", i % 7, i);
+		tmp = MS_CAST(char *, tree_art_search(
+			  tree
+			, MS_CAST(unsigned char *, key)
+			, strlen(key)
+			, (i % 2) ? MS_ELEMENT_REMOVE : 0x00
+		));
+		if (MS_ADDRNULL(tmp) || 0 != strcmp(key, tmp)) {
+			printf("\n%s: %d => %s != %s - ", __FILE__, __LINE__, tmp, key);
+			return (FAILURE);
+		}
+		if (i % 2) {
+			free(tmp);
+		}
+		++i;
+	}
+	count = 0;
+	ret = tree_art_prefix(tree, MS_CAST(unsigned char *, "/a/rather/long/shared/path/3/"), 29, MS_CAST(void **, &count), &f_count);
+	if (0 != ret || 292 != count) {
+		printf("\n%s: %d => %zu != 292 - ", __FILE__, __LINE__, count);
+		return (FAILURE);
+	}
+	i = 0;
+	while (i < 4096) {
+		snprintf(key, sizeof(key), "/a/rather/long/shared/path/%zu/%zu", i % 7, i);
+		tmp = MS_CAST(char *, tree_art_search(
+			  tree
+			, MS_CAST(unsigned char *, key)
+			, strlen(key)
+			, MS_ELEMENT_REMOVE
+		));
+		if ((i % 2) == MS_ADDRCK(tmp)) {
+			printf("\n%s: %d => %s - ", __FILE__, __LINE__, key);
+			return (FAILURE);
+		}
+		free(tmp);
+		++i;
+	}
+	i = 0;
+	while (i < size) {
+		tmp = MS_CAST(char *, tree_art_search(
+			  tree
+			, MS_CAST(unsigned char *, str[i])
+			, strlen(str[i])
+			, MS_ELEMENT_REMOVE
+		));
+		if (MS_ADDRNULL(tmp) || 0 != strcmp(str[i], tmp)) {
+			printf("\n%s: %d => %s != %s - ", __FILE__, __LINE__, tmp, str[i]);
+			return (FAILURE);
+		}
+		++i;
+	}
+	tree_art_search(tree, MS_CAST(unsigned char *, "P"), 1, MS_ELEMENT_REMOVE);
+	tree_art_search(tree, MS_CAST(unsigned char *, "Pea"), 3, MS_ELEMENT_REMOVE);
+	ret = tree_art_is_empty(tree);
+	if (0 == ret || 0 != tree_art_size(tree)) {
+		printf("\n%s: %d - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	tree_art_destroy(tree, NULL);
+	return (SUCCESS);
+}
+
+static int f_compare_long(
+	  void * elem
+	, void * data
+) {
+	long a;
+	long b;
+
+	a = *MS_CAST(long *, elem);
+	b = *MS_CAST(long *, data);
+	return ((b > a) - (b < a));
+}
+
+static long f_key_long(void * data)
+{
+	return (*MS_CAST(long *, data));
+}
+
+MS_TREE_RB_DECLARE(long, long, long, MS_TREE_CMP)
+
+static int f_sorted_long(
+	  long key
+	, long * val
+	, void ** content
+) {
+	long * prev;
+
+	prev = MS_CAST(long *, content);
+	if (key <= *prev || *val != key * 2) {
+		return (1);
+	}
+	*prev = key;
+	return (0);
+}
+
+int unit_tree_rb_typed(void)
+{
+	long             i;
+	long             prev;
+	long           * tmp;
+	t_tree_rb_long * tree;
+
+	tree = NULL;
+	if (0 != tree_rb_long_init(&tree)) {
+		printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	i = 0;
+	while (i < 1009) {
+		if (0 != tree_rb_long_insert(tree, (i * 37) % 1009, i)) {
+			printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+			return (FAILURE);
+		}
+		++i;
+	}
+	i = 0;
+	while (i < 1009) {
+		tree_rb_long_insert(tree, i, 2 * i);
+		++i;
+	}
+	if (1009 != tree_rb_long_size(tree) || 1 == tree_rb_long_is_empty(tree)) {
+		printf("\n%s: %d => %zu - ", __FILE__, __LINE__, tree_rb_long_size(tree));
+		return (FAILURE);
+	}
+	i = -1;
+	while (i <= 1009) {
+		tmp = tree_rb_long_search(tree, i);
+		if ((0 <= i && i < 1009) != MS_ADDRCK(tmp) || (MS_ADDRCK(tmp) && *tmp != 2 * i)) {
+			printf("\n%s: %d => %ld - ", __FILE__, __LINE__, i);
+			return (FAILURE);
+		}
+		++i;
+	}
+	prev = -1;
+	if (0 != tree_rb_long_in_order(tree, MS_CAST(void **, &prev), &f_sorted_long) || 1008 != prev) {
+		printf("\n%s: %d => %ld - ", __FILE__, __LINE__, prev);
+		return (FAILURE);
+	}
+	tree_rb_long_destroy(tree);
+	return (SUCCESS);
+}
+
+int unit_tree_fz(void)
+{
+	size_t      i;
+	int         ret;
+	char      * tmp;
+	long        keys[1000];
+	void      * elems[1000];
+	t_tree_rb * tree;
+	t_tree_fz * frozen;
+
+	tree = NULL;
+	i = 0;
+	while (i < size) {
+		ret = tree_rb_insert(&tree, MS_CAST(void *, str[i]), 0, &f_compare_2);
+		if (0 != ret) {
+			printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+			return (FAILURE);
+		}
+		++i;
+	}
+	ret = tree_rb_freeze(&tree, &frozen, NULL);
+	if (0 != ret || size != tree_fz_size(frozen)) {
+		printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	tree_rb_destroy(&tree, NULL);
+	i = 0;
+	while (i < size) {
+		tmp = MS_CAST(char *, tree_fz_search(frozen, MS_CAST(void *, str[i]), &f_compare_2));
+		if (MS_ADDRNULL(tmp) || 0 != strcmp(str[i], tmp)) {
+			printf("\n%s: %d => %s != %s - ", __FILE__, __LINE__, tmp, str[i]);
+			return (FAILURE);
+		}
+		++i;
+	}
+	tmp = MS_CAST(char *, tree_fz_search(frozen, "Potato", &f_compare_2));
+	if (MS_ADDRCK(tmp)) {
+		printf("\n%s: %d => %s != NULL - ", __FILE__, __LINE__, tmp);
+		return (FAILURE);
+	}
+	tmp = NULL;
+	ret = tree_fz_in_order(frozen, MS_CAST(void **, &tmp), &f_sorted);
+	if (0 != ret) {
+		printf("\n%s: %d => not sorted - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	tree_fz_destroy(frozen, NULL);
+	i = 0;
+	while (i < 1000) {
+		keys[i] = MS_CAST(long, i);
+		if (0 == i % 3) {
+			ret = tree_rb_insert(&tree, &keys[i], 0, &f_compare_long);
+			if (0 != ret) {
+				printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+				return (FAILURE);
+			}
+		}
+		++i;
+	}
+	ret = tree_rb_freeze(&tree, &frozen, &f_key_long);
+	if (0 != ret || 334 != tree_fz_size(frozen)) {
+		printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	i = 0;
+	while (i < 1000) {
+		if ((0 == i % 3) != MS_ADDRCK(tree_fz_search_key(frozen, keys[i]))) {
+			printf("\n%s: %d => %zu - ", __FILE__, __LINE__, i);
+			return (FAILURE);
+		}
+		++i;
+	}
+	if (334 != tree_fz_search_keys(frozen, keys, 1000, elems)) {
+		printf("\n%s: %d - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	i = 0;
+	while (i < 1000) {
+		if ((0 == i % 3) != (elems[i] == &keys[i])) {
+			printf("\n%s: %d => %zu - ", __FILE__, __LINE__, i);
+			return (FAILURE);
+		}
+		++i;
+	}
+	tree_fz_destroy(frozen, NULL);
+	tree_rb_destroy(&tree, NULL);
+	return (SUCCESS);
+}
+
+int unit_tree_prb(void)
+{
+	size_t       i;
+	size_t       j;
+	int          ret;
+	char       * tmp;
+	t_tree_prb * snapshot;
+	t_tree_prb * versions[32];
+
+	ret = tree_prb_is_empty(NULL);
+	if (0 == ret) {
+		printf("\n%s: %d - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	i = 0;
+	while (i < size) {
+		versions[i] = tree_prb_insert(
+			  (0 == i) ? NULL : versions[i - 1]
+			, MS_CAST(void *, str[i])
+			, strlen(str[i]) + 1
+			, &f_compare_2
+		);
+		if (MS_ADDRNULL(versions[i])) {
+			printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+			return (FAILURE);
+		}
+		++i;
+	}
+	snapshot = tree_prb_snapshot(versions[size / 2]);
+	i = 0;
+	while (i < size) {
+		if (i + 1 != tree_prb_size(versions[i])) {
+			printf("\n%s: %d => %zu - ", __FILE__, __LINE__, i);
+			return (FAILURE);
+		}
+		j = 0;
+		while (j < size) {
+			tmp = MS_CAST(char *, tree_prb_search(versions[i], MS_CAST(void *, str[j]), &f_compare_2));
+			if ((j <= i) != MS_ADDRCK(tmp) || (MS_ADDRCK(tmp) && 0 != strcmp(tmp, str[j]))) {
+				printf("\n%s: %d => %zu %zu - ", __FILE__, __LINE__, i, j);
+				return (FAILURE);
+			}
+			++j;
+		}
+		tmp = NULL;
+		ret = tree_prb_in_order(versions[i], MS_CAST(void **, &tmp), &f_sorted);
+		if (0 != ret) {
+			printf("\n%s: %d => not sorted - ", __FILE__, __LINE__);
+			return (FAILURE);
+		}
+		++i;
+	}
+	i = 0;
+	while (i < size) {
+		tree_prb_destroy(&versions[(i * 7) % size], &free);
+		++i;
+	}
+	if (size / 2 + 1 != tree_prb_size(snapshot)) {
+		printf("\n%s: %d - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	tree_prb_destroy(&snapshot, &free);
+	ret = tree_prb_is_empty(snapshot);
+	if (0 == ret) {
+		printf("\n%s: %d - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	return (SUCCESS);
+}
+
+# define SHARDED_THREADS 4
+# define SHARDED_KEYS    512
+
+typedef struct s_sharded
+{
+	t_dict_sh * dict;
+	size_t      thread;
+	size_t      missing;
+} t_sharded;
+
+static char g_sharded[SHARDED_THREADS][SHARDED_KEYS][16];
+
+static void * unit_dictionary_sharded_run(void * arg)
+{
+	size_t      i;
+	char      * key;
+	t_sharded * sharded;
+
+	sharded = MS_CAST(t_sharded *, arg);
+	i = 0;
+	while (i < SHARDED_KEYS) {
+		key = g_sharded[sharded->thread][i];
+		dict_sh_insert(sharded->dict, key, 0, MS_CAST(unsigned char *, key), strlen(key));
+		if (key != dict_sh_search(sharded->dict, MS_CAST(unsigned char *, key), strlen(key), 0, &f_compare)) {
+			++sharded->missing;
+		}
+		++i;
+	}
+	return (NULL);
+}
+
+int unit_dictionary_sharded(void)
+{
+	size_t      i;
+	size_t      t;
+	size_t      count;
+	pthread_t   tids[SHARDED_THREADS];
+	t_sharded   shardeds[SHARDED_THREADS];
+	t_dict_sh * dict;
+
+	dict = NULL;
+	if (0 != dict_sh_init(&dict, 8, 8, &hash_fnv_onea)) {
+		printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	t = 0;
+	while (t < SHARDED_THREADS) {
+		i = 0;
+		while (i < SHARDED_KEYS) {
+			snprintf(g_sharded[t][i], sizeof(g_sharded[t][i]), "%zu-%zu", t, i);
+			++i;
+		}
+		shardeds[t].dict    = dict;
+		shardeds[t].thread  = t;
+		shardeds[t].missing = 0;
+		pthread_create(&tids[t], NULL, &unit_dictionary_sharded_run, &shardeds[t]);
+		++t;
+	}
+	t = 0;
+	while (t < SHARDED_THREADS) {
+		pthread_join(tids[t], NULL);
+		if (0 != shardeds[t].missing) {
+			printf("\n%s: %d => %zu - ", __FILE__, __LINE__, shardeds[t].missing);
+			return (FAILURE);
+		}
+		++t;
+	}
+	i = 0;
+	while (i < SHARDED_KEYS) {
+		if (g_sharded[1][i] != dict_sh_search(
+			  dict
+			, MS_CAST(unsigned char *, g_sharded[1][i])
+			, strlen(g_sharded[1][i])
+			, MS_ELEMENT_REMOVE
+			, &f_compare
+		)) {
+			printf("\n%s: %d => %s - ", __FILE__, __LINE__, g_sharded[1][i]);
+			return (FAILURE);
+		}
+		++i;
+	}
+	count = 0;
+	if (
+		   0 != dict_sh_foreach(dict, MS_CAST(void **, &count), &f_count)
+		|| (SHARDED_THREADS - 1) * SHARDED_KEYS != count
+		|| count != dict_sh_size(dict)
+	) {
+		printf("\n%s: %d => %zu - ", __FILE__, __LINE__, count);
+		return (FAILURE);
+	}
+	dict_sh_destroy(dict, NULL);
+	return (SUCCESS);
+}
+
+typedef struct s_lockfree
+{
+	t_dict_lf * dict;
+	size_t      thread;
+	size_t      missing;
+} t_lockfree;
+
+static void * unit_dictionary_lockfree_run(void * arg)
+{
+	size_t       i;
+	char       * key;
+	char       * other;
+	t_lockfree * lockfree;
+
+	lockfree = MS_CAST(t_lockfree *, arg);
+	i = 0;
+	while (i < SHARDED_KEYS) {
+		key = g_sharded[lockfree->thread][i];
+		other = g_sharded[(lockfree->thread + 1) % SHARDED_THREADS][i];
+		dict_lf_insert(lockfree->dict, key, strlen(key) + 1, MS_CAST(unsigned char *, key), strlen(key));
+		dict_lf_search(lockfree->dict, MS_CAST(unsigned char *, other), strlen(other), &f_compare);
+		if (
+			   MS_ADDRNULL(dict_lf_search(lockfree->dict, MS_CAST(unsigned char *, key), strlen(key), &f_compare))
+			|| (
+				   0 != (i & 1)
+				&& 0 != dict_lf_remove(lockfree->dict, MS_CAST(unsigned char *, key), strlen(key), &f_compare, &free)
+			)
+		) {
+			++lockfree->missing;
+		}
+		++i;
+	}
+	return (NULL);
+}
+
+int unit_dictionary_lockfree(void)
+{
+	size_t       i;
+	size_t       t;
+	size_t       count;
+	void       * data;
+	pthread_t    tids[SHARDED_THREADS];
+	t_lockfree   lockfrees[SHARDED_THREADS];
+	t_dict_lf  * dict;
+
+	dict = NULL;
+	if (0 != dict_lf_init(&dict, 1, &hash_fnv_onea)) {
+		printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	t = 0;
+	while (t < SHARDED_THREADS) {
+		i = 0;
+		while (i < SHARDED_KEYS) {
+			snprintf(g_sharded[t][i], sizeof(g_sharded[t][i]), "%zu-%zu", t, i);
+			++i;
+		}
+		++t;
+	}
+	t = 0;
+	while (t < SHARDED_THREADS) {
+		lockfrees[t].dict    = dict;
+		lockfrees[t].thread  = t;
+		lockfrees[t].missing = 0;
+		pthread_create(&tids[t], NULL, &unit_dictionary_lockfree_run, &lockfrees[t]);
+		++t;
+	}
+	t = 0;
+	while (t < SHARDED_THREADS) {
+		pthread_join(tids[t], NULL);
+		if (0 != lockfrees[t].missing) {
+			printf("\n%s: %d => %zu - ", __FILE__, __LINE__, lockfrees[t].missing);
+			return (FAILURE);
+		}
+		++t;
+	}
+	t = 0;
+	while (t < SHARDED_THREADS) {
+		i = 0;
+		while (i < SHARDED_KEYS) {
+			data = dict_lf_search(
+				  dict
+				, MS_CAST(unsigned char *, g_sharded[t][i])
+				, strlen(g_sharded[t][i])
+				, &f_compare
+			);
+			if (MS_ADDRCK(data) != (0 == (i & 1))) {
+				printf("\n%s: %d => %s - ", __FILE__, __LINE__, g_sharded[t][i]);
+				return (FAILURE);
+			}
+			++i;
+		}
+		++t;
+	}
+	count = 0;
+	if (
+		   0 != dict_lf_foreach(dict, MS_CAST(void **, &count), &f_count)
+		|| SHARDED_THREADS * SHARDED_KEYS / 2 != count
+		|| count != dict_lf_size(dict)
+	) {
+		printf("\n%s: %d => %zu - ", __FILE__, __LINE__, count);
+		return (FAILURE);
+	}
+	dict_lf_destroy(dict, &free);
+	return (SUCCESS);
+}
+
+# define SKIP_THREADS    4
+# define SKIP_KEYS       512
+
+typedef struct s_skip_list
+{
+	t_tree_sl * tree;
+	size_t      thread;
+	size_t      missing;
+} t_skip_list;
+
+static char g_skip[SKIP_THREADS][SKIP_KEYS][16];
+
+static void * unit_tree_sl_run(void * arg)
+{
+	size_t        i;
+	char        * key;
+	char        * other;
+	t_skip_list * skip;
+
+	skip = MS_CAST(t_skip_list *, arg);
+	i = 0;
+	while (i < SKIP_KEYS) {
+		key = g_skip[skip->thread][i];
+		other = g_skip[(skip->thread + 1) % SKIP_THREADS][i];
+		tree_sl_insert(skip->tree, key, strlen(key) + 1, &f_compare_2);
+		tree_sl_search(skip->tree, other, &f_compare_2);
+		if (
+			   0 == tree_sl_insert(skip->tree, key, 0, &f_compare_2)
+			|| MS_ADDRNULL(tree_sl_search(skip->tree, key, &f_compare_2))
+			|| (
+				   0 != (i & 1)
+				&& 0 != tree_sl_remove(skip->tree, key, &f_compare_2, &free)
+			)
+		) {
+			++skip->missing;
+		}
+		++i;
+	}
+	return (NULL);
+}
+
+int unit_tree_sl(void)
+{
+	size_t        i;
+	size_t        t;
+	size_t        count;
+	void        * data;
+	pthread_t     tids[SKIP_THREADS];
+	t_skip_list   skips[SKIP_THREADS];
+	t_tree_sl   * tree;
+
+	tree = NULL;
+	if (0 != tree_sl_init(&tree)) {
+		printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	t = 0;
+	while (t < SKIP_THREADS) {
+		i = 0;
+		while (i < SKIP_KEYS) {
+			snprintf(g_skip[t][i], sizeof(g_skip[t][i]), "%zu-%zu", t, i);
+			++i;
+		}
+		++t;
+	}
+	t = 0;
+	while (t < SKIP_THREADS) {
+		skips[t].tree    = tree;
+		skips[t].thread  = t;
+		skips[t].missing = 0;
+		pthread_create(&tids[t], NULL, &unit_tree_sl_run, &skips[t]);
+		++t;
+	}
+	t = 0;
+	while (t < SKIP_THREADS) {
+		pthread_join(tids[t], NULL);
+		if (0 != skips[t].missing) {
+			printf("\n%s: %d => %zu - ", __FILE__, __LINE__, skips[t].missing);
+			return (FAILURE);
+		}
+		++t;
+	}
+	t = 0;
+	while (t < SKIP_THREADS) {
+		i = 0;
+		while (i < SKIP_KEYS) {
+			data = tree_sl_search(tree, g_skip[t][i], &f_compare_2);
+			if (MS_ADDRCK(data) != (0 == (i & 1))) {
+				printf("\n%s: %d => %s - ", __FILE__, __LINE__, g_skip[t][i]);
+				return (FAILURE);
+			}
+			++i;
+		}
+		++t;
+	}
+	data = NULL;
+	count = 0;
+	if (
+		   0 != tree_sl_range(tree, NULL, NULL, &data, &f_sorted, NULL)
+		|| 0 != tree_sl_range(tree, NULL, NULL, MS_CAST(void **, &count), &f_count, NULL)
+		|| SKIP_THREADS * SKIP_KEYS / 2 != count
+		|| count != tree_sl_size(tree)
+	) {
+		printf("\n%s: %d => %zu - ", __FILE__, __LINE__, count);
+		return (FAILURE);
+	}
+	count = 0;
+	if (
+		   0 != tree_sl_range(tree, "1-", "1-~", MS_CAST(void **, &count), &f_count, &f_compare_2)
+		|| SKIP_KEYS / 2 != count
+	) {
+		printf("\n%s: %d => %zu - ", __FILE__, __LINE__, count);
+		return (FAILURE);
+	}
+	tree_sl_destroy(tree, &free);
+	return (SUCCESS);
+}
+
+# define COMBINING_THREADS 4
+# define COMBINING_KEYS    512
+
+typedef struct s_combining_arg
+{
+	t_combining * comb;
+	size_t        thread;
+	size_t        missing;
+} t_combining_arg;
+
+static char g_combining[COMBINING_THREADS][COMBINING_KEYS][16];
+
+static int unit_combining_insert(
+	  void * container
+	, void * arg
+) {
+	return (tree_rb_insert(MS_CAST(t_tree_rb **, container), arg, 0, &f_compare_2));
+}
+
+static int unit_combining_search(
+	  void * container
+	, void * arg
+) {
+	return (MS_ADDRNULL(tree_rb_search(MS_CAST(t_tree_rb **, container), arg, &f_compare_2)));
+}
+
+static void * unit_combining_run(void * arg)
+{
+	size_t            i;
+	int               ret;
+	char            * key;
+	t_combining_arg * worker;
+
+	worker = MS_CAST(t_combining_arg *, arg);
+	i = 0;
+	while (i < COMBINING_KEYS) {
+		key = g_combining[worker->thread][i];
+		if (
+			   0 != combining_apply(worker->comb, &unit_combining_insert, key, &ret)
+			|| 0 != ret
+			|| 0 != combining_apply(worker->comb, &unit_combining_search, key, &ret)
+			|| 0 != ret
+		) {
+			++worker->missing;
+		}
+		++i;
+	}
+	return (NULL);
+}
+
+int unit_combining(void)
+{
+	size_t            i;
+	size_t            t;
+	size_t            count;
+	void            * data;
+	pthread_t         tids[COMBINING_THREADS];
+	t_combining_arg   args[COMBINING_THREADS];
+	t_tree_rb       * tree;
+	t_combining     * comb;
+
+	tree = NULL;
+	if (0 != combining_init(&comb, &tree)) {
+		printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	t = 0;
+	while (t < COMBINING_THREADS) {
+		i = 0;
+		while (i < COMBINING_KEYS) {
+			snprintf(g_combining[t][i], sizeof(g_combining[t][i]), "%zu-%zu", t, i);
+			++i;
+		}
+		++t;
+	}
+	t = 0;
+	while (t < COMBINING_THREADS) {
+		args[t].comb    = comb;
+		args[t].thread  = t;
+		args[t].missing = 0;
+		pthread_create(&tids[t], NULL, &unit_combining_run, &args[t]);
+		++t;
+	}
+	t = 0;
+	while (t < COMBINING_THREADS) {
+		pthread_join(tids[t], NULL);
+		if (0 != args[t].missing) {
+			printf("\n%s: %d => %zu - ", __FILE__, __LINE__, args[t].missing);
+			return (FAILURE);
+		}
+		++t;
+	}
+	data = NULL;
+	count = 0;
+	if (
+		   0 != tree_rb_in_order(&tree, &data, &f_sorted)
+		|| 0 != tree_rb_in_order(&tree, MS_CAST(void **, &count), &f_count)
+		|| COMBINING_THREADS * COMBINING_KEYS != count
+	) {
+		printf("\n%s: %d => %zu - ", __FILE__, __LINE__, count);
+		return (FAILURE);
+	}
+	combining_destroy(comb);
+	tree_rb_destroy(&tree, NULL);
+	return (SUCCESS);
+}
+
+typedef struct s_fruit
+{
+	const char   * name;
+	t_ilist        list;
+	t_itree_rb     tree;
+	t_idict_node   dict;
+} t_fruit;
+
+static int f_compare_itree(
+	  t_itree_rb * elem
+	, t_itree_rb * node
+) {
+	return (strcmp(
+		  MS_CONTAINER_OF(node, t_fruit, tree)->name
+		, MS_CONTAINER_OF(elem, t_fruit, tree)->name
+	));
+}
+
+static int f_compare_idict(
+	  t_idict_node * node
+	, unsigned char * key
+	, size_t key_len
+) {
+	MS_UNUSED(key_len);
+	return (strcmp(MS_CONTAINER_OF(node, t_fruit, dict)->name, MS_CAST(char *, key)));
+}
+
+static int f_sorted_itree(
+	  t_itree_rb * node
+	, void ** content
+) {
+	const char * name;
+
+	name = MS_CONTAINER_OF(node, t_fruit, tree)->name;
+	if (MS_ADDRCK(*content) && strcmp(MS_CAST(char *, *content), name) > 0) {
+		return (1);
+	}
+	*content = MS_CAST(void *, name);
+	return (0);
+}
+
+int unit_intrusive(void)
+{
+	size_t          i;
+	void          * tmp;
+	t_ilist         list;
+	t_ilist       * node;
+	t_idict       * dict;
+	t_fruit         fruits[16];
+	t_itree_rb_root tree;
+
+	dict = NULL;
+	if (0 != idict_init(&dict, 2, &hash_fnv_onea)) {
+		printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	ilist_init(&list);
+	itree_rb_init(&tree);
+	i = 0;
+	while (i < size) {
+		fruits[i].name = str[(i * 5) % size];
+		ilist_push_back(&list, &fruits[i].list);
+		itree_rb_insert(&tree, &fruits[i].tree, &f_compare_itree);
+		idict_insert(
+			  dict
+			, &fruits[i].dict
+			, MS_CAST(unsigned char *, fruits[i].name)
+			, strlen(fruits[i].name)
+		);
+		++i;
+	}
+	if (size != ilist_size(&list) || size != itree_rb_size(&tree) || size != idict_size(dict)) {
+		printf("\n%s: %d - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	ilist_remove(&fruits[3].list);
+	itree_rb_remove(&tree, &fruits[3].tree);
+	idict_remove(dict, &fruits[3].dict);
+	i = 0;
+	node = ilist_front(&list);
+	while (i < size) {
+		if (3 != i) {
+			if (node != &fruits[i].list) {
+				printf("\n%s: %d => %zu - ", __FILE__, __LINE__, i);
+				return (FAILURE);
+			}
+			node = node->next;
+		}
+		tmp = idict_search(
+			  dict
+			, MS_CAST(unsigned char *, fruits[i].name)
+			, strlen(fruits[i].name)
+			, &f_compare_idict
+		);
+		if ((3 == i) != MS_ADDRNULL(tmp) || (3 != i && tmp != &fruits[i].dict)) {
+			printf("\n%s: %d => %s - ", __FILE__, __LINE__, fruits[i].name);
+			return (FAILURE);
+		}
+		++i;
+	}
+	tmp = NULL;
+	if (0 != itree_rb_in_order(&tree, &tmp, &f_sorted_itree) || size - 1 != itree_rb_size(&tree)) {
+		printf("\n%s: %d - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	if (MS_CONTAINER_OF(itree_rb_first(&tree), t_fruit, tree)->name != str[1]) {
+		printf("\n%s: %d - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	idict_destroy(dict, NULL);
+	return (SUCCESS);
+}
+
+static size_t g_freed = 0;
+
+static void f_free_count(void * data)
+{
+	MS_UNUSED(data);
+	++g_freed;
+}
+
+static void * unit_cache_get(
+	  t_cache * cache
+	, size_t i
+	, int flag
+) {
+	return (cache_get(cache, MS_CAST(unsigned char *, str[i]), strlen(str[i]), flag));
+}
+
+static int unit_cache_policy(int policy)
+{
+	size_t          i;
+	t_cache       * cache;
+	t_cache_stats   stats;
+
+	cache = NULL;
+	if (0 != cache_init(&cache, policy, 4, 0, &hash_fnv_onea, &f_free_count)) {
+		printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	g_freed = 0;
+	i = 0;
+	while (i < 5) {
+		if (4 == i && str[0] != unit_cache_get(cache, 0, 0)) {
+			printf("\n%s: %d => %d - ", __FILE__, __LINE__, policy);
+			return (FAILURE);
+		}
+		cache_put(cache, MS_CAST(void *, str[i]), 0, MS_CAST(unsigned char *, str[i]), strlen(str[i]), 1);
+		++i;
+	}
+	if (
+		   4 != cache_size(cache)
+		|| 1 != g_freed
+		|| MS_ADDRCK(unit_cache_get(cache, 1, 0))
+		|| str[0] != unit_cache_get(cache, 0, 0)
+		|| str[4] != unit_cache_get(cache, 4, 0)
+	) {
+		printf("\n%s: %d => %d - ", __FILE__, __LINE__, policy);
+		return (FAILURE);
+	}
+	if (str[2] != unit_cache_get(cache, 2, MS_ELEMENT_REMOVE) || 3 != cache_size(cache) || 1 != g_freed) {
+		printf("\n%s: %d => %d - ", __FILE__, __LINE__, policy);
+		return (FAILURE);
+	}
+	cache_stats(cache, &stats);
+	if (4 != stats.hits || 1 != stats.misses || 1 != stats.evictions || 3 != stats.bytes) {
+		printf("\n%s: %d => %d - ", __FILE__, __LINE__, policy);
+		return (FAILURE);
+	}
+	cache_put(cache, MS_CAST(void *, str[0]), 0, MS_CAST(unsigned char *, str[0]), strlen(str[0]), 1);
+	if (1 != g_freed || str[0] != unit_cache_get(cache, 0, 0)) {
+		printf("\n%s: %d => %d - ", __FILE__, __LINE__, policy);
+		return (FAILURE);
+	}
+	cache_destroy(cache);
+	if (4 != g_freed) {
+		printf("\n%s: %d => %zu - ", __FILE__, __LINE__, g_freed);
+		return (FAILURE);
+	}
+	return (SUCCESS);
+}
+
+int unit_cache(void)
+{
+	size_t    i;
+	int       policy;
+	t_cache * cache;
+
+	policy = MS_CACHE_LRU;
+	while (policy <= MS_CACHE_S3FIFO) {
+		if (SUCCESS != unit_cache_policy(policy)) {
+			return (FAILURE);
+		}
+		++policy;
+	}
+	cache = NULL;
+	if (0 != cache_init(&cache, MS_CACHE_S3FIFO, 0, 10, &hash_fnv_onea, NULL)) {
+		printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	i = 0;
+	while (i < size) {
+		cache_put(cache, MS_CAST(void *, str[i]), 0, MS_CAST(unsigned char *, str[i]), strlen(str[i]), 4);
+		if (2 < cache_size(cache)) {
+			printf("\n%s: %d => %zu - ", __FILE__, __LINE__, cache_size(cache));
+			return (FAILURE);
+		}
+		++i;
+	}
+	if (0 == cache_put(cache, MS_CAST(void *, str[0]), 0, MS_CAST(unsigned char *, str[0]), strlen(str[0]), 11)) {
+		printf("\n%s: %d - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	cache_destroy(cache);
+	return (SUCCESS);
+}
+
+static int g_reader = 0;
+
+static void * unit_epoch_reader(void * arg)
+{
+	MS_UNUSED(arg);
+	epoch_enter();
+	MS_ATOMIC_STORE(&g_reader, 1);
+	while (1 == MS_ATOMIC_LOAD(&g_reader)) {
+		sched_yield();
+	}
+	epoch_exit();
+	return (NULL);
+}
+
+int unit_epoch(void)
+{
+	size_t      i;
+	pthread_t   tid;
+	t_content * content;
+
+	g_freed = 0;
+	if (
+		   0 != epoch_enter()
+		|| 0 != epoch_enter()
+	) {
+		printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	i = 0;
+	while (i < 3 * MS_EPOCH_BATCH) {
+		epoch_retire(&g_freed, &f_free_count);
+		++i;
+	}
+	epoch_exit();
+	if (0 != g_freed) {
+		printf("\n%s: %d => %zu - ", __FILE__, __LINE__, g_freed);
+		return (FAILURE);
+	}
+	epoch_exit();
+	epoch_synchronize();
+	if (
+		   3 * MS_EPOCH_BATCH != g_freed
+		|| 0 != epoch_pending()
+	) {
+		printf("\n%s: %d => %zu - ", __FILE__, __LINE__, g_freed);
+		return (FAILURE);
+	}
+	g_freed = 0;
+	pthread_create(&tid, NULL, &unit_epoch_reader, NULL);
+	while (0 == MS_ATOMIC_LOAD(&g_reader)) {
+		sched_yield();
+	}
+	content = content_init(&g_freed, 0);
+	if (0 != content_retire(content, &f_free_count)) {
+		printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	i = 0;
+	while (i < 3 * MS_EPOCH_BATCH) {
+		epoch_free(MS_ALLOC(sizeof(size_t)));
+		++i;
+	}
+	if (0 != g_freed) {
+		printf("\n%s: %d => %zu - ", __FILE__, __LINE__, g_freed);
+		return (FAILURE);
+	}
+	MS_ATOMIC_STORE(&g_reader, 0);
+	pthread_join(tid, NULL);
+	epoch_synchronize();
+	if (
+		   1 != g_freed
+		|| 0 != epoch_pending()
+	) {
+		printf("\n%s: %d => %zu - ", __FILE__, __LINE__, g_freed);
+		return (FAILURE);
+	}
+	return (SUCCESS);
+}
+
+static void * g_hazard = NULL;
+
+static void * unit_hazard_reader(void * arg)
+{
+	MS_UNUSED(arg);
+	if (g_hazard == hazard_protect(0, &g_hazard)) {
+		MS_ATOMIC_STORE(&g_reader, 1);
+	} else {
+		MS_ATOMIC_STORE(&g_reader, 2);
+	}
+	while (0 != MS_ATOMIC_LOAD(&g_reader)) {
+		sched_yield();
+	}
+	hazard_clear(0);
+	return (NULL);
+}
+
+int unit_hazard(void)
+{
+	size_t      i;
+	pthread_t   tid;
+	void      * data;
+
+	g_freed = 0;
+	g_hazard = MS_ALLOC(sizeof(size_t));
+	if (MS_ADDRNULL(g_hazard)) {
+		printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	pthread_create(&tid, NULL, &unit_hazard_reader, NULL);
+	while (0 == MS_ATOMIC_LOAD(&g_reader)) {
+		sched_yield();
+	}
+	if (1 != MS_ATOMIC_LOAD(&g_reader)) {
+		printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	data = g_hazard;
+	MS_ATOMIC_STORE(&g_hazard, NULL);
+	hazard_retire(data, &f_free_count);
+	i = 0;
+	while (i < 3 * MS_HAZARD_BATCH) {
+		hazard_free(MS_ALLOC(sizeof(size_t)));
+		if (MS_HAZARD_BATCH < hazard_pending()) {
+			printf("\n%s: %d => %zu - ", __FILE__, __LINE__, hazard_pending());
+			return (FAILURE);
+		}
+		++i;
+	}
+	if (0 != g_freed) {
+		printf("\n%s: %d => %zu - ", __FILE__, __LINE__, g_freed);
+		return (FAILURE);
+	}
+	MS_ATOMIC_STORE(&g_reader, 0);
+	pthread_join(tid, NULL);
+	hazard_collect();
+	if (
+		   1 != g_freed
+		|| 0 != hazard_pending()
+	) {
+		printf("\n%s: %d => %zu - ", __FILE__, __LINE__, g_freed);
+		return (FAILURE);
+	}
+	MS_DEALLOC(data);
+	return (SUCCESS);
+}
+
+static size_t g_pool_visits = 0;
+static char   g_pool_marks[4096];
+
+typedef struct s_pool_fib
+{
+	t_pool * pool;
+	size_t   n;
+	size_t   result;
+} t_pool_fib;
+
+static void unit_pool_range(
+	  size_t begin
+	, size_t end
+	, void * arg
+) {
+	MS_UNUSED(arg);
+	while (begin < end) {
+		++g_pool_marks[begin];
+		++begin;
+	}
+}
+
+static void unit_pool_fib(void * arg)
+{
+	t_pool_task  task;
+	t_pool_fib   left;
+	t_pool_fib   right;
+	t_pool_fib * fib;
+
+	fib = MS_CAST(t_pool_fib *, arg);
+	if (fib->n < 2) {
+		fib->result = fib->n;
+		return ;
+	}
+	left.pool = fib->pool;
+	left.n = fib->n - 1;
+	right.pool = fib->pool;
+	right.n = fib->n - 2;
+	pool_fork(fib->pool, &task, &unit_pool_fib, &left);
+	unit_pool_fib(&right);
+	pool_join(fib->pool, &task);
+	fib->result = left.result + right.result;
+}
+
+static int f_pool_count(void * data, void ** content)
+{
+	MS_UNUSED(data);
+	MS_ATOMIC_INC(MS_CAST(size_t *, content));
+	return (0);
+}
+
+static int f_pool_visit(void * data)
+{
+	MS_UNUSED(data);
+	MS_ATOMIC_INC(&g_pool_visits);
+	return (0);
+}
+
+static int f_pool_stop(void * data)
+{
+	return ((data == str[size / 2]) ? 2 : 0);
+}
+
+static void f_pool_free(void * data)
+{
+	MS_UNUSED(data);
+	MS_ATOMIC_INC(&g_pool_visits);
+}
+
+/*
+ * Sequential inserts leave the right spine deeper than the left one,
+ * on which the height of the parallel split is estimated
+*/
+static int unit_pool_skewed(
+	  t_tree_rb ** tree
+	, long * keys
+	, t_pool * pool
+	, int ascending
+) {
+	size_t i;
+
+	i = 0;
+	while (i < 1000) {
+		keys[i] = ascending ? MS_CAST(long, i) : MS_CAST(long, (999 - i));
+		if (0 != tree_rb_insert(tree, &keys[i], 0, &f_compare_long)) {
+			return (1);
+		}
+		++i;
+	}
+	g_pool_visits = 0;
+	tree_rb_destroy_parallel(tree, &f_pool_free, pool, 16);
+	return (1000 != g_pool_visits || MS_ADDRCK(*tree));
+}
+
+int unit_pool(void)
+{
+	size_t       i;
+	size_t       count;
+	long         keys[1000];
+	void       * elems[1000];
+	t_pool     * pool;
+	t_pool_fib   fib;
+	t_dict     * dict;
+	t_list_s   * list;
+	t_tree_rb  * tree;
+	t_tree_fz  * frozen;
+
+	if (0 != pool_init(&pool, 3)) {
+		printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	pool_parallel_for(pool, 0, sizeof(g_pool_marks), 16, &unit_pool_range, NULL);
+	i = 0;
+	while (i < sizeof(g_pool_marks)) {
+		if (1 != g_pool_marks[i]) {
+			printf("\n%s: %d => %zu - ", __FILE__, __LINE__, i);
+			return (FAILURE);
+		}
+		++i;
+	}
+	fib.pool = pool;
+	fib.n = 20;
+	unit_pool_fib(&fib);
+	if (6765 != fib.result) {
+		printf("\n%s: %d => %zu - ", __FILE__, __LINE__, fib.result);
+		return (FAILURE);
+	}
+	dict = NULL;
+	list = NULL;
+	tree = NULL;
+	if (0 != dict_init(&dict, size, &hash_fnv_onea)) {
+		printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	i = 0;
+	while (i < size) {
+		if (
+			   0 != dict_insert(dict, MS_CAST(void *, str[i]), 0, MS_CAST(unsigned char *, str[i]), strlen(str[i]))
+			|| 0 != list_s_push_back(&list, MS_CAST(void *, str[i]), 0)
+			|| 0 != tree_rb_insert(&tree, MS_CAST(void *, str[i]), 0, &f_compare_2)
+		) {
+			printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+			return (FAILURE);
+		}
+		++i;
+	}
+	count = 0;
+	if (
+		   0 != dict_foreach_parallel(dict, MS_CAST(void **, &count), &f_pool_count, pool, 1)
+		|| size != count
+		|| 0 != list_s_fct_parallel(&list, &f_pool_visit, pool, 2)
+		|| size != g_pool_visits
+		|| 2 != list_s_fct_parallel(&list, &f_pool_stop, pool, 1)
+	) {
+		printf("\n%s: %d => %zu %zu - ", __FILE__, __LINE__, count, g_pool_visits);
+		return (FAILURE);
+	}
+	g_pool_visits = 0;
+	dict_destroy_parallel(dict, &f_pool_free, pool, 1);
+	tree_rb_destroy_parallel(&tree, &f_pool_free, pool, 1);
+	if (
+		   2 * size != g_pool_visits
+		|| MS_ADDRCK(tree)
+	) {
+		printf("\n%s: %d => %zu - ", __FILE__, __LINE__, g_pool_visits);
+		return (FAILURE);
+	}
+	list_s_destroy(&list, NULL);
+	if (
+		   0 != unit_pool_skewed(&tree, keys, pool, 0)
+		|| 0 != unit_pool_skewed(&tree, keys, NULL, 1)
+	) {
+		printf("\n%s: %d => %zu - ", __FILE__, __LINE__, g_pool_visits);
+		return (FAILURE);
+	}
+	i = 0;
+	while (i < 1000) {
+		keys[i] = MS_CAST(long, 3 * i);
+		elems[i] = &keys[i];
+		++i;
+	}
+	if (0 != tree_fz_init_parallel(&frozen, elems, 1000, &f_key_long, pool, 8)) {
+		printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	i = 0;
+	while (i < 1000) {
+		if (&keys[i] != tree_fz_search_key(frozen, keys[i])) {
+			printf("\n%s: %d => %zu - ", __FILE__, __LINE__, i);
+			return (FAILURE);
+		}
+		++i;
+	}
+	tree_fz_destroy(frozen, NULL);
+	pool_destroy(pool);
+	return (SUCCESS);
+}
+
+typedef struct s_rb_span
+{
+	long   first;
+	long   last;
+	size_t count;
+	int    sorted;
+} t_rb_span;
+
+static void f_span_map(void * partial, void * data)
+{
+	t_rb_span * span;
+
+	span = MS_CAST(t_rb_span *, partial);
+	if (0 == span->count) {
+		span->first = *MS_CAST(long *, data);
+	} else if (span->last >= *MS_CAST(long *, data)) {
+		span->sorted = 0;
+	}
+	span->last = *MS_CAST(long *, data);
+	++span->count;
+}
+
+static void f_span_combine(void * partial, const void * other)
+{
+	t_rb_span       * span;
+	const t_rb_span * next;
+
+	span = MS_CAST(t_rb_span *, partial);
+	next = MS_CAST(const t_rb_span *, other);
+	if (0 == next->count) {
+		return ;
+	}
+	if (0 == span->count) {
+		*span = *next;
+		return ;
+	}
+	if (
+		   span->last >= next->first
+		|| 0 == next->sorted
+	) {
+		span->sorted = 0;
+	}
+	span->last = next->last;
+	span->count += next->count;
+}
+
+static int f_span_stop(void * data, void ** content)
+{
+	MS_UNUSED(content);
+	return ((500 == *MS_CAST(long *, data)) ? 3 : 0);
+}
+
+int unit_tree_rb_parallel(void)
+{
+	size_t      i;
+	size_t      count;
+	long        keys[1000];
+	t_pool    * pool;
+	t_rb_span   span;
+	t_tree_rb * tree;
+
+	if (0 != pool_init(&pool, 3)) {
+		printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	tree = NULL;
+	i = 0;
+	while (i < 1000) {
+		keys[i] = MS_CAST(long, (i * 7919) % 1000);
+		if (0 != tree_rb_insert(&tree, &keys[i], 0, &f_compare_long)) {
+			printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+			return (FAILURE);
+		}
+		++i;
+	}
+	count = 0;
+	if (
+		   0 != tree_rb_in_order_parallel(&tree, MS_CAST(void **, &count), &f_pool_count, pool, 4)
+		|| 1000 != count
+		|| 3 != tree_rb_in_order_parallel(&tree, NULL, &f_span_stop, pool, 4)
+	) {
+		printf("\n%s: %d => %zu - ", __FILE__, __LINE__, count);
+		return (FAILURE);
+	}
+	MS_MEMSET(&span, 0, sizeof(t_rb_span));
+	span.sorted = 1;
+	if (
+		   0 != tree_rb_reduce_parallel(&tree, &span, sizeof(t_rb_span), &f_span_map, &f_span_combine, pool, 4)
+		|| 1000 != span.count
+		|| 1 != span.sorted
+		|| 0 != span.first
+		|| 999 != span.last
+	) {
+		printf("\n%s: %d => %zu %d - ", __FILE__, __LINE__, span.count, span.sorted);
+		return (FAILURE);
+	}
+	tree_rb_destroy_parallel(&tree, NULL, pool, 4);
+	pool_destroy(pool);
+	return (SUCCESS);
+}
+
+static long * g_sort_prev = NULL;
+static size_t g_sort_count = 0;
+
+/*
+ * Equal keys stay in the order of their address
+*/
+static int f_sort_stable(void * data)
+{
+	long * key;
+
+	key = MS_CAST(long *, data);
+	if (
+		   MS_ADDRCK(g_sort_prev)
+		&& (
+			   *g_sort_prev > *key
+			|| (
+				   *g_sort_prev == *key
+				&& g_sort_prev > key
+			)
+		)
+	) {
+		return (1);
+	}
+	g_sort_prev = key;
+	++g_sort_count;
+	return (0);
+}
+
+static int unit_list_sorted(int ret)
+{
+	g_sort_prev = NULL;
+	g_sort_count = 0;
+	return (ret);
+}
+
+int unit_list_sort(void)
+{
+	size_t     i;
+	long       keys[1000];
+	long       desc[1000];
+	t_pool   * pool;
+	t_list_s * list_s;
+	t_list_d * list_d;
+	t_list_c * list_c;
+
+	list_s = NULL;
+	list_d = NULL;
+	list_c = NULL;
+	i = 1000;
+	while (0 != i) {
+		--i;
+		keys[i] = MS_CAST(long, (i * 7919) % 100);
+		desc[i] = MS_CAST(long, 1000 - i);
+		if (
+			   0 != list_s_push_front(&list_s, &keys[i], 0)
+			|| 0 != list_d_push_front(&list_d, &keys[i], 0)
+			|| 0 != list_c_push(&list_c, &keys[i], 0)
+		) {
+			printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+			return (FAILURE);
+		}
+	}
+	if (0 != pool_init(&pool, 3)) {
+		printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	if (
+		   0 != list_s_sort(&list_s, &f_compare_long, 0)
+		|| 0 != unit_list_sorted(list_s_fct(&list_s, &f_sort_stable))
+		|| 0 != list_s_sort(&list_s, &f_compare_long, MS_SORT_NATURAL)
+		|| 0 != list_s_fct(&list_s, &f_sort_stable)
+		|| 1000 != g_sort_count
+		|| 0 != unit_list_sorted(list_d_sort_parallel(&list_d, &f_compare_long, 0, pool, 16))
+		|| 0 != list_d_fct(&list_d, &f_sort_stable)
+		|| 1000 != g_sort_count
+		|| 99 != *MS_CAST(long *, list_d_last_element(&list_d, MS_ELEMENT_REMOVE))
+		|| 0 != unit_list_sorted(list_c_sort(&list_c, &f_compare_long, MS_SORT_NATURAL))
+		|| 0 != list_c_fct(&list_c, &f_sort_stable)
+		|| 1000 != g_sort_count
+		|| 99 != *MS_CAST(long *, list_c_nth_element(&list_c, 999, 0))
+	) {
+		printf("\n%s: %d => %zu - ", __FILE__, __LINE__, g_sort_count);
+		return (FAILURE);
+	}
+	list_s_destroy(&list_s, NULL);
+	list_c_destroy(&list_c, NULL);
+	i = 0;
+	while (i < 1000) {
+		if (
+			   0 != list_s_push_front(&list_s, &desc[i], 0)
+			|| 0 != list_c_push(&list_c, &desc[i], 0)
+		) {
+			printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+			return (FAILURE);
+		}
+		++i;
+	}
+	if (
+		   0 != unit_list_sorted(list_s_sort_parallel(&list_s, &f_compare_long, MS_SORT_NATURAL, pool, 64))
+		|| 0 != list_s_fct(&list_s, &f_sort_stable)
+		|| 1000 != g_sort_count
+		|| 0 != unit_list_sorted(list_c_sort_parallel(&list_c, &f_compare_long, 0, pool, 64))
+		|| 0 != list_c_fct(&list_c, &f_sort_stable)
+		|| 1000 != g_sort_count
+	) {
+		printf("\n%s: %d => %zu - ", __FILE__, __LINE__, g_sort_count);
+		return (FAILURE);
+	}
+	list_s_destroy(&list_s, NULL);
+	list_d_destroy(&list_d, NULL);
+	list_c_destroy(&list_c, NULL);
+	pool_destroy(pool);
+	return (SUCCESS);
+}
+
+static int unit_heap_drain(
+	  t_heap * heap
+	, size_t count
+) {
+	size_t   i;
+	long   * prev;
+	long   * data;
+
+	prev = NULL;
+	i = 0;
+	while (i < count) {
+		data = MS_CAST(long *, heap_pop(heap));
+		if (
+			   MS_ADDRNULL(data)
+			|| (
+				   MS_ADDRCK(prev)
+				&& *prev > *data
+			)
+		) {
+			return (1);
+		}
+		prev = data;
+		++i;
+	}
+	return (MS_ADDRCK(heap_pop(heap)));
+}
+
+int unit_heap(void)
+{
+	size_t   i;
+	long     keys[1000];
+	void   * elems[1000];
+	t_heap * heap;
+
+	if (0 != heap_init(&heap, 0, &f_compare_long)) {
+		printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	i = 0;
+	while (i < 1000) {
+		keys[i] = MS_CAST(long, (i * 7919) % 1000);
+		elems[i] = &keys[i];
+		if (0 != heap_push(heap, &keys[i], 0)) {
+			printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+			return (FAILURE);
+		}
+		++i;
+	}
+	if (
+		   1000 != heap_size(heap)
+		|| 0 != *MS_CAST(long *, heap_peek(heap))
+		|| 0 != unit_heap_drain(heap, 1000)
+		|| 0 != heap_push_batch(heap, elems, 1000)
+		|| 0 != unit_heap_drain(heap, 1000)
+		|| 0 != heap_push_batch(heap, elems, 990)
+		|| 0 != heap_push_batch(heap, elems + 990, 10)
+		|| 0 != unit_heap_drain(heap, 1000)
+		|| MS_ADDRCK(heap_peek(heap))
+	) {
+		printf("\n%s: %d => %zu - ", __FILE__, __LINE__, heap_size(heap));
+		return (FAILURE);
+	}
+	i = 0;
+	while (i < 10) {
+		if (0 != heap_push(heap, &keys[i], sizeof(long))) {
+			printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+			return (FAILURE);
+		}
+		++i;
+	}
+	heap_destroy(heap, &free);
+	return (SUCCESS);
+}
+
+/*
+ * The distance first, so that f_compare_long orders the vertices
+*/
+typedef struct s_pa_vertex
+{
+	long             dist;
+	t_heap_pa_node * node;
+} t_pa_vertex;
+
+static long unit_heap_pa_weight(
+	  size_t from
+	, size_t to
+) {
+	return (MS_CAST(long, (from * 31 + to * 17) % 23) + 1);
+}
+
+/*
+ * Dijkstra on 100 vertices, each linked to the 5 next ones,
+ * checked against Bellman-Ford
+*/
+static int unit_heap_pa_dijkstra(t_heap_pa * heap)
+{
+	size_t        i;
+	size_t        j;
+	size_t        to;
+	long          dist;
+	long          ref[100];
+	t_pa_vertex   vertex[100];
+	t_pa_vertex * closest;
+
+	i = 0;
+	while (i < 100) {
+		vertex[i].dist = (0 == i) ? 0 : LONG_MAX;
+		ref[i] = vertex[i].dist;
+		if (0 != heap_pa_push(heap, &vertex[i], 0, &vertex[i].node)) {
+			return (1);
+		}
+		++i;
+	}
+	while (0 != heap_pa_size(heap)) {
+		closest = MS_CAST(t_pa_vertex *, heap_pa_pop(heap));
+		closest->node = NULL;
+		i = MS_CAST(size_t, (closest - vertex));
+		j = 1;
+		while (j <= 5) {
+			to = (i + j) % 100;
+			dist = closest->dist + unit_heap_pa_weight(i, to);
+			if (
+				   MS_ADDRCK(vertex[to].node)
+				&& dist < vertex[to].dist
+			) {
+				vertex[to].dist = dist;
+				if (0 != heap_pa_decrease(heap, vertex[to].node, &vertex[to])) {
+					return (1);
+				}
+			}
+			++j;
+		}
+	}
+	j = 0;
+	while (j < 100) {
+		i = 0;
+		while (i < 100 * 5) {
+			to = (i / 5 + i % 5 + 1) % 100;
+			if (
+				   LONG_MAX != ref[i / 5]
+				&& ref[i / 5] + unit_heap_pa_weight(i / 5, to) < ref[to]
+			) {
+				ref[to] = ref[i / 5] + unit_heap_pa_weight(i / 5, to);
+			}
+			++i;
+		}
+		++j;
+	}
+	i = 0;
+	while (i < 100) {
+		if (ref[i] != vertex[i].dist) {
+			return (1);
+		}
+		++i;
+	}
+	return (0);
+}
+
+int unit_heap_pa(void)
+{
+	size_t           i;
+	long             keys[100];
+	long           * data;
+	long           * prev;
+	t_heap_pa      * heap;
+	t_heap_pa      * other;
+	t_heap_pa_node * nodes[100];
+
+	if (
+		   0 != heap_pa_init(&heap, &f_compare_long)
+		|| 0 != heap_pa_init(&other, &f_compare_long)
+	) {
+		printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	if (0 != unit_heap_pa_dijkstra(heap)) {
+		printf("\n%s: %d => DIJKSTRA - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	i = 0;
+	while (i < 100) {
+		keys[i] = MS_CAST(long, (i * 37) % 100);
+		if (0 != heap_pa_push((0 == i % 2) ? heap : other, &keys[i], 0, &nodes[i])) {
+			printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+			return (FAILURE);
+		}
+		++i;
+	}
+	if (
+		   0 == heap_pa_meld(heap, heap)
+		|| 0 != heap_pa_meld(heap, other)
+		|| 100 != heap_pa_size(heap)
+		|| 0 != *MS_CAST(long *, heap_pa_peek(heap))
+		|| &keys[3] != heap_pa_remove(heap, nodes[3])
+		|| &keys[10] != heap_pa_remove(heap, nodes[10])
+		|| &keys[0] != heap_pa_data(nodes[0])
+	) {
+		printf("\n%s: %d => MELD - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	keys[99] = -1;
+	heap_pa_decrease(heap, nodes[99], &keys[99]);
+	prev = NULL;
+	i = 0;
+	while (0 != heap_pa_size(heap)) {
+		data = MS_CAST(long *, heap_pa_pop(heap));
+		if (
+			   (MS_ADDRNULL(prev) && -1 != *data)
+			|| (MS_ADDRCK(prev) && *prev > *data)
+			|| &keys[3] == data
+			|| &keys[10] == data
+		) {
+			printf("\n%s: %d => %ld - ", __FILE__, __LINE__, *data);
+			return (FAILURE);
+		}
+		prev = data;
+		++i;
+	}
+	if (
+		   98 != i
+		|| MS_ADDRCK(heap_pa_pop(heap))
+	) {
+		printf("\n%s: %d => %zu - ", __FILE__, __LINE__, i);
+		return (FAILURE);
+	}
+	i = 0;
+	while (i < 300) {
+		if (0 != heap_pa_push(heap, &keys[i % 100], sizeof(long), NULL)) {
+			printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+			return (FAILURE);
+		}
+		++i;
+	}
+	free(heap_pa_pop(heap));
+	heap_pa_destroy(heap, &free);
+	return (SUCCESS);
+}
+
+typedef struct s_timer_conn
+{
+	t_timer timer;
+	size_t  fired;
+} t_timer_conn;
+
+typedef struct s_timer_batch
+{
+	t_timer_wheel * wheel;
+	size_t          now;
+	size_t          prev;
+	size_t          count;
+	int             ret;
+} t_timer_batch;
+
+/*
+ * Checks the batch is in order of expiry, and arms again the timers
+ * expiring at a multiple of 1000, 5000 ticks later
+*/
+static void f_timer_expire(
+	  t_ilist * expired
+	, void * arg
+) {
+	t_ilist       * node;
+	t_timer_conn  * conn;
+	t_timer_batch * batch;
+
+	batch = MS_CAST(t_timer_batch *, arg);
+	node = ilist_pop_front(expired);
+	while (MS_ADDRCK(node)) {
+		conn = MS_CONTAINER_OF(node, t_timer_conn, timer.list);
+		if (
+			   conn->timer.expires > batch->now
+			|| conn->timer.expires < batch->prev
+			|| timer_is_armed(&conn->timer)
+		) {
+			batch->ret = 1;
+		}
+		batch->prev = conn->timer.expires;
+		++conn->fired;
+		++batch->count;
+		if (0 == conn->timer.expires % 1000) {
+			timer_wheel_arm(batch->wheel, &conn->timer, conn->timer.expires + 5000);
+		}
+		node = ilist_pop_front(expired);
+	}
+}
+
+int unit_timer(void)
+{
+	size_t        i;
+	size_t        now;
+	t_timer_conn  conns[300];
+	t_timer_batch batch;
+
+	MS_MEMSET(&batch, 0, sizeof(t_timer_batch));
+	if (0 != timer_wheel_init(&batch.wheel, 100)) {
+		printf("\n%s: %d => MALLOC - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	i = 0;
+	while (i < 300) {
+		timer_init(&conns[i].timer);
+		conns[i].fired = 0;
+		timer_wheel_arm(batch.wheel, &conns[i].timer, 100 + (i * i * 37) % 300000);
+		++i;
+	}
+	timer_wheel_arm(batch.wheel, &conns[0].timer, MS_CAST(size_t, 1) << 31);
+	timer_wheel_arm(batch.wheel, &conns[1].timer, 50);
+	i = 2;
+	while (i < 300) {
+		if (0 != timer_wheel_cancel(batch.wheel, &conns[i].timer)) {
+			printf("\n%s: %d => CANCEL %zu - ", __FILE__, __LINE__, i);
+			return (FAILURE);
+		}
+		i += 5;
+	}
+	if (
+		   0 == timer_wheel_cancel(batch.wheel, &conns[2].timer)
+		|| 240 != timer_wheel_size(batch.wheel)
+		|| 1 != timer_wheel_advance(batch.wheel, 101, NULL, NULL)
+		|| timer_is_armed(&conns[1].timer)
+	) {
+		printf("\n%s: %d => %zu - ", __FILE__, __LINE__, timer_wheel_size(batch.wheel));
+		return (FAILURE);
+	}
+	now = 101;
+	while (now < 400000) {
+		now += 1 + (now * 7) % 997;
+		batch.now = now;
+		timer_wheel_advance(batch.wheel, now, &f_timer_expire, &batch);
+	}
+	batch.now = MS_CAST(size_t, 1) << 31;
+	if (
+		   0 != batch.ret
+		|| 1 != timer_wheel_advance(batch.wheel, batch.now, &f_timer_expire, &batch)
+		|| 1 != conns[0].fired
+		|| 0 != timer_wheel_size(batch.wheel)
+		|| batch.now != timer_wheel_now(batch.wheel)
+	) {
+		printf("\n%s: %d => %zu - ", __FILE__, __LINE__, batch.count);
+		return (FAILURE);
+	}
+	i = 2;
+	while (i < 300) {
+		if (
+			   (2 == i % 5 && 0 != conns[i].fired)
+			|| (2 != i % 5 && (0 == conns[i].fired || conns[i].fired > 2))
+		) {
+			printf("\n%s: %d => %zu - ", __FILE__, __LINE__, i);
+			return (FAILURE);
+		}
+		++i;
+	}
+	timer_wheel_arm(batch.wheel, &conns[2].timer, batch.now + 10);
+	timer_wheel_destroy(batch.wheel);
+	if (timer_is_armed(&conns[2].timer)) {
+		printf("\n%s: %d => ARMED - ", __FILE__, __LINE__);
+		return (FAILURE);
+	}
+	return (SUCCESS);
+}
+
+int main(void)
+{
+	printf("TEST: Singly-linked list: ");
+	if (SUCCESS == unit_list_singly()) {
+		printf("SUCESS\n");
+	} else {
+		printf("FAILURE\n");
+	}
+	printf("TEST: Doubly-linked list: ");
+	if (SUCCESS == unit_list_doubly()) {
+		printf("SUCESS\n");
+	} else {
+		printf("FAILURE\n");
+	}
+	printf("TEST: Circular Linked list: ");
+	if (SUCCESS == unit_list_circular()) {
+		printf("SUCESS\n");
+	} else {
+		printf("FAILURE\n");
+	}
+	printf("TEST: Stack: ");
+	if (SUCCESS == unit_stack()) {
+		printf("SUCESS\n");
+	} else {
+		printf("FAILURE\n");
+	}
+	printf("TEST: Queue: ");
+	if (SUCCESS == unit_queue()) {
+		printf("SUCESS\n");
+	} else {
+		printf("FAILURE\n");
+	}
+	printf("TEST: Blocking Queue: ");
+	if (SUCCESS == unit_queue_blocking()) {
+		printf("SUCESS\n");
+	} else {
+		printf("FAILURE\n");
+	}
+	printf("TEST: Channel: ");
+	if (SUCCESS == unit_channel()) {
+		printf("SUCESS\n");
+	} else {
+		printf("FAILURE\n");
 	}
 	printf("TEST: Dictionary: ");
 	if (SUCCESS == unit_dictionary()) {
@@ -583,6 +3125,24 @@ int main(void)
 	} else {
 		printf("FAILURE\n");
 	}
+	printf("TEST: Sharded Dictionary: ");
+	if (SUCCESS == unit_dictionary_sharded()) {
+		printf("SUCESS\n");
+	} else {
+		printf("FAILURE\n");
+	}
+	printf("TEST: Lock-free Dictionary: ");
+	if (SUCCESS == unit_dictionary_lockfree()) {
+		printf("SUCESS\n");
+	} else {
+		printf("FAILURE\n");
+	}
+	printf("TEST: Typed Dictionary: ");
+	if (SUCCESS == unit_dictionary_typed()) {
+		printf("SUCESS\n");
+	} else {
+		printf("FAILURE\n");
+	}
 	printf("TEST: Tree: ");
 	if (SUCCESS == unit_tree()) {
 		printf("SUCESS\n");
@@ -595,5 +3155,101 @@ int main(void)
 	} else {
 		printf("FAILURE\n");
 	}
+	printf("TEST: Typed Red Black Tree: ");
+	if (SUCCESS == unit_tree_rb_typed()) {
+		printf("SUCESS\n");
+	} else {
+		printf("FAILURE\n");
+	}
+	printf("TEST: Persistent Red Black Tree: ");
+	if (SUCCESS == unit_tree_prb()) {
+		printf("SUCESS\n");
+	} else {
+		printf("FAILURE\n");
+	}
+	printf("TEST: Frozen Tree: ");
+	if (SUCCESS == unit_tree_fz()) {
+		printf("SUCESS\n");
+	} else {
+		printf("FAILURE\n");
+	}
+	printf("TEST: Adaptive Radix Tree: ");
+	if (SUCCESS == unit_tree_art()) {
+		printf("SUCESS\n");
+	} else {
+		printf("FAILURE\n");
+	}
+	printf("TEST: Skip List: ");
+	if (SUCCESS == unit_tree_sl()) {
+		printf("SUCESS\n");
+	} else {
+		printf("FAILURE\n");
+	}
+	printf("TEST: Flat Combining: ");
+	if (SUCCESS == unit_combining()) {
+		printf("SUCESS\n");
+	} else {
+		printf("FAILURE\n");
+	}
+	printf("TEST: Intrusive: ");
+	if (SUCCESS == unit_intrusive()) {
+		printf("SUCESS\n");
+	} else {
+		printf("FAILURE\n");
+	}
+	printf("TEST: Cache: ");
+	if (SUCCESS == unit_cache()) {
+		printf("SUCESS\n");
+	} else {
+		printf("FAILURE\n");
+	}
+	printf("TEST: Epoch: ");
+	if (SUCCESS == unit_epoch()) {
+		printf("SUCESS\n");
+	} else {
+		printf("FAILURE\n");
+	}
+	printf("TEST: Hazard: ");
+	if (SUCCESS == unit_hazard()) {
+		printf("SUCESS\n");
+	} else {
+		printf("FAILURE\n");
+	}
+	printf("TEST: Pool: ");
+	if (SUCCESS == unit_pool()) {
+		printf("SUCESS\n");
+	} else {
+		printf("FAILURE\n");
+	}
+	printf("TEST: Parallel Red Black Tree: ");
+	if (SUCCESS == unit_tree_rb_parallel()) {
+		printf("SUCESS\n");
+	} else {
+		printf("FAILURE\n");
+	}
+	printf("TEST: List Sort: ");
+	if (SUCCESS == unit_list_sort()) {
+		printf("SUCESS\n");
+	} else {
+		printf("FAILURE\n");
+	}
+	printf("TEST: Heap: ");
+	if (SUCCESS == unit_heap()) {
+		printf("SUCESS\n");
+	} else {
+		printf("FAILURE\n");
+	}
+	printf("TEST: Pairing Heap: ");
+	if (SUCCESS == unit_heap_pa()) {
+		printf("SUCESS\n");
+	} else {
+		printf("FAILURE\n");
+	}
+	printf("TEST: Timer Wheel: ");
+	if (SUCCESS == unit_timer()) {
+		printf("SUCESS\n");
+	} else {
+		printf("FAILURE\n");
+	}
 	return (0);
 }
\ No newline at end of file
@@ -0,0 +1,498 @@
+# include <ms_cache.h>
+# include <ms_dict_typed.h>
+# include <ms_intrusive_dict.h>
+# include <ms_list/ms_intrusive_linked.h>
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+/*
+ * Number of recently evicted keys remembered by S3-FIFO
+ * when the cache is only bounded in bytes
+*/
+# define CACHE_GHOST          1024
+
+/*
+ * Maximum frequency counted by S3-FIFO
+*/
+# define CACHE_FREQ           3
+
+/*
+ * Hash of the key -> number of times it is in the ghost FIFO
+*/
+MS_DICT_DECLARE(ghost, size_t, size_t, hash_int, MS_DICT_EQ)
+
+typedef struct s_cache_queue
+{
+	t_ilist         list;
+	size_t          count;
+	size_t          bytes;
+} t_cache_queue;
+
+/*
+ * The key is copied at the end of the entry, in the same allocation.
+ * Queue 0 is the LRU list, the CLOCK ring, the SLRU probation segment
+ * or the S3-FIFO small FIFO, queue 1 the protected segment or main FIFO
+*/
+typedef struct s_cache_entry
+{
+	t_idict_node    dict;
+	t_ilist         list;
+	void          * data;
+	size_t          bytes;
+	size_t          key_len;
+	unsigned char   queue;
+	unsigned char   freq;
+	unsigned char   key[];
+} t_cache_entry;
+
+struct s_cache
+{
+	int             policy;
+	size_t          max_entries;
+	size_t          max_bytes;
+	size_t          bytes;
+	t_idict       * dict;
+	t_cache_queue   queue[2];
+	t_cache_stats   stats;
+	size_t        * ghost;
+	size_t          ghost_size;
+	size_t          ghost_next;
+	t_dict_ghost  * ghosts;
+	void            (*f_free)(void * data);
+};
+
+/*--------------------------------- PRIVATE METHODS ---------------------------------*/
+
+static
+int __cache_compare(
+	  t_idict_node * node
+	, unsigned char * key
+	, size_t key_len
+) {
+	t_cache_entry * entry;
+
+	entry = MS_CONTAINER_OF(node, t_cache_entry, dict);
+	if (entry->key_len != key_len) {
+		return (1);
+	}
+	return (MS_MEMCMP(entry->key, key, key_len));
+}
+
+static inline
+t_cache_entry * __cache_find(
+	  t_cache * cache
+	, unsigned char * key
+	, size_t key_len
+) {
+	t_idict_node * node;
+
+	node = idict_search(cache->dict, key, key_len, &__cache_compare);
+	if (MS_ADDRCK(node)) {
+		return (MS_CONTAINER_OF(node, t_cache_entry, dict));
+	}
+	return (NULL);
+}
+
+/*
+ * True if `count` entries or `bytes` exceed `ratio` tenths of the capacity
+*/
+static inline
+int __cache_over(
+	  const t_cache * cache
+	, size_t count
+	, size_t bytes
+	, size_t ratio
+) {
+	if (
+		   (0 != cache->max_entries && count * 10 > cache->max_entries * ratio)
+		|| (0 != cache->max_bytes && bytes * 10 > cache->max_bytes * ratio)
+	) {
+		return (1);
+	}
+	return (0);
+}
+
+static inline
+void __cache_push(
+	  t_cache * cache
+	, t_cache_entry * entry
+	, unsigned char queue
+) {
+	entry->queue = queue;
+	ilist_push_front(&cache->queue[queue].list, &entry->list);
+	++cache->queue[queue].count;
+	cache->queue[queue].bytes += entry->bytes;
+}
+
+static inline
+void __cache_pull(
+	  t_cache * cache
+	, t_cache_entry * entry
+) {
+	ilist_remove(&entry->list);
+	--cache->queue[entry->queue].count;
+	cache->queue[entry->queue].bytes -= entry->bytes;
+}
+
+static inline
+void __cache_move(
+	  t_cache * cache
+	, t_cache_entry * entry
+	, unsigned char queue
+) {
+	__cache_pull(cache, entry);
+	__cache_push(cache, entry, queue);
+}
+
+static inline
+t_cache_entry * __cache_back(
+	  t_cache * cache
+	, unsigned char queue
+) {
+	return (MS_CONTAINER_OF(ilist_back(&cache->queue[queue].list), t_cache_entry, list));
+}
+
+static inline
+void __cache_drop(
+	  t_cache * cache
+	, t_cache_entry * entry
+	, void (*f_free)(void * data)
+) {
+	__cache_pull(cache, entry);
+	idict_remove(cache->dict, &entry->dict);
+	cache->bytes -= entry->bytes;
+	if (MS_ADDRCK(f_free)) {
+		f_free(entry->data);
+	}
+	MS_DEALLOC(entry);
+}
+
+static inline
+void __cache_ghost_add(
+	  t_cache * cache
+	, size_t hash
+) {
+	size_t * count;
+
+	if (MS_ADDRNULL(cache->ghosts)) {
+		return ;
+	}
+	if (dict_ghost_size(cache->ghosts) >= cache->ghost_size) {
+		count = dict_ghost_search(cache->ghosts, cache->ghost[cache->ghost_next]);
+		if (MS_ADDRCK(count) && 0 == --*count) {
+			dict_ghost_remove(cache->ghosts, cache->ghost[cache->ghost_next], NULL);
+		}
+	}
+	cache->ghost[cache->ghost_next] = hash;
+	cache->ghost_next = (cache->ghost_next + 1) % cache->ghost_size;
+	count = dict_ghost_search(cache->ghosts, hash);
+	if (MS_ADDRCK(count)) {
+		++*count;
+	} else {
+		dict_ghost_insert(cache->ghosts, hash, 1);
+	}
+}
+
+static inline
+void __cache_hit(
+	  t_cache * cache
+	, t_cache_entry * entry
+) {
+	t_cache_entry * demoted;
+
+	if (MS_CACHE_LRU == cache->policy) {
+		__cache_move(cache, entry, 0);
+	} else if (MS_CACHE_SLRU == cache->policy) {
+		__cache_move(cache, entry, 1);
+		while (
+			   cache->queue[1].count > 1
+			&& __cache_over(cache, cache->queue[1].count, cache->queue[1].bytes, 8)
+		) {
+			demoted = __cache_back(cache, 1);
+			__cache_move(cache, demoted, 0);
+		}
+	} else if (MS_CACHE_CLOCK == cache->policy) {
+		entry->freq = 1;
+	} else if (entry->freq < CACHE_FREQ) {
+		++entry->freq;
+	}
+}
+
+/*
+ * Entries given a second chance are moved to the front of a queue,
+ * with a decremented frequency, so the loop always ends
+*/
+static inline
+t_cache_entry * __cache_victim(t_cache * cache)
+{
+	t_cache_entry * entry;
+	t_cache_entry * victim;
+
+	if (MS_CACHE_LRU == cache->policy) {
+		return (__cache_back(cache, 0));
+	}
+	if (MS_CACHE_SLRU == cache->policy) {
+		if (0 != cache->queue[0].count) {
+			return (__cache_back(cache, 0));
+		}
+		return (__cache_back(cache, 1));
+	}
+	victim = NULL;
+	while (MS_ADDRNULL(victim)) {
+		if (
+			   0 != cache->queue[0].count
+			&& (
+				   0 == cache->queue[1].count
+				|| MS_CACHE_CLOCK == cache->policy
+				|| __cache_over(cache, cache->queue[0].count, cache->queue[0].bytes, 1)
+			)
+		) {
+			entry = __cache_back(cache, 0);
+			if (0 == entry->freq) {
+				if (MS_CACHE_S3FIFO == cache->policy) {
+					__cache_ghost_add(cache, entry->dict.hash);
+				}
+				victim = entry;
+			} else {
+				/* CLOCK: second chance, S3-FIFO: accessed again while in S */
+				entry->freq = 0;
+				__cache_move(cache, entry, (MS_CACHE_CLOCK == cache->policy) ? 0 : 1);
+			}
+		} else {
+			entry = __cache_back(cache, 1);
+			if (0 == entry->freq) {
+				victim = entry;
+			} else {
+				--entry->freq;
+				__cache_move(cache, entry, 1);
+			}
+		}
+	}
+	return (victim);
+}
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+int cache_init(
+	  t_cache ** cache
+	, int policy
+	, size_t max_entries
+	, size_t max_bytes
+	, size_t (*f_hash)(unsigned char * key, size_t key_len)
+	, void (*f_free)(void * data)
+) {
+	if (
+		   MS_ADDRNULL(cache)
+		|| policy < MS_CACHE_LRU
+		|| policy > MS_CACHE_S3FIFO
+		|| (0 == max_entries && 0 == max_bytes)
+	) {
+		return (1);
+	}
+	*cache = MS_CAST(t_cache *, MS_ALLOC(sizeof(t_cache)));
+	if (MS_ADDRNULL(*cache)) {
+		return (1);
+	}
+	MS_MEMSET(*cache, 0, sizeof(t_cache));
+	(*cache)->policy      = policy;
+	(*cache)->max_entries = max_entries;
+	(*cache)->max_bytes   = max_bytes;
+	(*cache)->f_free      = f_free;
+	ilist_init(&(*cache)->queue[0].list);
+	ilist_init(&(*cache)->queue[1].list);
+	if (0 == idict_init(&(*cache)->dict, (0 != max_entries) ? max_entries : 16, f_hash)) {
+		if (MS_CACHE_S3FIFO != policy) {
+			return (0);
+		}
+		(*cache)->ghost_size = (0 != max_entries) ? max_entries : CACHE_GHOST;
+		(*cache)->ghost = MS_CAST(size_t *, MS_ALLOC((*cache)->ghost_size * sizeof(size_t)));
+		if (
+			   MS_ADDRCK((*cache)->ghost)
+			&& 0 == dict_ghost_init(&(*cache)->ghosts, (*cache)->ghost_size)
+		) {
+			return (0);
+		}
+		MS_DEALLOC((*cache)->ghost);
+		idict_destroy((*cache)->dict, NULL);
+	}
+	MS_DEALLOC(*cache);
+	*cache = NULL;
+	return (1);
+}
+
+void cache_destroy(t_cache * cache)
+{
+	if (MS_ADDRCK(cache)) {
+		while (0 != cache->queue[0].count) {
+			__cache_drop(cache, __cache_back(cache, 0), cache->f_free);
+		}
+		while (0 != cache->queue[1].count) {
+			__cache_drop(cache, __cache_back(cache, 1), cache->f_free);
+		}
+		idict_destroy(cache->dict, NULL);
+		dict_ghost_destroy(cache->ghosts);
+		MS_DEALLOC(cache->ghost);
+		MS_DEALLOC(cache);
+	}
+}
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+size_t cache_size(const t_cache * cache)
+{
+	if (MS_ADDRCK(cache)) {
+		return (idict_size(cache->dict));
+	}
+	return (0);
+}
+
+int cache_put(
+	  t_cache * cache
+	, void * data
+	, size_t size
+	, unsigned char * key
+	, size_t key_len
+	, size_t charge
+) {
+	void          * copy;
+	t_cache_entry * entry;
+
+	if (
+		   MS_ADDRNULL(cache)
+		|| MS_ADDRNULL(data)
+		|| MS_ADDRNULL(key)
+		|| (0 != cache->max_bytes && charge > cache->max_bytes)
+	) {
+		return (1);
+	}
+	copy = data;
+	if (0 != size) {
+		copy = MS_ALLOC(size);
+		if (MS_ADDRNULL(copy)) {
+			return (1);
+		}
+		MS_MEMCPY(copy, data, size);
+	}
+	entry = __cache_find(cache, key, key_len);
+	if (MS_ADDRCK(entry)) {
+		if (
+			   MS_ADDRCK(cache->f_free)
+			&& entry->data != copy
+		) {
+			cache->f_free(entry->data);
+		}
+		entry->data = copy;
+		cache->queue[entry->queue].bytes += charge - entry->bytes;
+		cache->bytes += charge - entry->bytes;
+		entry->bytes = charge;
+		__cache_hit(cache, entry);
+	} else {
+		entry = MS_CAST(t_cache_entry *, MS_ALLOC(sizeof(t_cache_entry) + key_len));
+		if (MS_ADDRNULL(entry)) {
+			if (0 != size) {
+				MS_DEALLOC(copy);
+			}
+			return (1);
+		}
+		entry->data    = copy;
+		entry->bytes   = charge;
+		entry->key_len = key_len;
+		entry->freq    = 0;
+		MS_MEMCPY(entry->key, key, key_len);
+		idict_insert(cache->dict, &entry->dict, entry->key, key_len);
+		cache->bytes += charge;
+		if (
+			   MS_ADDRCK(cache->ghosts)
+			&& MS_ADDRCK(dict_ghost_search(cache->ghosts, entry->dict.hash))
+		) {
+			__cache_push(cache, entry, 1);
+		} else {
+			__cache_push(cache, entry, 0);
+		}
+	}
+	while (__cache_over(cache, idict_size(cache->dict), cache->bytes, 10)) {
+		cache_evict(cache);
+	}
+	return (0);
+}
+
+void * cache_get(
+	  t_cache * cache
+	, unsigned char * key
+	, size_t key_len
+	, int flag
+) {
+	void          * data;
+	t_cache_entry * entry;
+
+	if (
+		   MS_ADDRCK(cache)
+		&& MS_ADDRCK(key)
+	) {
+		entry = __cache_find(cache, key, key_len);
+		if (MS_ADDRNULL(entry)) {
+			++cache->stats.misses;
+			return (NULL);
+		}
+		++cache->stats.hits;
+		data = entry->data;
+		if (MS_ELEMENT_REMOVE & flag) {
+			__cache_drop(cache, entry, NULL);
+		} else {
+			__cache_hit(cache, entry);
+		}
+		return (data);
+	}
+	return (NULL);
+}
+
+int cache_touch(
+	  t_cache * cache
+	, unsigned char * key
+	, size_t key_len
+) {
+	t_cache_entry * entry;
+
+	if (
+		   MS_ADDRCK(cache)
+		&& MS_ADDRCK(key)
+	) {
+		entry = __cache_find(cache, key, key_len);
+		if (MS_ADDRCK(entry)) {
+			__cache_hit(cache, entry);
+			return (0);
+		}
+	}
+	return (1);
+}
+
+int cache_evict(t_cache * cache)
+{
+	if (
+		   MS_ADDRNULL(cache)
+		|| 0 == idict_size(cache->dict)
+	) {
+		return (1);
+	}
+	__cache_drop(cache, __cache_victim(cache), cache->f_free);
+	++cache->stats.evictions;
+	return (0);
+}
+
+int cache_stats(
+	  const t_cache * cache
+	, t_cache_stats * stats
+) {
+	if (
+		   MS_ADDRNULL(cache)
+		|| MS_ADDRNULL(stats)
+	) {
+		return (1);
+	}
+	*stats = cache->stats;
+	stats->entries = idict_size(cache->dict);
+	stats->bytes   = cache->bytes;
+	return (0);
+}
+
+/* EOF */
\ No newline at end of file
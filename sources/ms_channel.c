@@ -0,0 +1,433 @@
+# include <ms_channel.h>
+# include <ms_list/ms_intrusive_linked.h>
+# include <pthread.h>
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+/*
+ * States of a select waiting: a thread doing one of its cases claims it
+ * first, so that a single case is ever done, then publishes it
+*/
+# define CHANNEL_WAITING      0
+# define CHANNEL_CLAIMED      1
+# define CHANNEL_DONE         2
+# define CHANNEL_CANCELLED    3
+
+/*
+ * Shared by the waiters of a select, `state` is its only futex word
+*/
+typedef struct s_channel_sync
+{
+	int    state;
+	size_t fired;
+} t_channel_sync;
+
+/*
+ * A case of a select queued on its channel, on the stack of the thread
+ * waiting: nothing is allocated to wait
+*/
+typedef struct s_channel_waiter
+{
+	t_ilist          hook;
+	t_channel_sync * sync;
+	t_channel_case * kase;
+	size_t           index;
+} t_channel_waiter;
+
+/*
+ * A ring of `capacity` data, `count` of them from `head`, and the
+ * selects waiting to send or to receive
+*/
+struct s_channel
+{
+	pthread_mutex_t   lock;
+	size_t            capacity;
+	size_t            head;
+	size_t            count;
+	int               closed;
+	void           ** ring;
+	t_ilist           senders;
+	t_ilist           receivers;
+};
+
+static __thread size_t g_channel_start;
+
+/*--------------------------------- PRIVATE METHODS ---------------------------------*/
+
+/*
+ * First waiter of a queue that can still be claimed, the others
+ * are dropped
+*/
+static inline
+t_channel_waiter * __channel_claim(t_ilist * queue)
+{
+	int                state;
+	t_channel_waiter * waiter;
+
+	waiter = NULL;
+	while (
+		   MS_ADDRNULL(waiter)
+		&& 0 == ilist_is_empty(queue)
+	) {
+		waiter = MS_CONTAINER_OF(ilist_pop_front(queue), t_channel_waiter, hook);
+		state = CHANNEL_WAITING;
+		if (0 == MS_ATOMIC_CAS(&waiter->sync->state, &state, CHANNEL_CLAIMED)) {
+			waiter = NULL;
+		}
+	}
+	return (waiter);
+}
+
+/*
+ * The waiter may return as soon as it sees the state done,
+ * its sync is not read after
+*/
+static inline
+void __channel_fire(
+	  t_channel_waiter * waiter
+	, int closed
+) {
+	t_channel_sync * sync;
+
+	sync = waiter->sync;
+	waiter->kase->closed = closed;
+	sync->fired = waiter->index;
+	MS_ATOMIC_STORE(&sync->state, CHANNEL_DONE);
+	futex_wake(&sync->state, 1);
+}
+
+/*
+ * Do a case at once if possible, the channel locked
+*/
+static inline
+int __channel_try(
+	  t_channel * channel
+	, t_channel_case * kase
+) {
+	t_channel_waiter * waiter;
+
+	kase->closed = 0;
+	if (MS_CHANNEL_SEND == kase->op) {
+		if (0 != channel->closed) {
+			kase->closed = 1;
+			return (1);
+		}
+		waiter = __channel_claim(&channel->receivers);
+		if (MS_ADDRCK(waiter)) {
+			waiter->kase->data = kase->data;
+			__channel_fire(waiter, 0);
+			return (1);
+		}
+		if (channel->count < channel->capacity) {
+			channel->ring[(channel->head + channel->count) % channel->capacity] = kase->data;
+			++channel->count;
+			return (1);
+		}
+		return (0);
+	}
+	if (0 != channel->count) {
+		kase->data = channel->ring[channel->head];
+		channel->head = (channel->head + 1) % channel->capacity;
+		--channel->count;
+		waiter = __channel_claim(&channel->senders);
+		if (MS_ADDRCK(waiter)) {
+			channel->ring[(channel->head + channel->count) % channel->capacity] = waiter->kase->data;
+			++channel->count;
+			__channel_fire(waiter, 0);
+		}
+		return (1);
+	}
+	waiter = __channel_claim(&channel->senders);
+	if (MS_ADDRCK(waiter)) {
+		kase->data = waiter->kase->data;
+		__channel_fire(waiter, 0);
+		return (1);
+	}
+	if (0 != channel->closed) {
+		kase->data = NULL;
+		kase->closed = 1;
+		return (1);
+	}
+	return (0);
+}
+
+/*
+ * The channels of the cases, once each, sorted by address: the locks
+ * are always taken in that order. Returns 0 if a channel is NULL
+*/
+static inline
+size_t __channel_order(
+	  t_channel_case * cases
+	, size_t count
+	, t_channel ** locks
+) {
+	size_t      i;
+	size_t      j;
+	size_t      size;
+	t_channel * channel;
+
+	size = 0;
+	i = 0;
+	while (i < count) {
+		channel = cases[i].channel;
+		if (MS_ADDRNULL(channel)) {
+			return (0);
+		}
+		j = size;
+		while (
+			   0 != j
+			&& MS_CAST(size_t, locks[j - 1]) > MS_CAST(size_t, channel)
+		) {
+			--j;
+		}
+		if (
+			   0 == j
+			|| locks[j - 1] != channel
+		) {
+			MS_MEMMOVE(locks + j + 1, locks + j, (size - j) * sizeof(t_channel *));
+			locks[j] = channel;
+			++size;
+		}
+		++i;
+	}
+	return (size);
+}
+
+static inline
+void __channel_lock(
+	  t_channel ** locks
+	, size_t size
+) {
+	size_t i;
+
+	i = 0;
+	while (i < size) {
+		pthread_mutex_lock(&locks[i]->lock);
+		++i;
+	}
+}
+
+static inline
+void __channel_unlock(
+	  t_channel ** locks
+	, size_t size
+) {
+	while (0 != size) {
+		pthread_mutex_unlock(&locks[--size]->lock);
+	}
+}
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+int channel_init(
+	  t_channel ** channel
+	, size_t capacity
+) {
+	if (MS_ADDRNULL(channel)) {
+		return (1);
+	}
+	*channel = MS_CAST(t_channel *, MS_ALLOC(sizeof(t_channel)));
+	if (MS_ADDRNULL(*channel)) {
+		return (1);
+	}
+	MS_MEMSET(*channel, 0, sizeof(t_channel));
+	if (0 != capacity) {
+		(*channel)->ring = MS_CAST(void **, MS_ALLOC(capacity * sizeof(void *)));
+		if (MS_ADDRNULL((*channel)->ring)) {
+			MS_DEALLOC(*channel);
+			*channel = NULL;
+			return (1);
+		}
+	}
+	(*channel)->capacity = capacity;
+	ilist_init(&(*channel)->senders);
+	ilist_init(&(*channel)->receivers);
+	pthread_mutex_init(&(*channel)->lock, NULL);
+	return (0);
+}
+
+void channel_destroy(
+	  t_channel * channel
+	, void (*f_free)(void * data)
+) {
+	if (MS_ADDRCK(channel)) {
+		while (0 != channel->count) {
+			if (MS_ADDRCK(f_free)) {
+				f_free(channel->ring[channel->head]);
+			}
+			channel->head = (channel->head + 1) % channel->capacity;
+			--channel->count;
+		}
+		pthread_mutex_destroy(&channel->lock);
+		MS_DEALLOC(channel->ring);
+		MS_DEALLOC(channel);
+	}
+}
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+int channel_close(t_channel * channel)
+{
+	t_channel_waiter * waiter;
+
+	if (MS_ADDRNULL(channel)) {
+		return (1);
+	}
+	pthread_mutex_lock(&channel->lock);
+	if (0 != channel->closed) {
+		pthread_mutex_unlock(&channel->lock);
+		return (1);
+	}
+	channel->closed = 1;
+	waiter = __channel_claim(&channel->receivers);
+	while (MS_ADDRCK(waiter)) {
+		waiter->kase->data = NULL;
+		__channel_fire(waiter, 1);
+		waiter = __channel_claim(&channel->receivers);
+	}
+	waiter = __channel_claim(&channel->senders);
+	while (MS_ADDRCK(waiter)) {
+		__channel_fire(waiter, 1);
+		waiter = __channel_claim(&channel->senders);
+	}
+	pthread_mutex_unlock(&channel->lock);
+	return (0);
+}
+
+int channel_send(
+	  t_channel * channel
+	, void * data
+	, long timeout
+) {
+	t_channel_case kase;
+
+	kase.channel = channel;
+	kase.op      = MS_CHANNEL_SEND;
+	kase.closed  = 0;
+	kase.data    = data;
+	if (0 != channel_select(&kase, 1, timeout)) {
+		return (MS_ADDRNULL(channel) ? MS_CHANNEL_CLOSED : MS_CHANNEL_TIMEOUT);
+	}
+	return ((0 != kase.closed) ? MS_CHANNEL_CLOSED : 0);
+}
+
+int channel_recv(
+	  t_channel * channel
+	, void ** data
+	, long timeout
+) {
+	t_channel_case kase;
+
+	kase.channel = channel;
+	kase.op      = MS_CHANNEL_RECV;
+	kase.closed  = 0;
+	kase.data    = NULL;
+	if (0 != channel_select(&kase, 1, timeout)) {
+		return (MS_ADDRNULL(channel) ? MS_CHANNEL_CLOSED : MS_CHANNEL_TIMEOUT);
+	}
+	if (MS_ADDRCK(data)) {
+		*data = kase.data;
+	}
+	return ((0 != kase.closed) ? MS_CHANNEL_CLOSED : 0);
+}
+
+/*
+ * Once woken, the thread only locks the channels again to unqueue its
+ * other cases, or when it gave up: a send or receive done on its behalf
+ * never takes the lock twice
+*/
+int channel_select(
+	  t_channel_case * cases
+	, size_t count
+	, long timeout
+) {
+	int                     ret;
+	int                     state;
+	int                     timed_out;
+	size_t                  i;
+	size_t                  size;
+	size_t                  start;
+	struct timespec         ts;
+	const struct timespec * deadline;
+	t_channel             * locks[MS_CHANNEL_CASES];
+	t_channel_waiter        waiters[MS_CHANNEL_CASES];
+	t_channel_sync          sync;
+
+	if (
+		   MS_ADDRNULL(cases)
+		|| 0 == count
+		|| count > MS_CHANNEL_CASES
+	) {
+		return (-1);
+	}
+	size = __channel_order(cases, count, locks);
+	if (0 == size) {
+		return (-1);
+	}
+	deadline = futex_deadline(&ts, timeout);
+	__channel_lock(locks, size);
+	start = g_channel_start++ % count;
+	ret = -1;
+	i = 0;
+	while (
+		   -1 == ret
+		&& i < count
+	) {
+		if (0 != __channel_try(cases[(start + i) % count].channel, &cases[(start + i) % count])) {
+			ret = MS_CAST(int, (start + i) % count);
+		}
+		++i;
+	}
+	if (
+		   -1 != ret
+		|| 0 == timeout
+	) {
+		__channel_unlock(locks, size);
+		return (ret);
+	}
+	sync.state = CHANNEL_WAITING;
+	sync.fired = 0;
+	i = 0;
+	while (i < count) {
+		waiters[i].sync  = &sync;
+		waiters[i].kase  = &cases[i];
+		waiters[i].index = i;
+		ilist_init(&waiters[i].hook);
+		if (MS_CHANNEL_SEND == cases[i].op) {
+			ilist_push_back(&cases[i].channel->senders, &waiters[i].hook);
+		} else {
+			ilist_push_back(&cases[i].channel->receivers, &waiters[i].hook);
+		}
+		++i;
+	}
+	__channel_unlock(locks, size);
+	timed_out = 0;
+	while (
+		   CHANNEL_WAITING == MS_ATOMIC_LOAD(&sync.state)
+		&& 0 == timed_out
+	) {
+		timed_out = futex_wait(&sync.state, CHANNEL_WAITING, deadline);
+	}
+	state = CHANNEL_WAITING;
+	if (0 == MS_ATOMIC_CAS(&sync.state, &state, CHANNEL_CANCELLED)) {
+		while (CHANNEL_DONE != MS_ATOMIC_LOAD(&sync.state)) {
+			MS_CPU_RELAX();
+		}
+		ret = MS_CAST(int, sync.fired);
+	}
+	if (
+		   -1 == ret
+		|| 1 < count
+	) {
+		__channel_lock(locks, size);
+		i = 0;
+		while (i < count) {
+			ilist_remove(&waiters[i].hook);
+			++i;
+		}
+		__channel_unlock(locks, size);
+	}
+	return (ret);
+}
+
+/* EOF */
\ No newline at end of file
@@ -0,0 +1,203 @@
+# include <ms_combining.h>
+# include <pthread.h>
+# include <sched.h>
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+/*
+ * One record per thread, on its own cache line. `pending` is set by its
+ * thread once the operation is published and cleared by the combiner
+ * once `ret` is written
+*/
+typedef struct s_combining_record
+{
+	int                         pending;
+	int                         used;
+	int                         ret;
+	int                         (*f_op)(void * container, void * arg);
+	void                      * arg;
+	struct s_combining_record * next;
+} MS_ALIGNED(MS_CACHE_LINE) t_combining_record;
+
+/*
+ * `lock` is on its own cache line, the records are only ever pushed
+ * at the head of `records`
+*/
+struct s_combining
+{
+	void               * container;
+	t_combining_record * records;
+	pthread_key_t        key;
+	int                  lock MS_ALIGNED(MS_CACHE_LINE);
+};
+
+/*--------------------------------- PRIVATE METHODS ---------------------------------*/
+
+/*
+ * The record of an exited thread is kept for the next thread
+*/
+static
+void __combining_release(void * data)
+{
+	t_combining_record * record;
+
+	record = MS_CAST(t_combining_record *, data);
+	MS_ATOMIC_STORE(&record->used, 0);
+}
+
+static inline
+t_combining_record * __combining_record(t_combining * comb)
+{
+	int                  used;
+	t_combining_record * record;
+	t_combining_record * self;
+
+	self = MS_CAST(t_combining_record *, pthread_getspecific(comb->key));
+	record = MS_ATOMIC_LOAD(&comb->records);
+	while (
+		   MS_ADDRNULL(self)
+		&& MS_ADDRCK(record)
+	) {
+		used = 0;
+		if (MS_ATOMIC_CAS(&record->used, &used, 1)) {
+			self = record;
+		}
+		record = record->next;
+	}
+	if (MS_ADDRNULL(self)) {
+		self = MS_CAST(t_combining_record *, MS_ALLOC_ALIGN(MS_CACHE_LINE, sizeof(t_combining_record)));
+		if (MS_ADDRNULL(self)) {
+			return (NULL);
+		}
+		MS_MEMSET(self, 0, sizeof(t_combining_record));
+		self->used = 1;
+		self->next = MS_ATOMIC_LOAD(&comb->records);
+		while (0 == MS_ATOMIC_CAS(&comb->records, &self->next, self)) {
+		}
+	}
+	if (self != pthread_getspecific(comb->key)) {
+		pthread_setspecific(comb->key, self);
+	}
+	return (self);
+}
+
+/*
+ * Apply the pending operations of every record, until a scan finds
+ * none or after MS_COMBINING_PASSES scans
+*/
+static inline
+void __combining_combine(t_combining * comb)
+{
+	size_t               pass;
+	size_t               applied;
+	t_combining_record * record;
+
+	pass = 0;
+	applied = 1;
+	while (
+		   0 != applied
+		&& pass < MS_COMBINING_PASSES
+	) {
+		applied = 0;
+		record = MS_ATOMIC_LOAD(&comb->records);
+		while (MS_ADDRCK(record)) {
+			if (0 != MS_ATOMIC_LOAD(&record->pending)) {
+				record->ret = record->f_op(comb->container, record->arg);
+				MS_ATOMIC_STORE(&record->pending, 0);
+				++applied;
+			}
+			record = record->next;
+		}
+		++pass;
+	}
+}
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+int combining_init(
+	  t_combining ** comb
+	, void * container
+) {
+	if (MS_ADDRNULL(comb)) {
+		return (1);
+	}
+	*comb = MS_CAST(t_combining *, MS_ALLOC_ALIGN(MS_CACHE_LINE, sizeof(t_combining)));
+	if (MS_ADDRNULL(*comb)) {
+		return (1);
+	}
+	if (0 != pthread_key_create(&(*comb)->key, &__combining_release)) {
+		MS_DEALLOC(*comb);
+		*comb = NULL;
+		return (1);
+	}
+	(*comb)->container = container;
+	(*comb)->records   = NULL;
+	(*comb)->lock      = 0;
+	return (0);
+}
+
+void combining_destroy(t_combining * comb)
+{
+	t_combining_record * record;
+	t_combining_record * next;
+
+	if (MS_ADDRCK(comb)) {
+		pthread_key_delete(comb->key);
+		record = comb->records;
+		while (MS_ADDRCK(record)) {
+			next = record->next;
+			MS_DEALLOC(record);
+			record = next;
+		}
+		MS_DEALLOC(comb);
+	}
+}
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+int combining_apply(
+	  t_combining * comb
+	, int (*f_op)(void * container, void * arg)
+	, void * arg
+	, int * ret
+) {
+	int                  lock;
+	size_t               spin;
+	t_combining_record * record;
+
+	if (
+		   MS_ADDRNULL(comb)
+		|| MS_ADDRNULL(f_op)
+	) {
+		return (1);
+	}
+	record = __combining_record(comb);
+	if (MS_ADDRNULL(record)) {
+		return (1);
+	}
+	record->f_op = f_op;
+	record->arg  = arg;
+	MS_ATOMIC_STORE(&record->pending, 1);
+	spin = 0;
+	while (0 != MS_ATOMIC_LOAD(&record->pending)) {
+		lock = 0;
+		if (
+			   0 == MS_ATOMIC_LOAD(&comb->lock)
+			&& MS_ATOMIC_CAS(&comb->lock, &lock, 1)
+		) {
+			__combining_combine(comb);
+			MS_ATOMIC_STORE(&comb->lock, 0);
+		} else if (++spin < MS_COMBINING_SPIN) {
+			MS_CPU_RELAX();
+		} else {
+			spin = 0;
+			sched_yield();
+		}
+	}
+	if (MS_ADDRCK(ret)) {
+		*ret = record->ret;
+	}
+	return (0);
+}
+
+/* EOF */
\ No newline at end of file
@@ -1,4 +1,13 @@
 #include <ms_content.h>
+#include <ms_epoch.h>
+
+/*--------------------------------- PRIVATE METHODS ---------------------------------*/
+
+static
+void __content_dealloc(void * content)
+{
+	MS_DEALLOC(content);
+}
 
 /*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
 
@@ -41,4 +50,21 @@ void content_destroy(
 	}
 }
 
+int content_retire(
+	  t_content * content
+	, void (*f_free)(void * data)
+) {
+	if (
+		   MS_ADDRNULL(content)
+		|| 0 != epoch_reserve(2)
+	) {
+		return (1);
+	}
+	if (MS_ADDRCK(f_free)) {
+		epoch_retire(content->data, f_free);
+	}
+	epoch_retire(content, &__content_dealloc);
+	return (0);
+}
+
 /* EOF */
\ No newline at end of file
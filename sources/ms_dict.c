@@ -1,14 +1,282 @@
 # include <ms_dict.h>
+# include <ms_hash.h>
 
 /*----------------------------------- STRUCTURES ------------------------------------*/
 
+/*
+ * Number of keys whose lookups are interleaved by dict_search_batch
+*/
+# define DICT_BATCH           16
+
+/*
+ * The hash is kept next to the data so that the table can be resized
+ * without the keys, and most mismatches skip f_compare
+*/
+typedef struct s_dict_entry
+{
+	void                * data;
+	struct s_dict_entry * next;
+	size_t                hash;
+} t_dict_entry;
+
+/*
+ * `size` is a power of two, the bucket of a hash is `hash & (size - 1)`
+*/
 struct s_dict
 {
-	size_t       size;
-	size_t       (*f_hash)(unsigned char * key, size_t key_len);
-	t_content ** content;
+	size_t          size;
+	size_t          count;
+	size_t          (*f_hash)(unsigned char * key, size_t key_len);
+	t_dict_entry ** content;
 };
 
+/*
+ * Shared by the parts of dict_destroy_parallel and dict_foreach_parallel,
+ * `ret` is the first error of f_fct, which stops the other parts
+*/
+typedef struct s_dict_parallel
+{
+	t_dict * dict;
+	void  ** content;
+	void     (*f_free)(void * data);
+	int      (*f_fct)(void * data, void ** content);
+	int      ret;
+} t_dict_parallel;
+
+/*--------------------------------- PRIVATE METHODS ---------------------------------*/
+
+static inline
+t_dict_entry * __dict_entry_init(
+	  void * data
+	, size_t size
+	, size_t hash
+) {
+	t_dict_entry * entry;
+
+	entry = MS_CAST(t_dict_entry *, MS_ALLOC(sizeof(t_dict_entry)));
+	if (MS_ADDRCK(entry)) {
+		entry->data = data;
+		entry->next = NULL;
+		entry->hash = hash;
+		if (0 != size) {
+			entry->data = MS_ALLOC(size);
+			if (MS_ADDRNULL(entry->data)) {
+				MS_DEALLOC(entry);
+				return (NULL);
+			}
+			MS_MEMCPY(entry->data, data, size);
+		}
+	}
+	return (entry);
+}
+
+/*
+ * Link where the first element matching the key is (or would be) chained
+*/
+static inline
+t_dict_entry ** __dict_find(
+	  t_dict * dict
+	, size_t hash
+	, unsigned char * key
+	, size_t key_len
+	, int (*f_compare)(void * data, unsigned char * key, size_t key_len)
+) {
+	t_dict_entry ** link;
+
+	link = dict->content + (hash & (dict->size - 1));
+	while (
+		   MS_ADDRCK(*link)
+		&& (
+			   (*link)->hash != hash
+			|| 0 != f_compare((*link)->data, key, key_len)
+		)
+	) {
+		link = &(*link)->next;
+	}
+	return (link);
+}
+
+/*
+ * Chain a new entry, growing the table first if it is full.
+ * A failed growth only leaves longer chains
+*/
+static inline
+void __dict_link(
+	  t_dict * dict
+	, t_dict_entry * entry
+) {
+	size_t i;
+
+	if (dict->count >= dict->size) {
+		dict_resize(dict, dict->size << 1);
+	}
+	i = entry->hash & (dict->size - 1);
+	entry->next = dict->content[i];
+	dict->content[i] = entry;
+	++dict->count;
+}
+
+/*
+ * Bit reversal of a cursor, so that it can be incremented
+ * from its most significant bit (Redis SCAN)
+*/
+static inline
+size_t __dict_reverse(size_t cursor)
+{
+	size_t bits;
+	size_t mask;
+
+	bits = sizeof(cursor) * 8;
+	mask = ~MS_CAST(size_t, 0);
+	while ((bits >>= 1) > 0) {
+		mask ^= (mask << bits);
+		cursor = ((cursor >> bits) & mask) | ((cursor << bits) & ~mask);
+	}
+	return (cursor);
+}
+
+/*
+ * Group prefetching: each stage issues the loads of every key of the
+ * group before the next stage consumes them
+*/
+static inline
+size_t __dict_search_group(
+	  t_dict * dict
+	, unsigned char ** keys
+	, size_t * key_lens
+	, size_t count
+	, void ** datas
+	, int (*f_compare)(void * data, unsigned char * key, size_t key_len)
+) {
+	size_t                 i;
+	size_t                 found;
+	size_t                 active;
+	size_t                 hash[DICT_BATCH];
+	t_dict_entry         * node[DICT_BATCH];
+	t_dict_entry * const * bucket[DICT_BATCH];
+
+	i = 0;
+	while (i < count) {
+		hash[i] = dict->f_hash(keys[i], key_lens[i]);
+		bucket[i] = dict->content + (hash[i] & (dict->size - 1));
+		MS_PREFETCH(bucket[i]);
+		datas[i] = NULL;
+		++i;
+	}
+	active = 0;
+	i = 0;
+	while (i < count) {
+		node[i] = *bucket[i];
+		if (MS_ADDRCK(node[i])) {
+			MS_PREFETCH(node[i]);
+			++active;
+		}
+		++i;
+	}
+	found = 0;
+	while (0 != active) {
+		i = 0;
+		while (i < count) {
+			if (
+				   MS_ADDRCK(node[i])
+				&& node[i]->hash == hash[i]
+			) {
+				MS_PREFETCH(node[i]->data);
+			}
+			++i;
+		}
+		i = 0;
+		while (i < count) {
+			if (MS_ADDRCK(node[i])) {
+				if (
+					   node[i]->hash == hash[i]
+					&& 0 == f_compare(node[i]->data, keys[i], key_lens[i])
+				) {
+					datas[i] = node[i]->data;
+					node[i] = NULL;
+					++found;
+				} else {
+					node[i] = node[i]->next;
+					MS_PREFETCH(node[i]);
+				}
+				if (MS_ADDRNULL(node[i])) {
+					--active;
+				}
+			}
+			++i;
+		}
+	}
+	return (found);
+}
+
+static inline
+void __dict_free_buckets(
+	  t_dict * dict
+	, size_t begin
+	, size_t end
+	, void (*f_free)(void * data)
+) {
+	t_dict_entry * entry;
+
+	while (begin < end) {
+		while (MS_ADDRCK(dict->content[begin])) {
+			entry = dict->content[begin];
+			dict->content[begin] = entry->next;
+			if (MS_ADDRCK(f_free)) {
+				f_free(entry->data);
+			}
+			MS_DEALLOC(entry);
+		}
+		++begin;
+	}
+}
+
+static
+void __dict_destroy_range(
+	  size_t begin
+	, size_t end
+	, void * arg
+) {
+	t_dict_parallel * parallel;
+
+	parallel = MS_CAST(t_dict_parallel *, arg);
+	__dict_free_buckets(parallel->dict, begin, end, parallel->f_free);
+}
+
+static
+void __dict_foreach_range(
+	  size_t begin
+	, size_t end
+	, void * arg
+) {
+	int               ret;
+	int               first;
+	t_dict_entry    * entry;
+	t_dict_parallel * parallel;
+
+	parallel = MS_CAST(t_dict_parallel *, arg);
+	ret = 0;
+	while (
+		   0 == ret
+		&& begin < end
+		&& 0 == MS_ATOMIC_LOAD(&parallel->ret)
+	) {
+		entry = parallel->dict->content[begin];
+		while (
+			   0 == ret
+			&& MS_ADDRCK(entry)
+		) {
+			ret = parallel->f_fct(entry->data, parallel->content);
+			entry = entry->next;
+		}
+		++begin;
+	}
+	if (0 != ret) {
+		first = 0;
+		MS_ATOMIC_CAS(&parallel->ret, &first, ret);
+	}
+}
+
 /*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
 
 int dict_init(
@@ -26,10 +294,10 @@ int dict_init(
 		*dict = MS_CAST(t_dict *, MS_ALLOC(sizeof(t_dict)));
 		if (MS_ADDRCK(*dict)) {
 			MS_MEMSET(*dict, 0, sizeof(t_dict));
-			(*dict)->size    = size;
+			(*dict)->size    = hash_round_size(size);
 			(*dict)->f_hash  = f_hash;
-			content_size     = size * sizeof(t_content *);
-			(*dict)->content = MS_CAST(t_content **, MS_ALLOC(content_size));
+			content_size     = (*dict)->size * sizeof(t_dict_entry *);
+			(*dict)->content = MS_CAST(t_dict_entry **, MS_ALLOC(content_size));
 			if (MS_ADDRCK((*dict)->content)) {
 				MS_MEMSET((*dict)->content, 0, content_size);
 				return (0);
@@ -45,23 +313,29 @@ void dict_destroy(
 	  t_dict * dict
 	, void (*f_free)(void * data)
 ) {
-	size_t      i;
-	t_content * content;
+	if (MS_ADDRCK(dict)) {
+		if (MS_ADDRCK(dict->content)) {
+			__dict_free_buckets(dict, 0, dict->size, f_free);
+			MS_DEALLOC(dict->content);
+		}
+		MS_DEALLOC(dict);
+	}
+}
+
+void dict_destroy_parallel(
+	  t_dict * dict
+	, void (*f_free)(void * data)
+	, t_pool * pool
+	, size_t grain
+) {
+	t_dict_parallel parallel;
 
 	if (MS_ADDRCK(dict)) {
 		if (MS_ADDRCK(dict->content)) {
-			i = 0;
-			while (i < dict->size) {
-				while (MS_ADDRCK(dict->content[i])) {
-					content = dict->content[i];
-					dict->content[i] = dict->content[i]->next;
-					content_destroy(
-						  content
-						, f_free
-					);
-				}
-				++i;
-			}
+			MS_MEMSET(&parallel, 0, sizeof(t_dict_parallel));
+			parallel.dict = dict;
+			parallel.f_free = f_free;
+			pool_parallel_for(pool, 0, dict->size, grain, &__dict_destroy_range, &parallel);
 			MS_DEALLOC(dict->content);
 		}
 		MS_DEALLOC(dict);
@@ -70,6 +344,66 @@ void dict_destroy(
 
 /*------------------------------------- METHODS -------------------------------------*/
 
+size_t dict_size(const t_dict * dict)
+{
+	if (MS_ADDRCK(dict)) {
+		return (dict->count);
+	}
+	return (0);
+}
+
+int dict_resize(
+	  t_dict * dict
+	, size_t size
+) {
+	size_t          i;
+	size_t          mask;
+	t_dict_entry  * next;
+	t_dict_entry  * entry;
+	t_dict_entry  * reverse;
+	t_dict_entry ** content;
+
+	if (
+		   MS_ADDRNULL(dict)
+		|| 0 == size
+	) {
+		return (1);
+	}
+	size = hash_round_size(size);
+	if (size == dict->size) {
+		return (0);
+	}
+	content = MS_CAST(t_dict_entry **, MS_ALLOC(size * sizeof(t_dict_entry *)));
+	if (MS_ADDRNULL(content)) {
+		return (1);
+	}
+	MS_MEMSET(content, 0, size * sizeof(t_dict_entry *));
+	mask = size - 1;
+	i = 0;
+	while (i < dict->size) {
+		reverse = NULL;
+		entry = dict->content[i];
+		while (MS_ADDRCK(entry)) {
+			next = entry->next;
+			entry->next = reverse;
+			reverse = entry;
+			entry = next;
+		}
+		/* Pushed back reversed, the entries keep their relative order */
+		while (MS_ADDRCK(reverse)) {
+			next = reverse->next;
+			reverse->next = content[reverse->hash & mask];
+			content[reverse->hash & mask] = reverse;
+			reverse = next;
+		}
+		++i;
+	}
+	MS_DEALLOC(dict->content);
+	dict->content = content;
+	dict->size    = size;
+	return (0);
+}
+
 int dict_insert(
 	  t_dict * dict
 	, void * data
@@ -77,21 +411,30 @@ int dict_insert(
 	, unsigned char * key
 	, size_t key_len
 ) {
-	size_t      i;
-	t_content * content;
+	if (
+		   MS_ADDRCK(dict)
+		&& MS_ADDRCK(key)
+	) {
+		return (dict_insert_hashed(dict, data, size, dict->f_hash(key, key_len)));
+	}
+	return (1);
+}
+
+int dict_insert_hashed(
+	  t_dict * dict
+	, void * data
+	, size_t size
+	, size_t hash
+) {
+	t_dict_entry * entry;
 
 	if (
 		   MS_ADDRCK(dict)
 		&& MS_ADDRCK(data)
-		&& MS_ADDRCK(key)
 	) {
-		content = content_init(data, size);
-		if (MS_ADDRCK(content)) {
-			i = dict->f_hash(key, key_len) % dict->size;
-			if (MS_ADDRCK(dict->content[i])) {
-				content->next = dict->content[i];
-			}
-			dict->content[i] = content;
+		entry = __dict_entry_init(data, size, hash);
+		if (MS_ADDRCK(entry)) {
+			__dict_link(dict, entry);
 			return (0);
 		}
 	}
@@ -105,62 +448,262 @@ void * dict_search(
 	, int flag
 	, int (*f_compare)(void * data, unsigned char * key, size_t key_len)
 ) {
-	size_t      i;
-	void      * data;
-	t_content * tmp;
-	t_content * content;
+	if (
+		   MS_ADDRCK(dict)
+		&& MS_ADDRCK(key)
+	) {
+		return (dict_search_hashed(
+			  dict
+			, dict->f_hash(key, key_len)
+			, key
+			, key_len
+			, flag
+			, f_compare
+		));
+	}
+	return (NULL);
+}
+
+void * dict_search_hashed(
+	  t_dict * dict
+	, size_t hash
+	, unsigned char * key
+	, size_t key_len
+	, int flag
+	, int (*f_compare)(void * data, unsigned char * key, size_t key_len)
+) {
+	void          * data;
+	t_dict_entry  * entry;
+	t_dict_entry ** link;
 
-	data = NULL;
 	if (
 		   MS_ADDRCK(dict)
 		&& MS_ADDRCK(key)
 		&& MS_ADDRCK(f_compare)
 	) {
-		i = dict->f_hash(key, key_len) % dict->size;
-		if (MS_ADDRCK(dict->content[i])) {
-			if (MS_ADDRNULL((dict->content[i])->next)) {
-				if (0 == f_compare((dict->content[i])->data, key, key_len)) {
-					data = (dict->content[i])->data;
-					if (MS_ELEMENT_REMOVE == flag) {
-						content_destroy(
-							  dict->content[i]
-							, NULL
-						);
-						dict->content[i] = NULL;
-					}
-				}
-			} else {
-				content = dict->content[i];
-				if (0 == f_compare(content->data, key, key_len)) {
-					data = content->data;
-					if (MS_ELEMENT_REMOVE == flag) {
-						dict->content[i] = content->next;
-						content_destroy(
-							  content
-							, NULL
-						);
-					}
-				} else {
-					tmp = content->next;
-					while (MS_ADDRCK(tmp)) {
-						if (0 == f_compare(tmp->data, key, key_len)) {
-							data = tmp->data;
-							if (MS_ELEMENT_REMOVE == flag) {
-								content->next = tmp->next;
-								content_destroy(
-									  tmp
-									, NULL
-								);
-							}
-						}
-						content = content->next;
-						tmp     = content->next;
-					}
-				}
+		link = __dict_find(dict, hash, key, key_len, f_compare);
+		entry = *link;
+		if (MS_ADDRCK(entry)) {
+			data = entry->data;
+			if (MS_ELEMENT_REMOVE == flag) {
+				*link = entry->next;
+				MS_DEALLOC(entry);
+				--dict->count;
+			}
+			return (data);
+		}
+	}
+	return (NULL);
+}
+
+int dict_upsert(
+	  t_dict * dict
+	, void * data
+	, size_t size
+	, unsigned char * key
+	, size_t key_len
+	, int (*f_compare)(void * data, unsigned char * key, size_t key_len)
+	, void (*f_free)(void * data)
+) {
+	size_t         hash;
+	void         * copy;
+	t_dict_entry * entry;
+
+	if (
+		   MS_ADDRNULL(dict)
+		|| MS_ADDRNULL(data)
+		|| MS_ADDRNULL(key)
+		|| MS_ADDRNULL(f_compare)
+	) {
+		return (1);
+	}
+	hash = dict->f_hash(key, key_len);
+	entry = *__dict_find(dict, hash, key, key_len, f_compare);
+	if (MS_ADDRNULL(entry)) {
+		entry = __dict_entry_init(data, size, hash);
+		if (MS_ADDRNULL(entry)) {
+			return (1);
+		}
+		__dict_link(dict, entry);
+		return (0);
+	}
+	copy = data;
+	if (0 != size) {
+		copy = MS_ALLOC(size);
+		if (MS_ADDRNULL(copy)) {
+			return (1);
+		}
+		MS_MEMCPY(copy, data, size);
+	}
+	if (
+		   MS_ADDRCK(f_free)
+		&& entry->data != copy
+	) {
+		f_free(entry->data);
+	}
+	entry->data = copy;
+	return (0);
+}
+
+void ** dict_get_or_insert(
+	  t_dict * dict
+	, void * data
+	, size_t size
+	, unsigned char * key
+	, size_t key_len
+	, int (*f_compare)(void * data, unsigned char * key, size_t key_len)
+) {
+	size_t         hash;
+	t_dict_entry * entry;
+
+	if (
+		   MS_ADDRNULL(dict)
+		|| MS_ADDRNULL(data)
+		|| MS_ADDRNULL(key)
+		|| MS_ADDRNULL(f_compare)
+	) {
+		return (NULL);
+	}
+	hash = dict->f_hash(key, key_len);
+	entry = *__dict_find(dict, hash, key, key_len, f_compare);
+	if (MS_ADDRNULL(entry)) {
+		entry = __dict_entry_init(data, size, hash);
+		if (MS_ADDRNULL(entry)) {
+			return (NULL);
+		}
+		__dict_link(dict, entry);
+	}
+	return (&entry->data);
+}
+
+size_t dict_search_batch(
+	  t_dict * dict
+	, unsigned char ** keys
+	, size_t * key_lens
+	, size_t count
+	, void ** datas
+	, int (*f_compare)(void * data, unsigned char * key, size_t key_len)
+) {
+	size_t i;
+	size_t group;
+	size_t found;
+
+	found = 0;
+	if (
+		   MS_ADDRCK(dict)
+		&& MS_ADDRCK(keys)
+		&& MS_ADDRCK(key_lens)
+		&& MS_ADDRCK(datas)
+		&& MS_ADDRCK(f_compare)
+	) {
+		i = 0;
+		while (i < count) {
+			group = count - i;
+			if (group > DICT_BATCH) {
+				group = DICT_BATCH;
 			}
+			found += __dict_search_group(
+				  dict
+				, keys + i
+				, key_lens + i
+				, group
+				, datas + i
+				, f_compare
+			);
+			i += group;
 		}
 	}
-	return (data);
+	return (found);
+}
+
+int dict_foreach(
+	  t_dict * dict
+	, void ** content
+	, int (*f_fct)(void * data, void ** content)
+) {
+	int            ret;
+	size_t         i;
+	t_dict_entry * entry;
+
+	ret = 0;
+	if (
+		   MS_ADDRCK(dict)
+		&& MS_ADDRCK(f_fct)
+	) {
+		i = 0;
+		while (
+			   0 == ret
+			&& i < dict->size
+		) {
+			entry = dict->content[i];
+			while (
+				   0 == ret
+				&& MS_ADDRCK(entry)
+			) {
+				ret = f_fct(entry->data, content);
+				entry = entry->next;
+			}
+			++i;
+		}
+	}
+	return (ret);
+}
+
+int dict_foreach_parallel(
+	  t_dict * dict
+	, void ** content
+	, int (*f_fct)(void * data, void ** content)
+	, t_pool * pool
+	, size_t grain
+) {
+	t_dict_parallel parallel;
+
+	if (
+		   MS_ADDRNULL(dict)
+		|| MS_ADDRNULL(f_fct)
+	) {
+		return (0);
+	}
+	MS_MEMSET(&parallel, 0, sizeof(t_dict_parallel));
+	parallel.dict = dict;
+	parallel.content = content;
+	parallel.f_fct = f_fct;
+	pool_parallel_for(pool, 0, dict->size, grain, &__dict_foreach_range, &parallel);
+	return (parallel.ret);
+}
+
+/*
+ * The cursor is incremented on its reversed bits: the buckets already
+ * visited stay, in any larger or smaller table, the ones whose low bits
+ * are before the cursor, so a resize between two calls skips nothing
+*/
+size_t dict_scan(
+	  t_dict * dict
+	, size_t cursor
+	, void ** content
+	, int (*f_fct)(void * data, void ** content)
+) {
+	size_t         mask;
+	t_dict_entry * next;
+	t_dict_entry * entry;
+
+	if (
+		   MS_ADDRNULL(dict)
+		|| MS_ADDRNULL(f_fct)
+	) {
+		return (0);
+	}
+	mask = dict->size - 1;
+	entry = dict->content[cursor & mask];
+	while (MS_ADDRCK(entry)) {
+		next = entry->next;
+		f_fct(entry->data, content);
+		entry = next;
+	}
+	cursor |= ~mask;
+	cursor = __dict_reverse(cursor);
+	++cursor;
+	return (__dict_reverse(cursor));
 }
 
 /* EOF */
\ No newline at end of file
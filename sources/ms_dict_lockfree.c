@@ -0,0 +1,610 @@
+# include <ms_dict_lockfree.h>
+# include <ms_epoch.h>
+# include <ms_hash.h>
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+/*
+ * Average number of elements per bucket before the buckets double
+*/
+# define DICT_LF_LOAD         2
+
+/*
+ * Segment 0 holds the bucket 0, the segment s the buckets [2^(s-1), 2^s)
+*/
+# define DICT_LF_SEGMENTS     (sizeof(size_t) * 8)
+
+/*
+ * Low bit of the `next` of a removed node
+*/
+# define DICT_LF_MARK         MS_CAST(size_t, 0x01)
+# define DICT_LF_MARKED(ptr)  (0 != (MS_CAST(size_t, ptr) & DICT_LF_MARK))
+# define DICT_LF_PTR(ptr)     (MS_CAST(t_dict_lf_node *, (MS_CAST(size_t, ptr) & ~DICT_LF_MARK)))
+
+/*
+ * `order` is the split-order key: the bit-reversed hash with its low bit
+ * set for an element, the bit-reversed index of a bucket otherwise, so
+ * that the elements of a bucket follow it and splitting it in two only
+ * inserts a new bucket node in the middle
+*/
+typedef struct s_dict_lf_node
+{
+	struct s_dict_lf_node * next;
+	size_t                  order;
+	void                  * data;
+} t_dict_lf_node;
+
+/*
+ * `size` is a power of two, the bucket of a hash is `hash & (size - 1)`.
+ * `count` is on its own cache line, the readers never write
+*/
+struct s_dict_lf
+{
+	size_t            size;
+	size_t            (*f_hash)(unsigned char * key, size_t key_len);
+	t_dict_lf_node ** segments[DICT_LF_SEGMENTS];
+	size_t            count MS_ALIGNED(MS_CACHE_LINE);
+};
+
+/*--------------------------------- PRIVATE METHODS ---------------------------------*/
+
+static
+void __dict_lf_dealloc(void * data)
+{
+	MS_DEALLOC(data);
+}
+
+static inline
+size_t __dict_lf_reverse(size_t key)
+{
+	size_t bits;
+	size_t mask;
+
+	bits = sizeof(key) * 8;
+	mask = ~MS_CAST(size_t, 0);
+	while ((bits >>= 1) > 0) {
+		mask ^= (mask << bits);
+		key = ((key >> bits) & mask) | ((key << bits) & ~mask);
+	}
+	return (key);
+}
+
+/*
+ * Bucket split to create `bucket`: its highest bit cleared
+*/
+static inline
+size_t __dict_lf_parent(size_t bucket)
+{
+	size_t bit;
+
+	bit = 1;
+	while (bit <= (bucket >> 1)) {
+		bit <<= 1;
+	}
+	return (bucket & ~bit);
+}
+
+static inline
+t_dict_lf_node * __dict_lf_node(
+	  void * data
+	, size_t size
+	, size_t order
+) {
+	t_dict_lf_node * node;
+
+	node = MS_CAST(t_dict_lf_node *, MS_ALLOC(sizeof(t_dict_lf_node)));
+	if (MS_ADDRCK(node)) {
+		node->next  = NULL;
+		node->order = order;
+		node->data  = data;
+		if (0 != size) {
+			node->data = MS_ALLOC(size);
+			if (MS_ADDRNULL(node->data)) {
+				MS_DEALLOC(node);
+				return (NULL);
+			}
+			MS_MEMCPY(node->data, data, size);
+		}
+	}
+	return (node);
+}
+
+/*
+ * Slot of a bucket, allocating its segment if `create` is set
+*/
+static inline
+t_dict_lf_node ** __dict_lf_slot(
+	  t_dict_lf * dict
+	, size_t bucket
+	, int create
+) {
+	size_t            segment;
+	size_t            size;
+	t_dict_lf_node ** content;
+	t_dict_lf_node ** expected;
+
+	segment = 0;
+	while (0 != (bucket >> segment)) {
+		++segment;
+	}
+	size = (0 == segment) ? 1 : (MS_CAST(size_t, 1) << (segment - 1));
+	content = MS_ATOMIC_LOAD(&dict->segments[segment]);
+	if (
+		   MS_ADDRNULL(content)
+		&& 0 != create
+	) {
+		content = MS_CAST(t_dict_lf_node **, MS_ALLOC(size * sizeof(t_dict_lf_node *)));
+		if (MS_ADDRNULL(content)) {
+			return (NULL);
+		}
+		MS_MEMSET(content, 0, size * sizeof(t_dict_lf_node *));
+		expected = NULL;
+		if (0 == MS_ATOMIC_CAS(&dict->segments[segment], &expected, content)) {
+			MS_DEALLOC(content);
+			content = expected;
+		}
+	}
+	if (MS_ADDRNULL(content)) {
+		return (NULL);
+	}
+	return (content + (bucket & (size - 1)));
+}
+
+static inline
+int __dict_lf_match(
+	  t_dict_lf_node * node
+	, size_t order
+	, unsigned char * key
+	, size_t key_len
+	, int (*f_compare)(void * data, unsigned char * key, size_t key_len)
+) {
+	return (
+		   node->order == order
+		&& (
+			   0 == (order & 1)
+			|| (
+				   MS_ADDRCK(f_compare)
+				&& 0 == f_compare(node->data, key, key_len)
+			)
+		)
+	);
+}
+
+/*
+ * Harris-Michael search from a bucket: `*prev` is left on the link to
+ * `*cur`, the first node matching or past `order`. The removed nodes met
+ * are unlinked and retired on the way.
+ * Returns 1 on a match, 0 otherwise and -1 if a node could not be retired
+*/
+static inline
+int __dict_lf_find(
+	  t_dict_lf_node * head
+	, size_t order
+	, unsigned char * key
+	, size_t key_len
+	, int (*f_compare)(void * data, unsigned char * key, size_t key_len)
+	, t_dict_lf_node *** prev
+	, t_dict_lf_node ** cur
+) {
+	t_dict_lf_node * node;
+	t_dict_lf_node * next;
+
+	*prev = &head->next;
+	node = MS_ATOMIC_LOAD(*prev);
+	while (MS_ADDRCK(node)) {
+		next = MS_ATOMIC_LOAD(&node->next);
+		if (DICT_LF_MARKED(next)) {
+			if (0 != epoch_reserve(1)) {
+				return (-1);
+			}
+			*cur = node;
+			if (MS_ATOMIC_CAS(*prev, cur, DICT_LF_PTR(next))) {
+				epoch_retire(node, &__dict_lf_dealloc);
+				node = DICT_LF_PTR(next);
+			} else {
+				*prev = &head->next;
+				node = MS_ATOMIC_LOAD(*prev);
+			}
+		} else if (__dict_lf_match(node, order, key, key_len, f_compare)) {
+			*cur = node;
+			return (1);
+		} else if (node->order > order) {
+			*cur = node;
+			return (0);
+		} else {
+			*prev = &node->next;
+			node = next;
+		}
+	}
+	*cur = NULL;
+	return (0);
+}
+
+/*
+ * Chain `node` from `head`: an element after the ones of the same
+ * order, a bucket unless it is already there.
+ * Returns the node chained or found, NULL on failure
+*/
+static inline
+t_dict_lf_node * __dict_lf_link(
+	  t_dict_lf_node * head
+	, t_dict_lf_node * node
+) {
+	int               found;
+	t_dict_lf_node ** prev;
+	t_dict_lf_node  * cur;
+
+	found = 0;
+	while (0 == found) {
+		found = __dict_lf_find(head, node->order, NULL, 0, NULL, &prev, &cur);
+		if (0 == found) {
+			node->next = cur;
+			if (MS_ATOMIC_CAS(prev, &cur, node)) {
+				return (node);
+			}
+		}
+	}
+	return ((1 == found) ? cur : NULL);
+}
+
+/*
+ * Node of a bucket, created from its parent if needed
+*/
+static
+t_dict_lf_node * __dict_lf_bucket(
+	  t_dict_lf * dict
+	, size_t bucket
+);
+
+static inline
+t_dict_lf_node * __dict_lf_split(
+	  t_dict_lf * dict
+	, size_t bucket
+	, t_dict_lf_node ** slot
+) {
+	t_dict_lf_node * head;
+	t_dict_lf_node * node;
+	t_dict_lf_node * expected;
+
+	head = __dict_lf_bucket(dict, __dict_lf_parent(bucket));
+	if (MS_ADDRNULL(head)) {
+		return (NULL);
+	}
+	node = __dict_lf_node(NULL, 0, __dict_lf_reverse(bucket));
+	if (MS_ADDRNULL(node)) {
+		return (NULL);
+	}
+	head = __dict_lf_link(head, node);
+	if (head != node) {
+		MS_DEALLOC(node);
+	}
+	if (MS_ADDRCK(head)) {
+		expected = NULL;
+		MS_ATOMIC_CAS(slot, &expected, head);
+	}
+	return (head);
+}
+
+static
+t_dict_lf_node * __dict_lf_bucket(
+	  t_dict_lf * dict
+	, size_t bucket
+) {
+	t_dict_lf_node ** slot;
+	t_dict_lf_node  * head;
+
+	slot = __dict_lf_slot(dict, bucket, 1);
+	if (MS_ADDRNULL(slot)) {
+		return (NULL);
+	}
+	head = MS_ATOMIC_LOAD(slot);
+	if (MS_ADDRNULL(head)) {
+		head = __dict_lf_split(dict, bucket, slot);
+	}
+	return (head);
+}
+
+/*
+ * Closest bucket created, without writing anything
+*/
+static inline
+t_dict_lf_node * __dict_lf_head(
+	  t_dict_lf * dict
+	, size_t bucket
+) {
+	t_dict_lf_node ** slot;
+	t_dict_lf_node  * head;
+
+	head = NULL;
+	while (MS_ADDRNULL(head)) {
+		slot = __dict_lf_slot(dict, bucket, 0);
+		if (MS_ADDRCK(slot)) {
+			head = MS_ATOMIC_LOAD(slot);
+		}
+		bucket = __dict_lf_parent(bucket);
+	}
+	return (head);
+}
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+int dict_lf_init(
+	  t_dict_lf ** dict
+	, size_t size
+	, size_t (*f_hash)(unsigned char * key, size_t key_len)
+) {
+	if (
+		   MS_ADDRNULL(dict)
+		|| 0 == size
+		|| MS_ADDRNULL(f_hash)
+	) {
+		return (1);
+	}
+	*dict = MS_CAST(t_dict_lf *, MS_ALLOC_ALIGN(MS_CACHE_LINE, sizeof(t_dict_lf)));
+	if (MS_ADDRNULL(*dict)) {
+		return (1);
+	}
+	MS_MEMSET(*dict, 0, sizeof(t_dict_lf));
+	(*dict)->size   = hash_round_size(size);
+	(*dict)->f_hash = f_hash;
+	(*dict)->segments[0] = MS_CAST(t_dict_lf_node **, MS_ALLOC(sizeof(t_dict_lf_node *)));
+	if (MS_ADDRCK((*dict)->segments[0])) {
+		(*dict)->segments[0][0] = __dict_lf_node(NULL, 0, 0);
+		if (MS_ADDRCK((*dict)->segments[0][0])) {
+			return (0);
+		}
+		MS_DEALLOC((*dict)->segments[0]);
+	}
+	MS_DEALLOC(*dict);
+	*dict = NULL;
+	return (1);
+}
+
+void dict_lf_destroy(
+	  t_dict_lf * dict
+	, void (*f_free)(void * data)
+) {
+	size_t           i;
+	t_dict_lf_node * node;
+	t_dict_lf_node * next;
+
+	if (MS_ADDRCK(dict)) {
+		node = dict->segments[0][0];
+		while (MS_ADDRCK(node)) {
+			next = node->next;
+			if (
+				   0 != (node->order & 1)
+				&& !DICT_LF_MARKED(next)
+				&& MS_ADDRCK(f_free)
+			) {
+				f_free(node->data);
+			}
+			MS_DEALLOC(node);
+			node = DICT_LF_PTR(next);
+		}
+		i = 0;
+		while (i < DICT_LF_SEGMENTS) {
+			MS_DEALLOC(dict->segments[i]);
+			++i;
+		}
+		MS_DEALLOC(dict);
+	}
+}
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+size_t dict_lf_size(const t_dict_lf * dict)
+{
+	if (MS_ADDRCK(dict)) {
+		return (MS_ATOMIC_LOAD(&dict->count));
+	}
+	return (0);
+}
+
+int dict_lf_insert(
+	  t_dict_lf * dict
+	, void * data
+	, size_t size
+	, unsigned char * key
+	, size_t key_len
+) {
+	int              ret;
+	size_t           hash;
+	size_t           buckets;
+	t_dict_lf_node * head;
+	t_dict_lf_node * node;
+
+	if (
+		   MS_ADDRNULL(dict)
+		|| MS_ADDRNULL(key)
+	) {
+		return (1);
+	}
+	hash = dict->f_hash(key, key_len);
+	node = __dict_lf_node(data, size, __dict_lf_reverse(hash) | 1);
+	if (MS_ADDRNULL(node)) {
+		return (1);
+	}
+	ret = 1;
+	if (0 == epoch_enter()) {
+		buckets = MS_ATOMIC_LOAD(&dict->size);
+		head = __dict_lf_bucket(dict, hash & (buckets - 1));
+		if (
+			   MS_ADDRCK(head)
+			&& node == __dict_lf_link(head, node)
+		) {
+			if (
+				   MS_ATOMIC_INC(&dict->count) > buckets * DICT_LF_LOAD
+				&& buckets < (~MS_CAST(size_t, 0) >> 1)
+			) {
+				MS_ATOMIC_CAS(&dict->size, &buckets, buckets << 1);
+			}
+			ret = 0;
+		}
+		epoch_exit();
+	}
+	if (0 != ret) {
+		if (0 != size) {
+			MS_DEALLOC(node->data);
+		}
+		MS_DEALLOC(node);
+	}
+	return (ret);
+}
+
+void * dict_lf_search(
+	  t_dict_lf * dict
+	, unsigned char * key
+	, size_t key_len
+	, int (*f_compare)(void * data, unsigned char * key, size_t key_len)
+) {
+	size_t           hash;
+	size_t           order;
+	void           * data;
+	t_dict_lf_node * node;
+
+	if (
+		   MS_ADDRNULL(dict)
+		|| MS_ADDRNULL(key)
+		|| MS_ADDRNULL(f_compare)
+	) {
+		return (NULL);
+	}
+	hash = dict->f_hash(key, key_len);
+	order = __dict_lf_reverse(hash) | 1;
+	data = NULL;
+	if (0 == epoch_enter()) {
+		node = __dict_lf_head(dict, hash & (MS_ATOMIC_LOAD(&dict->size) - 1));
+		node = DICT_LF_PTR(MS_ATOMIC_LOAD(&node->next));
+		while (
+			   MS_ADDRCK(node)
+			&& (
+				   node->order < order
+				|| (
+					   node->order == order
+					&& (
+						   DICT_LF_MARKED(MS_ATOMIC_LOAD(&node->next))
+						|| 0 != f_compare(node->data, key, key_len)
+					)
+				)
+			)
+		) {
+			node = DICT_LF_PTR(MS_ATOMIC_LOAD(&node->next));
+		}
+		if (
+			   MS_ADDRCK(node)
+			&& node->order == order
+		) {
+			data = node->data;
+		}
+		epoch_exit();
+	}
+	return (data);
+}
+
+int dict_lf_remove(
+	  t_dict_lf * dict
+	, unsigned char * key
+	, size_t key_len
+	, int (*f_compare)(void * data, unsigned char * key, size_t key_len)
+	, void (*f_free)(void * data)
+) {
+	int               ret;
+	int               found;
+	size_t            hash;
+	size_t            order;
+	t_dict_lf_node ** prev;
+	t_dict_lf_node  * cur;
+	t_dict_lf_node  * next;
+	t_dict_lf_node  * head;
+	t_dict_lf_node  * expected;
+
+	if (
+		   MS_ADDRNULL(dict)
+		|| MS_ADDRNULL(key)
+		|| MS_ADDRNULL(f_compare)
+	) {
+		return (1);
+	}
+	hash = dict->f_hash(key, key_len);
+	order = __dict_lf_reverse(hash) | 1;
+	ret = 1;
+	if (0 == epoch_enter()) {
+		head = __dict_lf_bucket(dict, hash & (MS_ATOMIC_LOAD(&dict->size) - 1));
+		found = MS_ADDRCK(head);
+		while (
+			   1 == found
+			&& 0 != ret
+		) {
+			found = __dict_lf_find(head, order, key, key_len, f_compare, &prev, &cur);
+			if (
+				   1 == found
+				&& 0 != epoch_reserve(2)
+			) {
+				found = -1;
+			}
+			next = (1 == found) ? MS_ATOMIC_LOAD(&cur->next) : NULL;
+			if (
+				   1 == found
+				&& !DICT_LF_MARKED(next)
+				&& MS_ATOMIC_CAS(
+					  &cur->next
+					, &next
+					, MS_CAST(t_dict_lf_node *, (MS_CAST(size_t, next) | DICT_LF_MARK))
+				)
+			) {
+				if (MS_ADDRCK(f_free)) {
+					epoch_retire(cur->data, f_free);
+				}
+				MS_ATOMIC_DEC(&dict->count);
+				expected = cur;
+				if (MS_ATOMIC_CAS(prev, &expected, next)) {
+					epoch_retire(cur, &__dict_lf_dealloc);
+				} else {
+					__dict_lf_find(head, order, NULL, 0, NULL, &prev, &cur);
+				}
+				ret = 0;
+			}
+		}
+		epoch_exit();
+	}
+	return (ret);
+}
+
+int dict_lf_foreach(
+	  t_dict_lf * dict
+	, void ** content
+	, int (*f_fct)(void * data, void ** content)
+) {
+	int              ret;
+	t_dict_lf_node * node;
+	t_dict_lf_node * next;
+
+	ret = 0;
+	if (
+		   MS_ADDRCK(dict)
+		&& MS_ADDRCK(f_fct)
+	) {
+		if (0 != epoch_enter()) {
+			return (1);
+		}
+		node = MS_ATOMIC_LOAD(&dict->segments[0][0]->next);
+		while (
+			   0 == ret
+			&& MS_ADDRCK(node)
+		) {
+			next = MS_ATOMIC_LOAD(&node->next);
+			if (
+				   0 != (node->order & 1)
+				&& !DICT_LF_MARKED(next)
+			) {
+				ret = f_fct(node->data, content);
+			}
+			node = DICT_LF_PTR(next);
+		}
+		epoch_exit();
+	}
+	return (ret);
+}
+
+/* EOF */
\ No newline at end of file
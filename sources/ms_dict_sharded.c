@@ -0,0 +1,215 @@
+# include <ms_dict_sharded.h>
+# include <pthread.h>
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+/*
+ * One shard per cache line, so that the locks of two shards
+ * never share a line between cores
+*/
+typedef struct s_dict_shard
+{
+	pthread_rwlock_t   lock;
+	t_dict           * dict;
+} MS_ALIGNED(MS_CACHE_LINE) t_dict_shard;
+
+/*
+ * The shard of a hash is `hash >> (shift + 1)`, its high bits.
+ * The shift is split in two so that a single shard shifts by 64
+*/
+struct s_dict_sh
+{
+	size_t         count;
+	size_t         shift;
+	size_t         (*f_hash)(unsigned char * key, size_t key_len);
+	t_dict_shard * shards;
+};
+
+/*--------------------------------- PRIVATE METHODS ---------------------------------*/
+
+static inline
+t_dict_shard * __dict_sh_shard(
+	  const t_dict_sh * dict
+	, size_t hash
+) {
+	return (dict->shards + ((hash >> dict->shift) >> 1));
+}
+
+static inline
+void __dict_sh_release(
+	  t_dict_sh * dict
+	, size_t count
+	, void (*f_free)(void * data)
+) {
+	size_t i;
+
+	i = 0;
+	while (i < count) {
+		dict_destroy(dict->shards[i].dict, f_free);
+		pthread_rwlock_destroy(&dict->shards[i].lock);
+		++i;
+	}
+	MS_DEALLOC(dict->shards);
+	MS_DEALLOC(dict);
+}
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+int dict_sh_init(
+	  t_dict_sh ** dict
+	, size_t shards
+	, size_t size
+	, size_t (*f_hash)(unsigned char * key, size_t key_len)
+) {
+	size_t i;
+
+	if (
+		   MS_ADDRNULL(dict)
+		|| 0 == shards
+		|| 0 == size
+		|| MS_ADDRNULL(f_hash)
+	) {
+		return (1);
+	}
+	*dict = MS_CAST(t_dict_sh *, MS_ALLOC(sizeof(t_dict_sh)));
+	if (MS_ADDRNULL(*dict)) {
+		return (1);
+	}
+	(*dict)->count  = 1;
+	(*dict)->shift  = sizeof(size_t) * 8 - 1;
+	(*dict)->f_hash = f_hash;
+	while ((*dict)->count < shards) {
+		(*dict)->count <<= 1;
+		--(*dict)->shift;
+	}
+	(*dict)->shards = MS_CAST(t_dict_shard *, MS_ALLOC_ALIGN(
+		  MS_CACHE_LINE
+		, (*dict)->count * sizeof(t_dict_shard)
+	));
+	if (MS_ADDRNULL((*dict)->shards)) {
+		MS_DEALLOC(*dict);
+		*dict = NULL;
+		return (1);
+	}
+	size = (size + (*dict)->count - 1) / (*dict)->count;
+	i = 0;
+	while (i < (*dict)->count) {
+		if (0 != dict_init(&(*dict)->shards[i].dict, size, f_hash)) {
+			__dict_sh_release(*dict, i, NULL);
+			*dict = NULL;
+			return (1);
+		}
+		pthread_rwlock_init(&(*dict)->shards[i].lock, NULL);
+		++i;
+	}
+	return (0);
+}
+
+void dict_sh_destroy(
+	  t_dict_sh * dict
+	, void (*f_free)(void * data)
+) {
+	if (MS_ADDRCK(dict)) {
+		__dict_sh_release(dict, dict->count, f_free);
+	}
+}
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+size_t dict_sh_size(t_dict_sh * dict)
+{
+	size_t i;
+	size_t size;
+
+	size = 0;
+	if (MS_ADDRCK(dict)) {
+		i = 0;
+		while (i < dict->count) {
+			pthread_rwlock_rdlock(&dict->shards[i].lock);
+			size += dict_size(dict->shards[i].dict);
+			pthread_rwlock_unlock(&dict->shards[i].lock);
+			++i;
+		}
+	}
+	return (size);
+}
+
+int dict_sh_insert(
+	  t_dict_sh * dict
+	, void * data
+	, size_t size
+	, unsigned char * key
+	, size_t key_len
+) {
+	int            ret;
+	size_t         hash;
+	t_dict_shard * shard;
+
+	if (
+		   MS_ADDRNULL(dict)
+		|| MS_ADDRNULL(key)
+	) {
+		return (1);
+	}
+	hash = dict->f_hash(key, key_len);
+	shard = __dict_sh_shard(dict, hash);
+	pthread_rwlock_wrlock(&shard->lock);
+	ret = dict_insert_hashed(shard->dict, data, size, hash);
+	pthread_rwlock_unlock(&shard->lock);
+	return (ret);
+}
+
+void * dict_sh_search(
+	  t_dict_sh * dict
+	, unsigned char * key
+	, size_t key_len
+	, int flag
+	, int (*f_compare)(void * data, unsigned char * key, size_t key_len)
+) {
+	size_t         hash;
+	void         * data;
+	t_dict_shard * shard;
+
+	if (
+		   MS_ADDRNULL(dict)
+		|| MS_ADDRNULL(key)
+	) {
+		return (NULL);
+	}
+	hash = dict->f_hash(key, key_len);
+	shard = __dict_sh_shard(dict, hash);
+	if (MS_ELEMENT_REMOVE == flag) {
+		pthread_rwlock_wrlock(&shard->lock);
+	} else {
+		pthread_rwlock_rdlock(&shard->lock);
+	}
+	data = dict_search_hashed(shard->dict, hash, key, key_len, flag, f_compare);
+	pthread_rwlock_unlock(&shard->lock);
+	return (data);
+}
+
+int dict_sh_foreach(
+	  t_dict_sh * dict
+	, void ** content
+	, int (*f_fct)(void * data, void ** content)
+) {
+	int    ret;
+	size_t i;
+
+	ret = 0;
+	if (MS_ADDRCK(dict)) {
+		i = 0;
+		while (
+			   0 == ret
+			&& i < dict->count
+		) {
+			pthread_rwlock_rdlock(&dict->shards[i].lock);
+			ret = dict_foreach(dict->shards[i].dict, content, f_fct);
+			pthread_rwlock_unlock(&dict->shards[i].lock);
+			++i;
+		}
+	}
+	return (ret);
+}
+
+/* EOF */
\ No newline at end of file
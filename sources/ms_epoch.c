@@ -0,0 +1,378 @@
+# include <ms_epoch.h>
+# include <pthread.h>
+# include <sched.h>
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+typedef struct s_epoch_retired
+{
+	void * data;
+	void   (*f_free)(void * data);
+} t_epoch_retired;
+
+/*
+ * `epoch` is the global epoch when the last element was retired
+*/
+typedef struct s_epoch_batch
+{
+	struct s_epoch_batch * next;
+	size_t                 epoch;
+	size_t                 count;
+	t_epoch_retired        retired[MS_EPOCH_BATCH];
+} t_epoch_batch;
+
+/*
+ * One record per thread, on its own cache line: `epoch` is the global
+ * epoch seen when entering, shifted left, with its low bit set while
+ * inside. A batch of `limbo` retired in the epoch e is freed once the
+ * global epoch reaches e + 2, the threads inside having all left
+*/
+typedef struct s_epoch_thread
+{
+	size_t                  epoch;
+	size_t                  nesting;
+	size_t                  seen;
+	size_t                  retired;
+	size_t                  pending;
+	int                     used;
+	struct s_epoch_thread * next;
+	t_epoch_batch         * limbo;
+} MS_ALIGNED(MS_CACHE_LINE) t_epoch_thread;
+
+static size_t                    g_epoch MS_ALIGNED(MS_CACHE_LINE);
+static t_epoch_thread          * g_epoch_threads;
+static pthread_key_t             g_epoch_key;
+static pthread_once_t            g_epoch_once = PTHREAD_ONCE_INIT;
+static __thread t_epoch_thread * g_epoch_self;
+
+/*--------------------------------- PRIVATE METHODS ---------------------------------*/
+
+static
+void __epoch_dealloc(void * data)
+{
+	MS_DEALLOC(data);
+}
+
+static inline
+size_t __epoch_flush(t_epoch_batch * batch)
+{
+	size_t i;
+	size_t count;
+
+	i = 0;
+	count = batch->count;
+	while (i < count) {
+		batch->retired[i].f_free(batch->retired[i].data);
+		++i;
+	}
+	batch->count = 0;
+	return (count);
+}
+
+static inline
+size_t __epoch_free(t_epoch_batch * batch)
+{
+	size_t          count;
+	t_epoch_batch * next;
+
+	count = 0;
+	while (MS_ADDRCK(batch)) {
+		count += __epoch_flush(batch);
+		next = batch->next;
+		MS_DEALLOC(batch);
+		batch = next;
+	}
+	return (count);
+}
+
+/*
+ * Free the batches two epochs old, the most recent batch is only
+ * emptied so that a reservation made on it still holds
+*/
+static inline
+void __epoch_collect(
+	  t_epoch_thread * thread
+	, size_t epoch
+) {
+	t_epoch_batch ** limbo;
+
+	limbo = &thread->limbo;
+	while (
+		   MS_ADDRCK(*limbo)
+		&& (*limbo)->epoch + 2 > epoch
+	) {
+		limbo = &(*limbo)->next;
+	}
+	if (MS_ADDRCK(*limbo)) {
+		if (*limbo == thread->limbo) {
+			thread->pending -= __epoch_flush(thread->limbo);
+			thread->pending -= __epoch_free(thread->limbo->next);
+			thread->limbo->next = NULL;
+		} else {
+			thread->pending -= __epoch_free(*limbo);
+			*limbo = NULL;
+		}
+	}
+}
+
+/*
+ * The global epoch moves on once every thread inside has seen it
+*/
+static inline
+void __epoch_advance(void)
+{
+	size_t           epoch;
+	size_t           local;
+	t_epoch_thread * thread;
+
+	MS_ATOMIC_FENCE();
+	epoch = MS_ATOMIC_LOAD(&g_epoch);
+	thread = MS_ATOMIC_LOAD(&g_epoch_threads);
+	while (MS_ADDRCK(thread)) {
+		local = MS_ATOMIC_LOAD(&thread->epoch);
+		if (
+			   0 != (local & 1)
+			&& (local >> 1) != epoch
+		) {
+			return ;
+		}
+		thread = thread->next;
+	}
+	MS_ATOMIC_CAS(&g_epoch, &epoch, epoch + 1);
+}
+
+/*
+ * Grace period: every critical section entered before has been left
+*/
+static inline
+void __epoch_wait(void)
+{
+	size_t epoch;
+
+	epoch = MS_ATOMIC_LOAD(&g_epoch);
+	while (MS_ATOMIC_LOAD(&g_epoch) < epoch + 2) {
+		__epoch_advance();
+		if (MS_ATOMIC_LOAD(&g_epoch) < epoch + 2) {
+			sched_yield();
+		}
+	}
+}
+
+/*
+ * The record of an exited thread is kept, with its pending elements,
+ * for the next thread
+*/
+static
+void __epoch_release(void * data)
+{
+	t_epoch_thread * thread;
+
+	thread = MS_CAST(t_epoch_thread *, data);
+	__epoch_advance();
+	__epoch_collect(thread, MS_ATOMIC_LOAD(&g_epoch));
+	g_epoch_self = NULL;
+	MS_ATOMIC_STORE(&thread->used, 0);
+}
+
+static
+void __epoch_key(void)
+{
+	pthread_key_create(&g_epoch_key, &__epoch_release);
+}
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+int epoch_register(void)
+{
+	int              used;
+	t_epoch_thread * thread;
+
+	if (MS_ADDRCK(g_epoch_self)) {
+		return (0);
+	}
+	pthread_once(&g_epoch_once, &__epoch_key);
+	thread = MS_ATOMIC_LOAD(&g_epoch_threads);
+	while (
+		   MS_ADDRCK(thread)
+		&& MS_ADDRNULL(g_epoch_self)
+	) {
+		used = 0;
+		if (MS_ATOMIC_CAS(&thread->used, &used, 1)) {
+			g_epoch_self = thread;
+		}
+		thread = thread->next;
+	}
+	if (MS_ADDRNULL(g_epoch_self)) {
+		thread = MS_CAST(t_epoch_thread *, MS_ALLOC_ALIGN(MS_CACHE_LINE, sizeof(t_epoch_thread)));
+		if (MS_ADDRNULL(thread)) {
+			return (1);
+		}
+		MS_MEMSET(thread, 0, sizeof(t_epoch_thread));
+		thread->used = 1;
+		thread->seen = MS_ATOMIC_LOAD(&g_epoch);
+		thread->next = MS_ATOMIC_LOAD(&g_epoch_threads);
+		while (0 == MS_ATOMIC_CAS(&g_epoch_threads, &thread->next, thread)) {
+		}
+		g_epoch_self = thread;
+	}
+	pthread_setspecific(g_epoch_key, g_epoch_self);
+	return (0);
+}
+
+void epoch_unregister(void)
+{
+	t_epoch_thread * thread;
+
+	thread = g_epoch_self;
+	if (
+		   MS_ADDRCK(thread)
+		&& 0 == thread->nesting
+	) {
+		pthread_setspecific(g_epoch_key, NULL);
+		__epoch_release(thread);
+	}
+}
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+int epoch_enter(void)
+{
+	size_t           epoch;
+	t_epoch_thread * thread;
+
+	if (
+		   MS_ADDRNULL(g_epoch_self)
+		&& 0 != epoch_register()
+	) {
+		return (1);
+	}
+	thread = g_epoch_self;
+	if (0 == thread->nesting++) {
+		epoch = MS_ATOMIC_LOAD(&g_epoch);
+		MS_ATOMIC_STORE(&thread->epoch, (epoch << 1) | 1);
+		MS_ATOMIC_FENCE();
+		if (epoch != thread->seen) {
+			thread->seen = epoch;
+			__epoch_collect(thread, epoch);
+		}
+	}
+	return (0);
+}
+
+void epoch_exit(void)
+{
+	t_epoch_thread * thread;
+
+	thread = g_epoch_self;
+	if (
+		   MS_ADDRCK(thread)
+		&& 0 != thread->nesting
+		&& 0 == --thread->nesting
+	) {
+		MS_ATOMIC_STORE(&thread->epoch, MS_CAST(size_t, 0));
+	}
+}
+
+int epoch_reserve(size_t count)
+{
+	t_epoch_batch  * batch;
+	t_epoch_thread * thread;
+
+	if (
+		   count > MS_EPOCH_BATCH
+		|| (
+			   MS_ADDRNULL(g_epoch_self)
+			&& 0 != epoch_register()
+		)
+	) {
+		return (1);
+	}
+	thread = g_epoch_self;
+	if (
+		   MS_ADDRNULL(thread->limbo)
+		|| thread->limbo->count + count > MS_EPOCH_BATCH
+	) {
+		batch = MS_CAST(t_epoch_batch *, MS_ALLOC(sizeof(t_epoch_batch)));
+		if (MS_ADDRNULL(batch)) {
+			return (1);
+		}
+		batch->next   = thread->limbo;
+		batch->epoch  = MS_ATOMIC_LOAD(&g_epoch);
+		batch->count  = 0;
+		thread->limbo = batch;
+	}
+	return (0);
+}
+
+int epoch_retire(
+	  void * data
+	, void (*f_free)(void * data)
+) {
+	t_epoch_batch  * batch;
+	t_epoch_thread * thread;
+
+	if (
+		   MS_ADDRNULL(f_free)
+		|| 0 != epoch_reserve(1)
+	) {
+		return (1);
+	}
+	thread = g_epoch_self;
+	batch = thread->limbo;
+	batch->epoch = MS_ATOMIC_LOAD(&g_epoch);
+	batch->retired[batch->count].data   = data;
+	batch->retired[batch->count].f_free = f_free;
+	++batch->count;
+	++thread->pending;
+	if (++thread->retired >= MS_EPOCH_BATCH) {
+		thread->retired = 0;
+		__epoch_advance();
+		__epoch_collect(thread, MS_ATOMIC_LOAD(&g_epoch));
+		if (
+			   0 == thread->nesting
+			&& thread->pending >= MS_EPOCH_LIMIT
+		) {
+			epoch_synchronize();
+		}
+	}
+	return (0);
+}
+
+void epoch_free(void * data)
+{
+	if (
+		   0 != epoch_retire(data, &__epoch_dealloc)
+		&& (
+			   MS_ADDRNULL(g_epoch_self)
+			|| 0 == g_epoch_self->nesting
+		)
+	) {
+		__epoch_wait();
+		MS_DEALLOC(data);
+	}
+}
+
+void epoch_synchronize(void)
+{
+	t_epoch_thread * thread;
+
+	thread = g_epoch_self;
+	if (
+		   MS_ADDRCK(thread)
+		&& 0 == thread->nesting
+		&& 0 != thread->pending
+	) {
+		__epoch_wait();
+		__epoch_collect(thread, MS_ATOMIC_LOAD(&g_epoch));
+	}
+}
+
+size_t epoch_pending(void)
+{
+	if (MS_ADDRCK(g_epoch_self)) {
+		return (g_epoch_self->pending);
+	}
+	return (0);
+}
+
+/* EOF */
\ No newline at end of file
@@ -0,0 +1,96 @@
+# include <ms_futex.h>
+# include <sched.h>
+# ifdef __linux__
+#  include <errno.h>
+#  include <linux/futex.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+# endif
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+const struct timespec * futex_deadline(
+	  struct timespec * deadline
+	, long timeout
+) {
+	if (
+		   MS_ADDRNULL(deadline)
+		|| timeout < 0
+	) {
+		return (NULL);
+	}
+	clock_gettime(CLOCK_MONOTONIC, deadline);
+	deadline->tv_sec  += timeout / 1000;
+	deadline->tv_nsec += (timeout % 1000) * 1000000;
+	if (deadline->tv_nsec >= 1000000000) {
+		deadline->tv_nsec -= 1000000000;
+		++deadline->tv_sec;
+	}
+	return (deadline);
+}
+
+/*
+ * The deadline is absolute on the monotonic clock (FUTEX_WAIT_BITSET),
+ * so that waking up spuriously never extends it
+*/
+int futex_wait(
+	  int * addr
+	, int expected
+	, const struct timespec * deadline
+) {
+	size_t          spin;
+# ifndef __linux__
+	struct timespec now;
+# endif
+
+	spin = 0;
+	while (
+		   spin < MS_FUTEX_SPIN
+		&& expected == MS_ATOMIC_LOAD(addr)
+	) {
+		MS_CPU_RELAX();
+		++spin;
+	}
+	if (expected != MS_ATOMIC_LOAD(addr)) {
+		return (0);
+	}
+# ifdef __linux__
+	if (
+		   -1 == syscall(SYS_futex, addr, FUTEX_WAIT_BITSET_PRIVATE, expected, deadline, NULL, FUTEX_BITSET_MATCH_ANY)
+		&& ETIMEDOUT == errno
+	) {
+		return (1);
+	}
+# else
+	sched_yield();
+	if (MS_ADDRCK(deadline)) {
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		if (
+			   now.tv_sec > deadline->tv_sec
+			|| (
+				   now.tv_sec == deadline->tv_sec
+				&& now.tv_nsec >= deadline->tv_nsec
+			)
+		) {
+			return (1);
+		}
+	}
+# endif
+	return (0);
+}
+
+void futex_wake(
+	  int * addr
+	, int count
+) {
+# ifdef __linux__
+	if (0 < count) {
+		syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+	}
+# else
+	MS_UNUSED(addr);
+	MS_UNUSED(count);
+# endif
+}
+
+/* EOF */
\ No newline at end of file
@@ -0,0 +1,440 @@
+# include <ms_hazard.h>
+# include <pthread.h>
+# include <sched.h>
+# include <stdint.h>
+# ifdef __linux__
+#  include <linux/membarrier.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+# endif
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+typedef struct s_hazard_retired
+{
+	void * data;
+	void   (*f_free)(void * data);
+} t_hazard_retired;
+
+/*
+ * One record per thread, on its own cache line. `scratch` receives the
+ * slots of every thread, sorted, while scanning
+*/
+typedef struct s_hazard_thread
+{
+	void                    * hazards[MS_HAZARD_SLOTS];
+	int                       used;
+	struct s_hazard_thread  * next;
+	size_t                    count;
+	size_t                    capacity;
+	t_hazard_retired        * retired;
+	size_t                    scratch_size;
+	void                   ** scratch;
+} MS_ALIGNED(MS_CACHE_LINE) t_hazard_thread;
+
+static t_hazard_thread          * g_hazard_threads MS_ALIGNED(MS_CACHE_LINE);
+static int                        g_hazard_membarrier;
+static pthread_key_t              g_hazard_key;
+static pthread_once_t             g_hazard_once = PTHREAD_ONCE_INIT;
+static __thread t_hazard_thread * g_hazard_self;
+
+/*--------------------------------- PRIVATE METHODS ---------------------------------*/
+
+static
+void __hazard_dealloc(void * data)
+{
+	MS_DEALLOC(data);
+}
+
+static
+int __hazard_compare(
+	  const void * a
+	, const void * b
+) {
+	size_t x;
+	size_t y;
+
+	x = MS_CAST(size_t, *MS_CAST(void * const *, a));
+	y = MS_CAST(size_t, *MS_CAST(void * const *, b));
+	return ((x > y) - (x < y));
+}
+
+/*
+ * Paired with __hazard_barrier: with membarrier, the fence of a reader
+ * is forced by the scanning thread, the compiler must only keep the
+ * store of the slot before the load checking it
+*/
+static inline
+void __hazard_fence(void)
+{
+	if (0 != g_hazard_membarrier) {
+		MS_COMPILER_FENCE();
+	} else {
+		MS_ATOMIC_FENCE();
+	}
+}
+
+static inline
+void __hazard_barrier(void)
+{
+# ifdef __linux__
+	if (
+		   0 != g_hazard_membarrier
+		&& 0 == syscall(__NR_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0)
+	) {
+		return ;
+	}
+# endif
+	MS_ATOMIC_FENCE();
+}
+
+/*
+ * Whether a slot of another thread than `self` holds `data`
+*/
+static inline
+int __hazard_held(
+	  t_hazard_thread * self
+	, void * data
+) {
+	size_t            i;
+	t_hazard_thread * thread;
+
+	thread = MS_ATOMIC_LOAD(&g_hazard_threads);
+	while (MS_ADDRCK(thread)) {
+		i = 0;
+		while (
+			   thread != self
+			&& i < MS_HAZARD_SLOTS
+		) {
+			if (data == MS_ATOMIC_LOAD(&thread->hazards[i])) {
+				return (1);
+			}
+			++i;
+		}
+		thread = thread->next;
+	}
+	return (0);
+}
+
+/*
+ * Copy the slots in use of every thread, sorted. The records are only
+ * ever pushed at the head, so that the list read once cannot grow.
+ * Returns SIZE_MAX when the scratch cannot hold them
+*/
+static inline
+size_t __hazard_snapshot(t_hazard_thread * self)
+{
+	size_t            i;
+	size_t            size;
+	void            * data;
+	t_hazard_thread * head;
+	t_hazard_thread * thread;
+
+	head = MS_ATOMIC_LOAD(&g_hazard_threads);
+	size = 0;
+	thread = head;
+	while (MS_ADDRCK(thread)) {
+		size += MS_HAZARD_SLOTS;
+		thread = thread->next;
+	}
+	if (size > self->scratch_size) {
+		MS_DEALLOC(self->scratch);
+		self->scratch = MS_CAST(void **, MS_ALLOC(size * sizeof(void *)));
+		self->scratch_size = MS_ADDRCK(self->scratch) ? size : 0;
+		if (MS_ADDRNULL(self->scratch)) {
+			return (SIZE_MAX);
+		}
+	}
+	size = 0;
+	thread = head;
+	while (MS_ADDRCK(thread)) {
+		i = 0;
+		while (i < MS_HAZARD_SLOTS) {
+			data = MS_ATOMIC_LOAD(&thread->hazards[i]);
+			if (MS_ADDRCK(data)) {
+				self->scratch[size++] = data;
+			}
+			++i;
+		}
+		thread = thread->next;
+	}
+	qsort(self->scratch, size, sizeof(void *), &__hazard_compare);
+	return (size);
+}
+
+/*
+ * Free every element retired by `self` that no slot holds, the others
+ * are moved to the front of the array
+*/
+static inline
+void __hazard_scan(t_hazard_thread * self)
+{
+	size_t             i;
+	size_t             kept;
+	size_t             size;
+	t_hazard_retired * retired;
+
+	if (0 == self->count) {
+		return ;
+	}
+	__hazard_barrier();
+	size = __hazard_snapshot(self);
+	retired = self->retired;
+	kept = 0;
+	i = 0;
+	while (i < self->count) {
+		if (
+			   (
+				   SIZE_MAX != size
+				&& MS_ADDRCK(bsearch(&retired[i].data, self->scratch, size, sizeof(void *), &__hazard_compare))
+			)
+			|| (
+				   SIZE_MAX == size
+				&& 0 != __hazard_held(NULL, retired[i].data)
+			)
+		) {
+			retired[kept++] = retired[i];
+		} else {
+			retired[i].f_free(retired[i].data);
+		}
+		++i;
+	}
+	self->count = kept;
+}
+
+/*
+ * The array is doubled while more than half of it is still held after
+ * a scan, so that a scan always frees as many elements as it keeps
+*/
+static inline
+void __hazard_grow(t_hazard_thread * self)
+{
+	size_t             capacity;
+	t_hazard_retired * retired;
+
+	capacity = (0 == self->capacity) ? MS_HAZARD_BATCH : 2 * self->capacity;
+	retired = MS_CAST(t_hazard_retired *, MS_ALLOC(capacity * sizeof(t_hazard_retired)));
+	if (MS_ADDRNULL(retired)) {
+		return ;
+	}
+	if (0 != self->count) {
+		MS_MEMCPY(retired, self->retired, self->count * sizeof(t_hazard_retired));
+	}
+	MS_DEALLOC(self->retired);
+	self->retired = retired;
+	self->capacity = capacity;
+}
+
+/*
+ * The record of an exited thread is kept, with its pending elements,
+ * for the next thread
+*/
+static
+void __hazard_release(void * data)
+{
+	size_t            i;
+	t_hazard_thread * thread;
+
+	thread = MS_CAST(t_hazard_thread *, data);
+	i = 0;
+	while (i < MS_HAZARD_SLOTS) {
+		MS_ATOMIC_STORE(&thread->hazards[i], NULL);
+		++i;
+	}
+	__hazard_scan(thread);
+	g_hazard_self = NULL;
+	MS_ATOMIC_STORE(&thread->used, 0);
+}
+
+static
+void __hazard_key(void)
+{
+	pthread_key_create(&g_hazard_key, &__hazard_release);
+# ifdef __linux__
+	if (
+		   0 < syscall(__NR_membarrier, MEMBARRIER_CMD_QUERY, 0)
+		&& 0 == syscall(__NR_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0)
+	) {
+		g_hazard_membarrier = 1;
+	}
+# endif
+}
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+int hazard_register(void)
+{
+	int               used;
+	t_hazard_thread * thread;
+
+	if (MS_ADDRCK(g_hazard_self)) {
+		return (0);
+	}
+	pthread_once(&g_hazard_once, &__hazard_key);
+	thread = MS_ATOMIC_LOAD(&g_hazard_threads);
+	while (
+		   MS_ADDRCK(thread)
+		&& MS_ADDRNULL(g_hazard_self)
+	) {
+		used = 0;
+		if (MS_ATOMIC_CAS(&thread->used, &used, 1)) {
+			g_hazard_self = thread;
+		}
+		thread = thread->next;
+	}
+	if (MS_ADDRNULL(g_hazard_self)) {
+		thread = MS_CAST(t_hazard_thread *, MS_ALLOC_ALIGN(MS_CACHE_LINE, sizeof(t_hazard_thread)));
+		if (MS_ADDRNULL(thread)) {
+			return (1);
+		}
+		MS_MEMSET(thread, 0, sizeof(t_hazard_thread));
+		thread->used = 1;
+		thread->next = MS_ATOMIC_LOAD(&g_hazard_threads);
+		while (0 == MS_ATOMIC_CAS(&g_hazard_threads, &thread->next, thread)) {
+		}
+		g_hazard_self = thread;
+	}
+	pthread_setspecific(g_hazard_key, g_hazard_self);
+	return (0);
+}
+
+void hazard_unregister(void)
+{
+	t_hazard_thread * thread;
+
+	thread = g_hazard_self;
+	if (MS_ADDRCK(thread)) {
+		pthread_setspecific(g_hazard_key, NULL);
+		__hazard_release(thread);
+	}
+}
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+void * hazard_protect(
+	  size_t slot
+	, void ** addr
+) {
+	void            * data;
+	void            * check;
+	t_hazard_thread * thread;
+
+	if (
+		   slot >= MS_HAZARD_SLOTS
+		|| (
+			   MS_ADDRNULL(g_hazard_self)
+			&& 0 != hazard_register()
+		)
+	) {
+		return (NULL);
+	}
+	thread = g_hazard_self;
+	data = MS_ATOMIC_LOAD(addr);
+	MS_ATOMIC_STORE(&thread->hazards[slot], data);
+	__hazard_fence();
+	check = MS_ATOMIC_LOAD(addr);
+	while (data != check) {
+		data = check;
+		MS_ATOMIC_STORE(&thread->hazards[slot], data);
+		__hazard_fence();
+		check = MS_ATOMIC_LOAD(addr);
+	}
+	return (data);
+}
+
+int hazard_set(
+	  size_t slot
+	, void * data
+) {
+	if (
+		   slot >= MS_HAZARD_SLOTS
+		|| (
+			   MS_ADDRNULL(g_hazard_self)
+			&& 0 != hazard_register()
+		)
+	) {
+		return (1);
+	}
+	MS_ATOMIC_STORE(&g_hazard_self->hazards[slot], data);
+	__hazard_fence();
+	return (0);
+}
+
+void hazard_clear(size_t slot)
+{
+	if (
+		   slot < MS_HAZARD_SLOTS
+		&& MS_ADDRCK(g_hazard_self)
+	) {
+		MS_ATOMIC_STORE(&g_hazard_self->hazards[slot], NULL);
+	}
+}
+
+int hazard_retire(
+	  void * data
+	, void (*f_free)(void * data)
+) {
+	t_hazard_thread * thread;
+
+	if (
+		   MS_ADDRNULL(f_free)
+		|| (
+			   MS_ADDRNULL(g_hazard_self)
+			&& 0 != hazard_register()
+		)
+	) {
+		return (1);
+	}
+	thread = g_hazard_self;
+	if (thread->count == thread->capacity) {
+		__hazard_scan(thread);
+		if (
+			   0 == thread->capacity
+			|| thread->count > thread->capacity / 2
+		) {
+			__hazard_grow(thread);
+		}
+	}
+	if (thread->count == thread->capacity) {
+		__hazard_barrier();
+		while (0 != __hazard_held(thread, data)) {
+			sched_yield();
+			__hazard_barrier();
+		}
+		f_free(data);
+		return (0);
+	}
+	thread->retired[thread->count].data   = data;
+	thread->retired[thread->count].f_free = f_free;
+	++thread->count;
+	return (0);
+}
+
+void hazard_free(void * data)
+{
+	if (0 != hazard_retire(data, &__hazard_dealloc)) {
+		__hazard_barrier();
+		while (0 != __hazard_held(g_hazard_self, data)) {
+			sched_yield();
+			__hazard_barrier();
+		}
+		MS_DEALLOC(data);
+	}
+}
+
+void hazard_collect(void)
+{
+	if (MS_ADDRCK(g_hazard_self)) {
+		__hazard_scan(g_hazard_self);
+	}
+}
+
+size_t hazard_pending(void)
+{
+	if (MS_ADDRCK(g_hazard_self)) {
+		return (g_hazard_self->count);
+	}
+	return (0);
+}
+
+/* EOF */
\ No newline at end of file
@@ -0,0 +1,286 @@
+# include <ms_heap.h>
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+/*
+ * Children of a node
+*/
+# define HEAP_ARITY           4
+
+/*
+ * Slot of the root in the array: the children of the element i,
+ * 4i + 1 to 4i + 4, are then in the slots 4(i + 1) to 4(i + 1) + 3,
+ * 32 bytes aligned on 32 bytes, so always on one cache line
+*/
+# define HEAP_ROOT            (HEAP_ARITY - 1)
+
+# define HEAP_CAPACITY        16
+
+/*
+ * `datas` is `slots + HEAP_ROOT`, the element i being `datas[i]`
+*/
+struct s_heap
+{
+	size_t   size;
+	size_t   capacity;
+	int      (*f_compare)(void * elem, void * data);
+	void  ** slots;
+	void  ** datas;
+};
+
+/*--------------------------------- PRIVATE METHODS ---------------------------------*/
+
+/*
+ * Whether `data` is strictly smaller than `elem`, and goes above it
+*/
+static inline
+int __heap_before(
+	  const t_heap * heap
+	, void * data
+	, void * elem
+) {
+	return (heap->f_compare(elem, data) < 0);
+}
+
+static inline
+int __heap_reserve(
+	  t_heap * heap
+	, size_t count
+) {
+	size_t   capacity;
+	void  ** slots;
+
+	if (heap->size + count <= heap->capacity) {
+		return (0);
+	}
+	capacity = (0 == heap->capacity) ? HEAP_CAPACITY : heap->capacity;
+	while (capacity < heap->size + count) {
+		capacity <<= 1;
+	}
+	slots = MS_CAST(void **, MS_ALLOC_ALIGN(MS_CACHE_LINE, (HEAP_ROOT + capacity) * sizeof(void *)));
+	if (MS_ADDRNULL(slots)) {
+		return (1);
+	}
+	if (MS_ADDRCK(heap->slots)) {
+		MS_MEMCPY(slots + HEAP_ROOT, heap->datas, heap->size * sizeof(void *));
+		MS_DEALLOC(heap->slots);
+	}
+	heap->slots = slots;
+	heap->datas = slots + HEAP_ROOT;
+	heap->capacity = capacity;
+	return (0);
+}
+
+/*
+ * The element moves up as a hole, each parent moved down once
+*/
+static inline
+void __heap_sift_up(
+	  t_heap * heap
+	, size_t i
+) {
+	size_t   parent;
+	void   * data;
+
+	data = heap->datas[i];
+	while (
+		   0 != i
+		&& __heap_before(heap, data, heap->datas[(i - 1) / HEAP_ARITY])
+	) {
+		parent = (i - 1) / HEAP_ARITY;
+		heap->datas[i] = heap->datas[parent];
+		i = parent;
+	}
+	heap->datas[i] = data;
+}
+
+/*
+ * The children of the smallest child are prefetched while it is
+ * compared to the element
+*/
+static inline
+void __heap_sift_down(
+	  t_heap * heap
+	, size_t i
+) {
+	int      walk;
+	size_t   last;
+	size_t   child;
+	size_t   first;
+	void   * data;
+
+	data = heap->datas[i];
+	walk = 1;
+	while (walk) {
+		first = HEAP_ARITY * i + 1;
+		walk = (first < heap->size);
+		if (walk) {
+			last = first + HEAP_ARITY;
+			if (last > heap->size) {
+				last = heap->size;
+			}
+			child = first;
+			++first;
+			while (first < last) {
+				if (__heap_before(heap, heap->datas[first], heap->datas[child])) {
+					child = first;
+				}
+				++first;
+			}
+			MS_PREFETCH(&heap->datas[HEAP_ARITY * child + 1]);
+			walk = __heap_before(heap, heap->datas[child], data);
+			if (walk) {
+				heap->datas[i] = heap->datas[child];
+				i = child;
+			}
+		}
+	}
+	heap->datas[i] = data;
+}
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+int heap_init(
+	  t_heap ** heap
+	, size_t capacity
+	, int (*f_compare)(void * elem, void * data)
+) {
+	if (
+		   MS_ADDRNULL(heap)
+		|| MS_ADDRNULL(f_compare)
+	) {
+		return (1);
+	}
+	*heap = MS_CAST(t_heap *, MS_ALLOC(sizeof(t_heap)));
+	if (MS_ADDRNULL(*heap)) {
+		return (1);
+	}
+	MS_MEMSET(*heap, 0, sizeof(t_heap));
+	(*heap)->f_compare = f_compare;
+	if (0 != __heap_reserve(*heap, (0 == capacity) ? HEAP_CAPACITY : capacity)) {
+		MS_DEALLOC(*heap);
+		*heap = NULL;
+		return (1);
+	}
+	return (0);
+}
+
+void heap_destroy(
+	  t_heap * heap
+	, void (*f_free)(void * data)
+) {
+	size_t i;
+
+	if (MS_ADDRCK(heap)) {
+		if (MS_ADDRCK(f_free)) {
+			i = 0;
+			while (i < heap->size) {
+				f_free(heap->datas[i]);
+				++i;
+			}
+		}
+		MS_DEALLOC(heap->slots);
+		MS_DEALLOC(heap);
+	}
+}
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+size_t heap_size(const t_heap * heap)
+{
+	if (MS_ADDRCK(heap)) {
+		return (heap->size);
+	}
+	return (0);
+}
+
+void * heap_peek(const t_heap * heap)
+{
+	if (
+		   MS_ADDRCK(heap)
+		&& 0 != heap->size
+	) {
+		return (heap->datas[0]);
+	}
+	return (NULL);
+}
+
+int heap_push(
+	  t_heap * heap
+	, void * data
+	, size_t size
+) {
+	void * copy;
+
+	if (
+		   MS_ADDRNULL(heap)
+		|| MS_ADDRNULL(data)
+		|| 0 != __heap_reserve(heap, 1)
+	) {
+		return (1);
+	}
+	copy = data;
+	if (0 != size) {
+		copy = MS_ALLOC(size);
+		if (MS_ADDRNULL(copy)) {
+			return (1);
+		}
+		MS_MEMCPY(copy, data, size);
+	}
+	heap->datas[heap->size] = copy;
+	__heap_sift_up(heap, heap->size++);
+	return (0);
+}
+
+int heap_push_batch(
+	  t_heap * heap
+	, void ** datas
+	, size_t count
+) {
+	size_t i;
+
+	if (
+		   MS_ADDRNULL(heap)
+		|| MS_ADDRNULL(datas)
+		|| 0 != __heap_reserve(heap, count)
+	) {
+		return (1);
+	}
+	MS_MEMCPY(heap->datas + heap->size, datas, count * sizeof(void *));
+	if (count < heap->size) {
+		i = heap->size;
+		heap->size += count;
+		while (i < heap->size) {
+			__heap_sift_up(heap, i);
+			++i;
+		}
+	} else {
+		heap->size += count;
+		i = (heap->size + HEAP_ARITY - 2) / HEAP_ARITY;
+		while (0 != i) {
+			__heap_sift_down(heap, --i);
+		}
+	}
+	return (0);
+}
+
+void * heap_pop(t_heap * heap)
+{
+	void * data;
+
+	if (
+		   MS_ADDRNULL(heap)
+		|| 0 == heap->size
+	) {
+		return (NULL);
+	}
+	data = heap->datas[0];
+	--heap->size;
+	if (0 != heap->size) {
+		heap->datas[0] = heap->datas[heap->size];
+		__heap_sift_down(heap, 0);
+	}
+	return (data);
+}
+
+/* EOF */
\ No newline at end of file
@@ -0,0 +1,403 @@
+# include <ms_heap_pairing.h>
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+/*
+ * Nodes of a block
+*/
+# define HEAP_PA_BLOCK        128
+
+/*
+ * `prev` is the parent of the first child, the previous sibling of
+ * the others. A free node has no data, its `next` is the next free node
+*/
+struct s_heap_pa_node
+{
+	struct s_heap_pa_node * child;
+	struct s_heap_pa_node * next;
+	struct s_heap_pa_node * prev;
+	void                  * data;
+};
+
+/*
+ * The nodes first, so that two nodes share each cache line
+*/
+typedef struct s_heap_pa_block
+{
+	t_heap_pa_node           nodes[HEAP_PA_BLOCK];
+	struct s_heap_pa_block * next;
+} t_heap_pa_block;
+
+/*
+ * The tails of the blocks and of the free nodes let meld splice them
+*/
+struct s_heap_pa
+{
+	size_t            size;
+	t_heap_pa_node  * root;
+	t_heap_pa_node  * free;
+	t_heap_pa_node  * free_last;
+	t_heap_pa_block * blocks;
+	t_heap_pa_block * blocks_last;
+	int               (*f_compare)(void * elem, void * data);
+};
+
+/*--------------------------------- PRIVATE METHODS ---------------------------------*/
+
+/*
+ * A new block is threaded whole on the free nodes
+*/
+static inline
+t_heap_pa_node * __heap_pa_alloc(t_heap_pa * heap)
+{
+	size_t            i;
+	t_heap_pa_node  * node;
+	t_heap_pa_block * block;
+
+	if (MS_ADDRNULL(heap->free)) {
+		block = MS_CAST(t_heap_pa_block *, MS_ALLOC_ALIGN(MS_CACHE_LINE, sizeof(t_heap_pa_block)));
+		if (MS_ADDRNULL(block)) {
+			return (NULL);
+		}
+		MS_MEMSET(block, 0, sizeof(t_heap_pa_block));
+		i = 0;
+		while (i < HEAP_PA_BLOCK - 1) {
+			block->nodes[i].next = &block->nodes[i + 1];
+			++i;
+		}
+		block->next = heap->blocks;
+		if (MS_ADDRNULL(heap->blocks)) {
+			heap->blocks_last = block;
+		}
+		heap->blocks = block;
+		heap->free = &block->nodes[0];
+		heap->free_last = &block->nodes[HEAP_PA_BLOCK - 1];
+	}
+	node = heap->free;
+	heap->free = node->next;
+	if (MS_ADDRNULL(heap->free)) {
+		heap->free_last = NULL;
+	}
+	node->next = NULL;
+	return (node);
+}
+
+static inline
+void __heap_pa_release(
+	  t_heap_pa * heap
+	, t_heap_pa_node * node
+) {
+	node->child = NULL;
+	node->prev = NULL;
+	node->data = NULL;
+	node->next = heap->free;
+	if (MS_ADDRNULL(heap->free)) {
+		heap->free_last = node;
+	}
+	heap->free = node;
+}
+
+/*
+ * Two roots, the greater becomes the first child of the other,
+ * `b` on a tie
+*/
+static inline
+t_heap_pa_node * __heap_pa_link(
+	  const t_heap_pa * heap
+	, t_heap_pa_node * a
+	, t_heap_pa_node * b
+) {
+	t_heap_pa_node * swap;
+
+	if (MS_ADDRNULL(a)) {
+		return (b);
+	}
+	if (MS_ADDRNULL(b)) {
+		return (a);
+	}
+	if (heap->f_compare(a->data, b->data) < 0) {
+		swap = a;
+		a = b;
+		b = swap;
+	}
+	b->prev = a;
+	b->next = a->child;
+	if (MS_ADDRCK(a->child)) {
+		a->child->prev = b;
+	}
+	a->child = b;
+	a->next = NULL;
+	a->prev = NULL;
+	return (a);
+}
+
+/*
+ * Detach a node which is not the root, with its children
+*/
+static inline
+void __heap_pa_cut(t_heap_pa_node * node)
+{
+	if (node->prev->child == node) {
+		node->prev->child = node->next;
+	} else {
+		node->prev->next = node->next;
+	}
+	if (MS_ADDRCK(node->next)) {
+		node->next->prev = node->prev;
+	}
+	node->next = NULL;
+	node->prev = NULL;
+}
+
+/*
+ * Two-pass pairing of the children of a removed node: linked by pairs
+ * from the left, the pairs stacked, then linked from the right
+*/
+static inline
+t_heap_pa_node * __heap_pa_pairs(
+	  const t_heap_pa * heap
+	, t_heap_pa_node * first
+) {
+	t_heap_pa_node * a;
+	t_heap_pa_node * b;
+	t_heap_pa_node * pairs;
+
+	pairs = NULL;
+	while (MS_ADDRCK(first)) {
+		a = first;
+		b = a->next;
+		first = NULL;
+		if (MS_ADDRCK(b)) {
+			first = b->next;
+		}
+		a = __heap_pa_link(heap, a, b);
+		a->next = pairs;
+		pairs = a;
+	}
+	a = NULL;
+	while (MS_ADDRCK(pairs)) {
+		b = pairs;
+		pairs = b->next;
+		a = __heap_pa_link(heap, b, a);
+	}
+	if (MS_ADDRCK(a)) {
+		a->next = NULL;
+		a->prev = NULL;
+	}
+	return (a);
+}
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+int heap_pa_init(
+	  t_heap_pa ** heap
+	, int (*f_compare)(void * elem, void * data)
+) {
+	if (
+		   MS_ADDRNULL(heap)
+		|| MS_ADDRNULL(f_compare)
+	) {
+		return (1);
+	}
+	*heap = MS_CAST(t_heap_pa *, MS_ALLOC(sizeof(t_heap_pa)));
+	if (MS_ADDRNULL(*heap)) {
+		return (1);
+	}
+	MS_MEMSET(*heap, 0, sizeof(t_heap_pa));
+	(*heap)->f_compare = f_compare;
+	return (0);
+}
+
+/*
+ * The blocks are walked rather than the tree: a node in use has data
+*/
+void heap_pa_destroy(
+	  t_heap_pa * heap
+	, void (*f_free)(void * data)
+) {
+	size_t            i;
+	t_heap_pa_block * next;
+
+	if (MS_ADDRNULL(heap)) {
+		return ;
+	}
+	while (MS_ADDRCK(heap->blocks)) {
+		next = heap->blocks->next;
+		if (MS_ADDRCK(f_free)) {
+			i = 0;
+			while (i < HEAP_PA_BLOCK) {
+				if (MS_ADDRCK(heap->blocks->nodes[i].data)) {
+					f_free(heap->blocks->nodes[i].data);
+				}
+				++i;
+			}
+		}
+		MS_DEALLOC(heap->blocks);
+		heap->blocks = next;
+	}
+	MS_DEALLOC(heap);
+}
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+size_t heap_pa_size(const t_heap_pa * heap)
+{
+	if (MS_ADDRCK(heap)) {
+		return (heap->size);
+	}
+	return (0);
+}
+
+void * heap_pa_peek(const t_heap_pa * heap)
+{
+	if (
+		   MS_ADDRCK(heap)
+		&& MS_ADDRCK(heap->root)
+	) {
+		return (heap->root->data);
+	}
+	return (NULL);
+}
+
+void * heap_pa_data(const t_heap_pa_node * node)
+{
+	if (MS_ADDRCK(node)) {
+		return (node->data);
+	}
+	return (NULL);
+}
+
+int heap_pa_push(
+	  t_heap_pa * heap
+	, void * data
+	, size_t size
+	, t_heap_pa_node ** node
+) {
+	void           * copy;
+	t_heap_pa_node * elem;
+
+	if (
+		   MS_ADDRNULL(heap)
+		|| MS_ADDRNULL(data)
+	) {
+		return (1);
+	}
+	copy = data;
+	if (0 != size) {
+		copy = MS_ALLOC(size);
+		if (MS_ADDRNULL(copy)) {
+			return (1);
+		}
+		MS_MEMCPY(copy, data, size);
+	}
+	elem = __heap_pa_alloc(heap);
+	if (MS_ADDRNULL(elem)) {
+		if (0 != size) {
+			MS_DEALLOC(copy);
+		}
+		return (1);
+	}
+	elem->data = copy;
+	heap->root = __heap_pa_link(heap, heap->root, elem);
+	++heap->size;
+	if (MS_ADDRCK(node)) {
+		*node = elem;
+	}
+	return (0);
+}
+
+void * heap_pa_pop(t_heap_pa * heap)
+{
+	if (
+		   MS_ADDRNULL(heap)
+		|| MS_ADDRNULL(heap->root)
+	) {
+		return (NULL);
+	}
+	return (heap_pa_remove(heap, heap->root));
+}
+
+/*
+ * The subtree of the node stays under it: its keys are not smaller
+*/
+int heap_pa_decrease(
+	  t_heap_pa * heap
+	, t_heap_pa_node * node
+	, void * data
+) {
+	if (
+		   MS_ADDRNULL(heap)
+		|| MS_ADDRNULL(node)
+		|| MS_ADDRNULL(node->data)
+		|| MS_ADDRNULL(data)
+	) {
+		return (1);
+	}
+	node->data = data;
+	if (node != heap->root) {
+		__heap_pa_cut(node);
+		heap->root = __heap_pa_link(heap, heap->root, node);
+	}
+	return (0);
+}
+
+void * heap_pa_remove(
+	  t_heap_pa * heap
+	, t_heap_pa_node * node
+) {
+	void           * data;
+	t_heap_pa_node * children;
+
+	if (
+		   MS_ADDRNULL(heap)
+		|| MS_ADDRNULL(node)
+		|| MS_ADDRNULL(node->data)
+	) {
+		return (NULL);
+	}
+	data = node->data;
+	children = __heap_pa_pairs(heap, node->child);
+	if (node == heap->root) {
+		heap->root = children;
+	} else {
+		__heap_pa_cut(node);
+		heap->root = __heap_pa_link(heap, heap->root, children);
+	}
+	__heap_pa_release(heap, node);
+	--heap->size;
+	return (data);
+}
+
+int heap_pa_meld(
+	  t_heap_pa * heap
+	, t_heap_pa * other
+) {
+	if (
+		   MS_ADDRNULL(heap)
+		|| MS_ADDRNULL(other)
+		|| heap == other
+		|| heap->f_compare != other->f_compare
+	) {
+		return (1);
+	}
+	heap->root = __heap_pa_link(heap, heap->root, other->root);
+	heap->size += other->size;
+	if (MS_ADDRCK(other->free)) {
+		other->free_last->next = heap->free;
+		if (MS_ADDRNULL(heap->free)) {
+			heap->free_last = other->free_last;
+		}
+		heap->free = other->free;
+	}
+	if (MS_ADDRCK(other->blocks)) {
+		other->blocks_last->next = heap->blocks;
+		if (MS_ADDRNULL(heap->blocks)) {
+			heap->blocks_last = other->blocks_last;
+		}
+		heap->blocks = other->blocks;
+	}
+	MS_DEALLOC(other);
+	return (0);
+}
+
+/* EOF */
\ No newline at end of file
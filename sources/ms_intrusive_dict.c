@@ -0,0 +1,257 @@
+# include <ms_intrusive_dict.h>
+# include <ms_hash.h>
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+/*
+ * `size` is a power of two, the bucket of a hash is `hash & (size - 1)`
+*/
+struct s_idict
+{
+	size_t          size;
+	size_t          count;
+	size_t          (*f_hash)(unsigned char * key, size_t key_len);
+	t_idict_node ** content;
+};
+
+/*--------------------------------- PRIVATE METHODS ---------------------------------*/
+
+static inline
+void __idict_link(
+	  t_idict_node ** bucket
+	, t_idict_node * node
+) {
+	node->next = *bucket;
+	if (MS_ADDRCK(node->next)) {
+		node->next->pprev = &node->next;
+	}
+	node->pprev = bucket;
+	*bucket = node;
+}
+
+static inline
+void __idict_unlink(t_idict_node * node)
+{
+	*node->pprev = node->next;
+	if (MS_ADDRCK(node->next)) {
+		node->next->pprev = node->pprev;
+	}
+	node->next  = NULL;
+	node->pprev = NULL;
+}
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+int idict_init(
+	  t_idict ** dict
+	, size_t size
+	, size_t (*f_hash)(unsigned char * key, size_t key_len)
+) {
+	size_t content_size;
+
+	if (
+		   MS_ADDRCK(dict)
+		&& size > 0
+		&& MS_ADDRCK(f_hash)
+	) {
+		*dict = MS_CAST(t_idict *, MS_ALLOC(sizeof(t_idict)));
+		if (MS_ADDRCK(*dict)) {
+			MS_MEMSET(*dict, 0, sizeof(t_idict));
+			(*dict)->size    = hash_round_size(size);
+			(*dict)->f_hash  = f_hash;
+			content_size     = (*dict)->size * sizeof(t_idict_node *);
+			(*dict)->content = MS_CAST(t_idict_node **, MS_ALLOC(content_size));
+			if (MS_ADDRCK((*dict)->content)) {
+				MS_MEMSET((*dict)->content, 0, content_size);
+				return (0);
+			}
+			MS_DEALLOC(*dict);
+			*dict = NULL;
+		}
+	}
+	return (1);
+}
+
+void idict_destroy(
+	  t_idict * dict
+	, void (*f_free)(t_idict_node * node)
+) {
+	size_t         i;
+	t_idict_node * node;
+
+	if (MS_ADDRCK(dict)) {
+		i = 0;
+		while (i < dict->size) {
+			while (MS_ADDRCK(dict->content[i])) {
+				node = dict->content[i];
+				__idict_unlink(node);
+				if (MS_ADDRCK(f_free)) {
+					f_free(node);
+				}
+			}
+			++i;
+		}
+		MS_DEALLOC(dict->content);
+		MS_DEALLOC(dict);
+	}
+}
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+size_t idict_size(const t_idict * dict)
+{
+	if (MS_ADDRCK(dict)) {
+		return (dict->count);
+	}
+	return (0);
+}
+
+int idict_resize(
+	  t_idict * dict
+	, size_t size
+) {
+	size_t          i;
+	t_idict_node  * node;
+	t_idict_node  * reverse;
+	t_idict_node ** content;
+
+	if (
+		   MS_ADDRNULL(dict)
+		|| 0 == size
+	) {
+		return (1);
+	}
+	size = hash_round_size(size);
+	if (size == dict->size) {
+		return (0);
+	}
+	content = MS_CAST(t_idict_node **, MS_ALLOC(size * sizeof(t_idict_node *)));
+	if (MS_ADDRNULL(content)) {
+		return (1);
+	}
+	MS_MEMSET(content, 0, size * sizeof(t_idict_node *));
+	i = 0;
+	while (i < dict->size) {
+		reverse = NULL;
+		while (MS_ADDRCK(dict->content[i])) {
+			node = dict->content[i];
+			dict->content[i] = node->next;
+			node->next = reverse;
+			reverse = node;
+		}
+		/* Pushed back reversed, the hooks keep their relative order */
+		while (MS_ADDRCK(reverse)) {
+			node = reverse;
+			reverse = node->next;
+			__idict_link(content + (node->hash & (size - 1)), node);
+		}
+		++i;
+	}
+	MS_DEALLOC(dict->content);
+	dict->content = content;
+	dict->size    = size;
+	return (0);
+}
+
+int idict_insert(
+	  t_idict * dict
+	, t_idict_node * node
+	, unsigned char * key
+	, size_t key_len
+) {
+	if (
+		   MS_ADDRNULL(dict)
+		|| MS_ADDRNULL(node)
+		|| MS_ADDRNULL(key)
+	) {
+		return (1);
+	}
+	node->hash = dict->f_hash(key, key_len);
+	/* A failed growth only leaves longer chains */
+	if (dict->count >= dict->size) {
+		idict_resize(dict, dict->size << 1);
+	}
+	__idict_link(dict->content + (node->hash & (dict->size - 1)), node);
+	++dict->count;
+	return (0);
+}
+
+t_idict_node * idict_search(
+	  t_idict * dict
+	, unsigned char * key
+	, size_t key_len
+	, int (*f_compare)(t_idict_node * node, unsigned char * key, size_t key_len)
+) {
+	size_t         hash;
+	t_idict_node * node;
+
+	if (
+		   MS_ADDRCK(dict)
+		&& MS_ADDRCK(key)
+		&& MS_ADDRCK(f_compare)
+	) {
+		hash = dict->f_hash(key, key_len);
+		node = dict->content[hash & (dict->size - 1)];
+		while (MS_ADDRCK(node)) {
+			if (
+				   node->hash == hash
+				&& 0 == f_compare(node, key, key_len)
+			) {
+				return (node);
+			}
+			node = node->next;
+		}
+	}
+	return (NULL);
+}
+
+void idict_remove(
+	  t_idict * dict
+	, t_idict_node * node
+) {
+	if (
+		   MS_ADDRCK(dict)
+		&& MS_ADDRCK(node)
+		&& MS_ADDRCK(node->pprev)
+	) {
+		__idict_unlink(node);
+		--dict->count;
+	}
+}
+
+int idict_foreach(
+	  t_idict * dict
+	, void ** content
+	, int (*f_fct)(t_idict_node * node, void ** content)
+) {
+	int            ret;
+	size_t         i;
+	t_idict_node * node;
+	t_idict_node * next;
+
+	ret = 0;
+	if (
+		   MS_ADDRCK(dict)
+		&& MS_ADDRCK(f_fct)
+	) {
+		i = 0;
+		while (
+			   0 == ret
+			&& i < dict->size
+		) {
+			node = dict->content[i];
+			while (
+				   0 == ret
+				&& MS_ADDRCK(node)
+			) {
+				next = node->next;
+				ret = f_fct(node, content);
+				node = next;
+			}
+			++i;
+		}
+	}
+	return (ret);
+}
+
+/* EOF */
\ No newline at end of file
@@ -9,6 +9,26 @@ struct s_list_c
 	t_list_c * next;
 };
 
+/*--------------------------------- PRIVATE METHODS ---------------------------------*/
+
+/*
+ * Restore the `prev` links and close the ring once the nodes are
+ * chained by `next` alone
+*/
+static inline
+void __list_c_relink(t_list_c * list)
+{
+	t_list_c * node;
+
+	node = list;
+	while (MS_ADDRCK(node->next)) {
+		node->next->prev = node;
+		node = node->next;
+	}
+	node->next = list;
+	list->prev = node;
+}
+
 /*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
 
 t_list_c * list_c_node(
@@ -216,4 +236,64 @@ void * list_c_nth_element(
 	return (NULL);
 }
 
+int list_c_sort(
+	  t_list_c ** list
+	, int (*f_compare)(void * elem, void * data)
+	, int flags
+) {
+	if (
+		   MS_ADDRNULL(list)
+		|| MS_ADDRNULL(f_compare)
+	) {
+		return (1);
+	}
+	if (
+		   MS_ADDRCK(*list)
+		&& MS_ADDRCK((*list)->next)
+	) {
+		(*list)->prev->next = NULL;
+		*list = MS_CAST(t_list_c *, list_sort_chain(
+			  *list
+			, MS_OFFSETOF(t_list_c, next)
+			, MS_OFFSETOF(t_list_c, data)
+			, f_compare
+			, flags
+		));
+		__list_c_relink(*list);
+	}
+	return (0);
+}
+
+int list_c_sort_parallel(
+	  t_list_c ** list
+	, int (*f_compare)(void * elem, void * data)
+	, int flags
+	, t_pool * pool
+	, size_t grain
+) {
+	if (
+		   MS_ADDRNULL(list)
+		|| MS_ADDRNULL(f_compare)
+	) {
+		return (1);
+	}
+	if (
+		   MS_ADDRCK(*list)
+		&& MS_ADDRCK((*list)->next)
+	) {
+		(*list)->prev->next = NULL;
+		*list = MS_CAST(t_list_c *, list_sort_chain_parallel(
+			  *list
+			, MS_OFFSETOF(t_list_c, next)
+			, MS_OFFSETOF(t_list_c, data)
+			, f_compare
+			, flags
+			, pool
+			, grain
+		));
+		__list_c_relink(*list);
+	}
+	return (0);
+}
+
 /* EOF */
\ No newline at end of file
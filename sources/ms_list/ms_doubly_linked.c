@@ -9,6 +9,24 @@ struct s_list_d
 	t_list_d * next;
 };
 
+/*--------------------------------- PRIVATE METHODS ---------------------------------*/
+
+/*
+ * Restore the `prev` links once the nodes are chained by `next` alone
+*/
+static inline
+void __list_d_relink(t_list_d * list)
+{
+	t_list_d * prev;
+
+	prev = NULL;
+	while (MS_ADDRCK(list)) {
+		list->prev = prev;
+		prev = list;
+		list = list->next;
+	}
+}
+
 /*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
 
 t_list_d * list_d_node(
@@ -243,4 +261,52 @@ void *list_d_nth_element(
 	return (NULL);
 }
 
+int list_d_sort(
+	  t_list_d ** list
+	, int (*f_compare)(void * elem, void * data)
+	, int flags
+) {
+	if (
+		   MS_ADDRNULL(list)
+		|| MS_ADDRNULL(f_compare)
+	) {
+		return (1);
+	}
+	*list = MS_CAST(t_list_d *, list_sort_chain(
+		  *list
+		, MS_OFFSETOF(t_list_d, next)
+		, MS_OFFSETOF(t_list_d, data)
+		, f_compare
+		, flags
+	));
+	__list_d_relink(*list);
+	return (0);
+}
+
+int list_d_sort_parallel(
+	  t_list_d ** list
+	, int (*f_compare)(void * elem, void * data)
+	, int flags
+	, t_pool * pool
+	, size_t grain
+) {
+	if (
+		   MS_ADDRNULL(list)
+		|| MS_ADDRNULL(f_compare)
+	) {
+		return (1);
+	}
+	*list = MS_CAST(t_list_d *, list_sort_chain_parallel(
+		  *list
+		, MS_OFFSETOF(t_list_d, next)
+		, MS_OFFSETOF(t_list_d, data)
+		, f_compare
+		, flags
+		, pool
+		, grain
+	));
+	__list_d_relink(*list);
+	return (0);
+}
+
 /* EOF */
\ No newline at end of file
@@ -0,0 +1,163 @@
+# include <ms_list/ms_intrusive_linked.h>
+
+/*--------------------------------- PRIVATE METHODS ---------------------------------*/
+
+static inline
+void __ilist_link(
+	  t_ilist * prev
+	, t_ilist * node
+	, t_ilist * next
+) {
+	node->prev = prev;
+	node->next = next;
+	prev->next = node;
+	next->prev = node;
+}
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+void ilist_init(t_ilist * head)
+{
+	if (MS_ADDRCK(head)) {
+		head->next = head;
+		head->prev = head;
+	}
+}
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+int ilist_is_empty(const t_ilist * head)
+{
+	if (
+		   MS_ADDRCK(head)
+		&& head->next != head
+	) {
+		return (0);
+	}
+	return (1);
+}
+
+int ilist_is_linked(const t_ilist * node)
+{
+	return (1 - ilist_is_empty(node));
+}
+
+size_t ilist_size(const t_ilist * head)
+{
+	size_t          size;
+	const t_ilist * node;
+
+	size = 0;
+	if (MS_ADDRCK(head)) {
+		node = head->next;
+		while (node != head) {
+			++size;
+			node = node->next;
+		}
+	}
+	return (size);
+}
+
+void ilist_push_front(
+	  t_ilist * head
+	, t_ilist * node
+) {
+	if (
+		   MS_ADDRCK(head)
+		&& MS_ADDRCK(node)
+	) {
+		__ilist_link(head, node, head->next);
+	}
+}
+
+void ilist_push_back(
+	  t_ilist * head
+	, t_ilist * node
+) {
+	if (
+		   MS_ADDRCK(head)
+		&& MS_ADDRCK(node)
+	) {
+		__ilist_link(head->prev, node, head);
+	}
+}
+
+void ilist_remove(t_ilist * node)
+{
+	if (MS_ADDRCK(node)) {
+		node->prev->next = node->next;
+		node->next->prev = node->prev;
+		node->next = node;
+		node->prev = node;
+	}
+}
+
+t_ilist * ilist_pop_front(t_ilist * head)
+{
+	t_ilist * node;
+
+	node = ilist_front(head);
+	ilist_remove(node);
+	return (node);
+}
+
+t_ilist * ilist_front(const t_ilist * head)
+{
+	if (0 == ilist_is_empty(head)) {
+		return (head->next);
+	}
+	return (NULL);
+}
+
+t_ilist * ilist_back(const t_ilist * head)
+{
+	if (0 == ilist_is_empty(head)) {
+		return (head->prev);
+	}
+	return (NULL);
+}
+
+void ilist_splice(
+	  t_ilist * head
+	, t_ilist * list
+) {
+	if (
+		   MS_ADDRCK(head)
+		&& 0 == ilist_is_empty(list)
+	) {
+		list->next->prev = head->prev;
+		head->prev->next = list->next;
+		list->prev->next = head;
+		head->prev = list->prev;
+		ilist_init(list);
+	}
+}
+
+int ilist_fct(
+	  t_ilist * head
+	, void ** content
+	, int (*f_fct)(t_ilist * node, void ** content)
+) {
+	int       ret;
+	t_ilist * node;
+	t_ilist * next;
+
+	ret = 0;
+	if (
+		   MS_ADDRCK(head)
+		&& MS_ADDRCK(f_fct)
+	) {
+		node = head->next;
+		while (
+			   0 == ret
+			&& node != head
+		) {
+			next = node->next;
+			ret = f_fct(node, content);
+			node = next;
+		}
+	}
+	return (ret);
+}
+
+/* EOF */
\ No newline at end of file
@@ -2,12 +2,57 @@
 
 /*----------------------------------- STRUCTURES ------------------------------------*/
 
+/*
+ * Chunks of list_s_fct_parallel in flight at once, the walk waits for
+ * the oldest one past them
+*/
+# define LIST_S_WINDOW        64
+
 struct s_list_s
 {
 	void     * data;
 	t_list_s * next;
 };
 
+/*
+ * `count` nodes from `first`, `ret` is shared by all the chunks
+*/
+typedef struct s_list_s_chunk
+{
+	t_list_s * first;
+	size_t     count;
+	int        (*f_fct)(void * data);
+	int      * ret;
+} t_list_s_chunk;
+
+/*--------------------------------- PRIVATE METHODS ---------------------------------*/
+
+static
+void __list_s_fct_chunk(void * arg)
+{
+	int              ret;
+	int              first;
+	t_list_s       * node;
+	t_list_s_chunk * chunk;
+
+	chunk = MS_CAST(t_list_s_chunk *, arg);
+	node = chunk->first;
+	ret = 0;
+	while (
+		   0 == ret
+		&& 0 != chunk->count
+		&& 0 == MS_ATOMIC_LOAD(chunk->ret)
+	) {
+		ret = chunk->f_fct(node->data);
+		node = node->next;
+		--chunk->count;
+	}
+	if (0 != ret) {
+		first = 0;
+		MS_ATOMIC_CAS(chunk->ret, &first, ret);
+	}
+}
+
 /*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
 
 t_list_s * list_s_node(
@@ -96,6 +141,66 @@ int list_s_fct(
 	return (0);
 }
 
+/*
+ * The list is walked once by the calling thread, which forks a chunk
+ * every `grain` nodes
+*/
+int list_s_fct_parallel(
+	  t_list_s ** list
+	, int (*f_fct)(void * data)
+	, t_pool * pool
+	, size_t grain
+) {
+	int            ret;
+	size_t         i;
+	size_t         forked;
+	t_list_s     * node;
+	t_pool_task    tasks[LIST_S_WINDOW];
+	t_list_s_chunk chunks[LIST_S_WINDOW];
+
+	if (
+		   MS_ADDRNULL(list)
+		|| MS_ADDRNULL(*list)
+		|| MS_ADDRNULL(f_fct)
+	) {
+		return (0);
+	}
+	if (0 == grain) {
+		grain = MS_POOL_GRAIN;
+	}
+	ret = 0;
+	forked = 0;
+	node = *list;
+	while (
+		   MS_ADDRCK(node)
+		&& 0 == MS_ATOMIC_LOAD(&ret)
+	) {
+		i = forked % LIST_S_WINDOW;
+		if (forked >= LIST_S_WINDOW) {
+			pool_join(pool, &tasks[i]);
+		}
+		chunks[i].first = node;
+		chunks[i].count = 0;
+		chunks[i].f_fct = f_fct;
+		chunks[i].ret   = &ret;
+		while (
+			   MS_ADDRCK(node)
+			&& chunks[i].count < grain
+		) {
+			node = node->next;
+			++chunks[i].count;
+		}
+		pool_fork(pool, &tasks[i], &__list_s_fct_chunk, &chunks[i]);
+		++forked;
+	}
+	i = (forked > LIST_S_WINDOW) ? forked - LIST_S_WINDOW : 0;
+	while (i < forked) {
+		pool_join(pool, &tasks[i % LIST_S_WINDOW]);
+		++i;
+	}
+	return (ret);
+}
+
 int list_s_push_front(
 	  t_list_s ** list
 	, void * data
@@ -232,4 +337,50 @@ void * list_s_nth_element(
 	return (NULL);
 }
 
+int list_s_sort(
+	  t_list_s ** list
+	, int (*f_compare)(void * elem, void * data)
+	, int flags
+) {
+	if (
+		   MS_ADDRNULL(list)
+		|| MS_ADDRNULL(f_compare)
+	) {
+		return (1);
+	}
+	*list = MS_CAST(t_list_s *, list_sort_chain(
+		  *list
+		, MS_OFFSETOF(t_list_s, next)
+		, MS_OFFSETOF(t_list_s, data)
+		, f_compare
+		, flags
+	));
+	return (0);
+}
+
+int list_s_sort_parallel(
+	  t_list_s ** list
+	, int (*f_compare)(void * elem, void * data)
+	, int flags
+	, t_pool * pool
+	, size_t grain
+) {
+	if (
+		   MS_ADDRNULL(list)
+		|| MS_ADDRNULL(f_compare)
+	) {
+		return (1);
+	}
+	*list = MS_CAST(t_list_s *, list_sort_chain_parallel(
+		  *list
+		, MS_OFFSETOF(t_list_s, next)
+		, MS_OFFSETOF(t_list_s, data)
+		, f_compare
+		, flags
+		, pool
+		, grain
+	));
+	return (0);
+}
+
 /* EOF */
\ No newline at end of file
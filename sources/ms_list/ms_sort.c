@@ -0,0 +1,259 @@
+# include <ms_list/ms_sort.h>
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+/*
+ * Bins of sorted runs, bin i holding about 2^i runs
+*/
+# define SORT_BINS            64
+
+/*
+ * Fields of a node, at their offsets
+*/
+# define SORT_NEXT(sort, node) \
+	(*MS_CAST(void **, (MS_CAST(char *, (node)) + (sort)->next)))
+# define SORT_DATA(sort, node) \
+	(*MS_CAST(void **, (MS_CAST(char *, (node)) + (sort)->data)))
+
+typedef struct s_sort
+{
+	size_t next;
+	size_t data;
+	int    (*f_compare)(void * elem, void * data);
+	int    flags;
+} t_sort;
+
+/*
+ * A part of list_sort_chain_parallel, `count` nodes from `first`
+*/
+typedef struct s_sort_task
+{
+	const t_sort * sort;
+	void         * first;
+	size_t         count;
+	size_t         grain;
+	t_pool       * pool;
+} t_sort_task;
+
+/*--------------------------------- PRIVATE METHODS ---------------------------------*/
+
+/*
+ * Ties are taken from `left`, which holds the nodes first in the list
+*/
+static inline
+void * __sort_merge(
+	  const t_sort * sort
+	, void * left
+	, void * right
+) {
+	void  * head;
+	void ** tail;
+
+	tail = &head;
+	while (
+		   MS_ADDRCK(left)
+		&& MS_ADDRCK(right)
+	) {
+		if (sort->f_compare(SORT_DATA(sort, left), SORT_DATA(sort, right)) < 0) {
+			*tail = right;
+			tail = &SORT_NEXT(sort, right);
+			right = *tail;
+		} else {
+			*tail = left;
+			tail = &SORT_NEXT(sort, left);
+			left = *tail;
+		}
+	}
+	*tail = MS_ADDRCK(left) ? left : right;
+	return (head);
+}
+
+/*
+ * Detach the first run of the chain: a single node, or with
+ * MS_SORT_NATURAL the longest run increasing, or strictly decreasing
+ * and then reversed, which keeps the sort stable
+*/
+static inline
+void * __sort_run(
+	  const t_sort * sort
+	, void ** chain
+) {
+	int    walk;
+	void * node;
+	void * next;
+	void * prev;
+
+	node = *chain;
+	next = SORT_NEXT(sort, node);
+	if (
+		   0 == (MS_SORT_NATURAL & sort->flags)
+		|| MS_ADDRNULL(next)
+	) {
+		*chain = next;
+		SORT_NEXT(sort, node) = NULL;
+		return (node);
+	}
+	if (sort->f_compare(SORT_DATA(sort, node), SORT_DATA(sort, next)) < 0) {
+		prev = NULL;
+		walk = 1;
+		while (walk) {
+			next = SORT_NEXT(sort, node);
+			SORT_NEXT(sort, node) = prev;
+			prev = node;
+			if (
+				   MS_ADDRCK(next)
+				&& sort->f_compare(SORT_DATA(sort, node), SORT_DATA(sort, next)) < 0
+			) {
+				node = next;
+			} else {
+				walk = 0;
+			}
+		}
+		*chain = next;
+		return (prev);
+	}
+	prev = node;
+	while (
+		   MS_ADDRCK(next)
+		&& sort->f_compare(SORT_DATA(sort, node), SORT_DATA(sort, next)) >= 0
+	) {
+		node = next;
+		next = SORT_NEXT(sort, node);
+	}
+	*chain = next;
+	SORT_NEXT(sort, node) = NULL;
+	return (prev);
+}
+
+/*
+ * Each run is carried through the bins like a bit through a binary
+ * counter: the bins higher up hold the nodes first in the list
+*/
+static inline
+void * __sort_chain(
+	  const t_sort * sort
+	, void * first
+) {
+	size_t   i;
+	size_t   top;
+	void   * run;
+	void   * bins[SORT_BINS];
+
+	MS_MEMSET(bins, 0, sizeof(bins));
+	top = 0;
+	while (MS_ADDRCK(first)) {
+		run = __sort_run(sort, &first);
+		i = 0;
+		while (
+			   i < top
+			&& MS_ADDRCK(bins[i])
+		) {
+			run = __sort_merge(sort, bins[i], run);
+			bins[i] = NULL;
+			++i;
+		}
+		if (i == top) {
+			++top;
+		}
+		bins[i] = run;
+	}
+	run = NULL;
+	i = 0;
+	while (i < top) {
+		if (MS_ADDRCK(bins[i])) {
+			run = __sort_merge(sort, bins[i], run);
+		}
+		++i;
+	}
+	return (run);
+}
+
+static
+void __sort_task(void * arg)
+{
+	size_t        i;
+	void        * node;
+	t_pool_task   task;
+	t_sort_task   left;
+	t_sort_task   right;
+	t_sort_task * part;
+
+	part = MS_CAST(t_sort_task *, arg);
+	if (part->count <= part->grain) {
+		part->first = __sort_chain(part->sort, part->first);
+		return ;
+	}
+	left = *part;
+	right = *part;
+	left.count = part->count / 2;
+	right.count = part->count - left.count;
+	node = part->first;
+	i = 1;
+	while (i < left.count) {
+		node = SORT_NEXT(part->sort, node);
+		++i;
+	}
+	right.first = SORT_NEXT(part->sort, node);
+	SORT_NEXT(part->sort, node) = NULL;
+	pool_fork(part->pool, &task, &__sort_task, &left);
+	__sort_task(&right);
+	pool_join(part->pool, &task);
+	part->first = __sort_merge(part->sort, left.first, right.first);
+}
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+void * list_sort_chain(
+	  void * first
+	, size_t next
+	, size_t data
+	, int (*f_compare)(void * elem, void * data)
+	, int flags
+) {
+	t_sort sort;
+
+	if (MS_ADDRNULL(f_compare)) {
+		return (first);
+	}
+	sort.next      = next;
+	sort.data      = data;
+	sort.f_compare = f_compare;
+	sort.flags     = flags;
+	return (__sort_chain(&sort, first));
+}
+
+void * list_sort_chain_parallel(
+	  void * first
+	, size_t next
+	, size_t data
+	, int (*f_compare)(void * elem, void * data)
+	, int flags
+	, t_pool * pool
+	, size_t grain
+) {
+	void        * node;
+	t_sort        sort;
+	t_sort_task   part;
+
+	if (MS_ADDRNULL(f_compare)) {
+		return (first);
+	}
+	sort.next      = next;
+	sort.data      = data;
+	sort.f_compare = f_compare;
+	sort.flags     = flags;
+	part.sort      = &sort;
+	part.first     = first;
+	part.count     = 0;
+	part.grain     = (0 == grain) ? MS_POOL_GRAIN : grain;
+	part.pool      = pool;
+	node = first;
+	while (MS_ADDRCK(node)) {
+		++part.count;
+		node = SORT_NEXT(&sort, node);
+	}
+	__sort_task(&part);
+	return (part.first);
+}
+
+/* EOF */
\ No newline at end of file
@@ -0,0 +1,433 @@
+# include <ms_pool.h>
+# include <ms_futex.h>
+# include <pthread.h>
+# include <sched.h>
+# include <unistd.h>
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+/*
+ * Chase-Lev deque: the worker pushes and pops at `bottom`, the thieves
+ * take at `top`, each index on its own cache line
+*/
+typedef struct s_pool_worker
+{
+	long             top MS_ALIGNED(MS_CACHE_LINE);
+	long             bottom MS_ALIGNED(MS_CACHE_LINE);
+	t_pool         * pool;
+	size_t           victim;
+	pthread_t        thread;
+	t_pool_task    * deque[MS_POOL_DEQUE];
+} MS_ALIGNED(MS_CACHE_LINE) t_pool_worker;
+
+/*
+ * The tasks forked by threads out of the pool wait in `injection`.
+ * An idle worker is counted in `sleepers` and sleeps on `signal`
+*/
+struct s_pool
+{
+	size_t            size;
+	int               stop;
+	int               sleepers;
+	int               injected;
+	pthread_mutex_t   lock;
+	t_ilist           injection;
+	t_pool_worker   * workers;
+	int               signal MS_ALIGNED(MS_CACHE_LINE);
+};
+
+/*
+ * A part of pool_parallel_for
+*/
+typedef struct s_pool_range
+{
+	t_pool * pool;
+	size_t   begin;
+	size_t   end;
+	size_t   grain;
+	void     (*f_range)(size_t begin, size_t end, void * arg);
+	void   * arg;
+} t_pool_range;
+
+static __thread t_pool_worker * g_pool_self;
+static __thread size_t          g_pool_victim;
+
+/*--------------------------------- PRIVATE METHODS ---------------------------------*/
+
+static inline
+int __pool_push(
+	  t_pool_worker * worker
+	, t_pool_task * task
+) {
+	long top;
+	long bottom;
+
+	bottom = MS_ATOMIC_LOAD(&worker->bottom);
+	top = MS_ATOMIC_LOAD(&worker->top);
+	if (bottom - top >= MS_POOL_DEQUE) {
+		return (1);
+	}
+	MS_ATOMIC_STORE(&worker->deque[bottom & (MS_POOL_DEQUE - 1)], task);
+	MS_ATOMIC_STORE(&worker->bottom, bottom + 1);
+	return (0);
+}
+
+/*
+ * The last task is raced for against the thieves on `top`
+*/
+static inline
+t_pool_task * __pool_pop(t_pool_worker * worker)
+{
+	long          top;
+	long          bottom;
+	t_pool_task * task;
+
+	bottom = MS_ATOMIC_LOAD(&worker->bottom) - 1;
+	MS_ATOMIC_STORE(&worker->bottom, bottom);
+	MS_ATOMIC_FENCE();
+	top = MS_ATOMIC_LOAD(&worker->top);
+	task = NULL;
+	if (top <= bottom) {
+		task = MS_ATOMIC_LOAD(&worker->deque[bottom & (MS_POOL_DEQUE - 1)]);
+		if (top == bottom) {
+			if (0 == MS_ATOMIC_CAS(&worker->top, &top, top + 1)) {
+				task = NULL;
+			}
+			MS_ATOMIC_STORE(&worker->bottom, bottom + 1);
+		}
+	} else {
+		MS_ATOMIC_STORE(&worker->bottom, bottom + 1);
+	}
+	return (task);
+}
+
+static inline
+t_pool_task * __pool_steal(t_pool_worker * worker)
+{
+	long          top;
+	long          bottom;
+	t_pool_task * task;
+
+	top = MS_ATOMIC_LOAD(&worker->top);
+	MS_ATOMIC_FENCE();
+	bottom = MS_ATOMIC_LOAD(&worker->bottom);
+	task = NULL;
+	if (top < bottom) {
+		task = MS_ATOMIC_LOAD(&worker->deque[top & (MS_POOL_DEQUE - 1)]);
+		if (0 == MS_ATOMIC_CAS(&worker->top, &top, top + 1)) {
+			task = NULL;
+		}
+	}
+	return (task);
+}
+
+/*
+ * Own deque first, then the injected tasks, then the other workers
+ * from a rotating victim
+*/
+static inline
+t_pool_task * __pool_find(
+	  t_pool * pool
+	, t_pool_worker * self
+) {
+	size_t          i;
+	size_t          start;
+	t_ilist       * node;
+	t_pool_task   * task;
+	t_pool_worker * victim;
+
+	task = NULL;
+	if (MS_ADDRCK(self)) {
+		task = __pool_pop(self);
+	}
+	if (
+		   MS_ADDRNULL(task)
+		&& 0 != MS_ATOMIC_LOAD(&pool->injected)
+	) {
+		pthread_mutex_lock(&pool->lock);
+		node = ilist_pop_front(&pool->injection);
+		if (MS_ADDRCK(node)) {
+			MS_ATOMIC_DEC(&pool->injected);
+			task = MS_CONTAINER_OF(node, t_pool_task, hook);
+		}
+		pthread_mutex_unlock(&pool->lock);
+	}
+	if (MS_ADDRCK(self)) {
+		start = self->victim++;
+	} else {
+		start = g_pool_victim++;
+	}
+	i = 0;
+	while (
+		   MS_ADDRNULL(task)
+		&& i < pool->size
+	) {
+		victim = &pool->workers[(start + i) % pool->size];
+		if (victim != self) {
+			task = __pool_steal(victim);
+		}
+		++i;
+	}
+	return (task);
+}
+
+static inline
+void __pool_run(t_pool_task * task)
+{
+	task->f_run(task->arg);
+	MS_ATOMIC_STORE(&task->done, 1);
+}
+
+/*
+ * Pairs with the fence of a worker going to sleep: either the worker
+ * sees the task, or the signal changes under it
+*/
+static inline
+void __pool_signal(t_pool * pool)
+{
+	MS_ATOMIC_FENCE();
+	if (0 != MS_ATOMIC_LOAD(&pool->sleepers)) {
+		MS_ATOMIC_INC(&pool->signal);
+		futex_wake(&pool->signal, 1);
+	}
+}
+
+static
+void * __pool_worker(void * arg)
+{
+	int             seq;
+	t_pool        * pool;
+	t_pool_task   * task;
+	t_pool_worker * worker;
+
+	worker = MS_CAST(t_pool_worker *, arg);
+	pool = worker->pool;
+	g_pool_self = worker;
+	while (0 == MS_ATOMIC_LOAD(&pool->stop)) {
+		task = __pool_find(pool, worker);
+		if (MS_ADDRNULL(task)) {
+			seq = MS_ATOMIC_LOAD(&pool->signal);
+			MS_ATOMIC_INC(&pool->sleepers);
+			MS_ATOMIC_FENCE();
+			if (0 == MS_ATOMIC_LOAD(&pool->stop)) {
+				task = __pool_find(pool, worker);
+				if (MS_ADDRNULL(task)) {
+					futex_wait(&pool->signal, seq, NULL);
+				}
+			}
+			MS_ATOMIC_DEC(&pool->sleepers);
+		}
+		if (MS_ADDRCK(task)) {
+			__pool_run(task);
+		}
+	}
+	return (NULL);
+}
+
+static
+void __pool_for(void * arg)
+{
+	t_pool_task    task;
+	t_pool_range   left;
+	t_pool_range   right;
+	t_pool_range * range;
+
+	range = MS_CAST(t_pool_range *, arg);
+	if (range->end - range->begin <= range->grain) {
+		range->f_range(range->begin, range->end, range->arg);
+		return ;
+	}
+	left = *range;
+	right = *range;
+	left.end = range->begin + (range->end - range->begin) / 2;
+	right.begin = left.end;
+	pool_fork(range->pool, &task, &__pool_for, &right);
+	__pool_for(&left);
+	pool_join(range->pool, &task);
+}
+
+/*
+ * Stop the `count` first workers
+*/
+static inline
+void __pool_stop(
+	  t_pool * pool
+	, size_t count
+) {
+	size_t i;
+
+	MS_ATOMIC_STORE(&pool->stop, 1);
+	MS_ATOMIC_FENCE();
+	MS_ATOMIC_INC(&pool->signal);
+	futex_wake(&pool->signal, MS_CAST(int, count));
+	i = 0;
+	while (i < count) {
+		pthread_join(pool->workers[i].thread, NULL);
+		++i;
+	}
+}
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+int pool_init(
+	  t_pool ** pool
+	, size_t threads
+) {
+	size_t i;
+	long   cores;
+
+	if (MS_ADDRNULL(pool)) {
+		return (1);
+	}
+	if (0 == threads) {
+		cores = sysconf(_SC_NPROCESSORS_ONLN);
+		threads = (cores > 0) ? MS_CAST(size_t, cores) : 1;
+	}
+	*pool = MS_CAST(t_pool *, MS_ALLOC_ALIGN(MS_CACHE_LINE, sizeof(t_pool)));
+	if (MS_ADDRNULL(*pool)) {
+		return (1);
+	}
+	MS_MEMSET(*pool, 0, sizeof(t_pool));
+	(*pool)->workers = MS_CAST(t_pool_worker *, MS_ALLOC_ALIGN(MS_CACHE_LINE, threads * sizeof(t_pool_worker)));
+	if (MS_ADDRNULL((*pool)->workers)) {
+		MS_DEALLOC(*pool);
+		*pool = NULL;
+		return (1);
+	}
+	MS_MEMSET((*pool)->workers, 0, threads * sizeof(t_pool_worker));
+	(*pool)->size = threads;
+	ilist_init(&(*pool)->injection);
+	pthread_mutex_init(&(*pool)->lock, NULL);
+	i = 0;
+	while (i < threads) {
+		(*pool)->workers[i].pool = *pool;
+		(*pool)->workers[i].victim = i + 1;
+		if (0 != pthread_create(&(*pool)->workers[i].thread, NULL, &__pool_worker, &(*pool)->workers[i])) {
+			__pool_stop(*pool, i);
+			pthread_mutex_destroy(&(*pool)->lock);
+			MS_DEALLOC((*pool)->workers);
+			MS_DEALLOC(*pool);
+			*pool = NULL;
+			return (1);
+		}
+		++i;
+	}
+	return (0);
+}
+
+void pool_destroy(t_pool * pool)
+{
+	if (MS_ADDRCK(pool)) {
+		__pool_stop(pool, pool->size);
+		pthread_mutex_destroy(&pool->lock);
+		MS_DEALLOC(pool->workers);
+		MS_DEALLOC(pool);
+	}
+}
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+size_t pool_size(const t_pool * pool)
+{
+	if (MS_ADDRCK(pool)) {
+		return (pool->size);
+	}
+	return (0);
+}
+
+void pool_fork(
+	  t_pool * pool
+	, t_pool_task * task
+	, void (*f_run)(void * arg)
+	, void * arg
+) {
+	t_pool_worker * self;
+
+	if (
+		   MS_ADDRNULL(task)
+		|| MS_ADDRNULL(f_run)
+	) {
+		return ;
+	}
+	task->f_run = f_run;
+	task->arg = arg;
+	task->done = 0;
+	ilist_init(&task->hook);
+	self = g_pool_self;
+	if (MS_ADDRNULL(pool)) {
+		__pool_run(task);
+		return ;
+	}
+	if (
+		   MS_ADDRCK(self)
+		&& self->pool == pool
+	) {
+		if (0 != __pool_push(self, task)) {
+			__pool_run(task);
+			return ;
+		}
+	} else {
+		pthread_mutex_lock(&pool->lock);
+		ilist_push_back(&pool->injection, &task->hook);
+		MS_ATOMIC_INC(&pool->injected);
+		pthread_mutex_unlock(&pool->lock);
+	}
+	__pool_signal(pool);
+}
+
+void pool_join(
+	  t_pool * pool
+	, t_pool_task * task
+) {
+	t_pool_task   * other;
+	t_pool_worker * self;
+
+	if (MS_ADDRNULL(task)) {
+		return ;
+	}
+	self = g_pool_self;
+	if (
+		   MS_ADDRCK(self)
+		&& self->pool != pool
+	) {
+		self = NULL;
+	}
+	while (0 == MS_ATOMIC_LOAD(&task->done)) {
+		other = NULL;
+		if (MS_ADDRCK(pool)) {
+			other = __pool_find(pool, self);
+		}
+		if (MS_ADDRCK(other)) {
+			__pool_run(other);
+		} else {
+			sched_yield();
+		}
+	}
+}
+
+int pool_parallel_for(
+	  t_pool * pool
+	, size_t begin
+	, size_t end
+	, size_t grain
+	, void (*f_range)(size_t begin, size_t end, void * arg)
+	, void * arg
+) {
+	t_pool_range range;
+
+	if (MS_ADDRNULL(f_range)) {
+		return (1);
+	}
+	if (begin < end) {
+		range.pool    = pool;
+		range.begin   = begin;
+		range.end     = end;
+		range.grain   = (0 == grain) ? MS_POOL_GRAIN : grain;
+		range.f_range = f_range;
+		range.arg     = arg;
+		__pool_for(&range);
+	}
+	return (0);
+}
+
+/* EOF */
\ No newline at end of file
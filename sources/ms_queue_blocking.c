@@ -0,0 +1,273 @@
+# include <ms_queue_blocking.h>
+# include <pthread.h>
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+/*
+ * A ring of `capacity` elements, `count` of them from `head`. A thread
+ * going to sleep is counted in `consumers` or `producers`, the other
+ * threads only touch the futex words, each on its own cache line, when
+ * one sleeps
+*/
+struct s_queue_bk
+{
+	pthread_mutex_t   lock;
+	size_t            capacity;
+	size_t            head;
+	size_t            count;
+	int               consumers;
+	int               producers;
+	void           ** ring;
+	int               readable MS_ALIGNED(MS_CACHE_LINE);
+	int               writable MS_ALIGNED(MS_CACHE_LINE);
+};
+
+/*--------------------------------- PRIVATE METHODS ---------------------------------*/
+
+/*
+ * Sleep on `word`, the lock released meanwhile
+*/
+static inline
+int __queue_bk_wait(
+	  t_queue_bk * queue
+	, int * word
+	, int * sleepers
+	, const struct timespec * deadline
+) {
+	int ret;
+	int seq;
+
+	seq = MS_ATOMIC_LOAD(word);
+	++*sleepers;
+	pthread_mutex_unlock(&queue->lock);
+	ret = futex_wait(word, seq, deadline);
+	pthread_mutex_lock(&queue->lock);
+	--*sleepers;
+	return (ret);
+}
+
+/*
+ * Change `word`, under the lock, for the threads sleeping on it.
+ * Returns how many to wake for `count` elements or slots, the wake
+ * itself being left for after the lock is released
+*/
+static inline
+int __queue_bk_signal(
+	  int * word
+	, int sleepers
+	, size_t count
+) {
+	if (
+		   0 == sleepers
+		|| 0 == count
+	) {
+		return (0);
+	}
+	MS_ATOMIC_INC(word);
+	if (count < MS_CAST(size_t, sleepers)) {
+		return (MS_CAST(int, count));
+	}
+	return (sleepers);
+}
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+int queue_bk_init(
+	  t_queue_bk ** queue
+	, size_t capacity
+) {
+	if (
+		   MS_ADDRNULL(queue)
+		|| 0 == capacity
+	) {
+		return (1);
+	}
+	*queue = MS_CAST(t_queue_bk *, MS_ALLOC_ALIGN(MS_CACHE_LINE, sizeof(t_queue_bk)));
+	if (MS_ADDRNULL(*queue)) {
+		return (1);
+	}
+	MS_MEMSET(*queue, 0, sizeof(t_queue_bk));
+	(*queue)->ring = MS_CAST(void **, MS_ALLOC(capacity * sizeof(void *)));
+	if (MS_ADDRNULL((*queue)->ring)) {
+		MS_DEALLOC(*queue);
+		*queue = NULL;
+		return (1);
+	}
+	(*queue)->capacity = capacity;
+	pthread_mutex_init(&(*queue)->lock, NULL);
+	return (0);
+}
+
+void queue_bk_destroy(
+	  t_queue_bk * queue
+	, void (*f_free)(void * data)
+) {
+	if (MS_ADDRCK(queue)) {
+		while (0 != queue->count) {
+			if (MS_ADDRCK(f_free)) {
+				f_free(queue->ring[queue->head]);
+			}
+			queue->head = (queue->head + 1) % queue->capacity;
+			--queue->count;
+		}
+		pthread_mutex_destroy(&queue->lock);
+		MS_DEALLOC(queue->ring);
+		MS_DEALLOC(queue);
+	}
+}
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+size_t queue_bk_size(t_queue_bk * queue)
+{
+	size_t count;
+
+	count = 0;
+	if (MS_ADDRCK(queue)) {
+		pthread_mutex_lock(&queue->lock);
+		count = queue->count;
+		pthread_mutex_unlock(&queue->lock);
+	}
+	return (count);
+}
+
+int queue_bk_enqueue_wait(
+	  t_queue_bk * queue
+	, void * data
+	, size_t size
+	, long timeout
+) {
+	void * copy;
+
+	if (
+		   MS_ADDRNULL(queue)
+		|| MS_ADDRNULL(data)
+	) {
+		return (1);
+	}
+	copy = data;
+	if (0 != size) {
+		copy = MS_ALLOC(size);
+		if (MS_ADDRNULL(copy)) {
+			return (1);
+		}
+		MS_MEMCPY(copy, data, size);
+	}
+	if (1 != queue_bk_enqueue_batch(queue, &copy, 1, timeout)) {
+		if (0 != size) {
+			MS_DEALLOC(copy);
+		}
+		return (1);
+	}
+	return (0);
+}
+
+size_t queue_bk_enqueue_batch(
+	  t_queue_bk * queue
+	, void ** datas
+	, size_t count
+	, long timeout
+) {
+	int                     wake;
+	int                     timed_out;
+	size_t                  added;
+	size_t                  first;
+	struct timespec         ts;
+	const struct timespec * deadline;
+
+	if (
+		   MS_ADDRNULL(queue)
+		|| MS_ADDRNULL(datas)
+	) {
+		return (0);
+	}
+	wake = 0;
+	added = 0;
+	timed_out = (0 == timeout);
+	deadline = futex_deadline(&ts, timeout);
+	pthread_mutex_lock(&queue->lock);
+	while (
+		   added < count
+		&& (
+			   queue->count < queue->capacity
+			|| 0 == timed_out
+		)
+	) {
+		if (queue->count == queue->capacity) {
+			futex_wake(&queue->readable, wake);
+			wake = 0;
+			timed_out = __queue_bk_wait(queue, &queue->writable, &queue->producers, deadline);
+		} else {
+			first = added;
+			while (
+				   added < count
+				&& queue->count < queue->capacity
+			) {
+				queue->ring[(queue->head + queue->count) % queue->capacity] = datas[added];
+				++queue->count;
+				++added;
+			}
+			wake += __queue_bk_signal(&queue->readable, queue->consumers, added - first);
+		}
+	}
+	pthread_mutex_unlock(&queue->lock);
+	futex_wake(&queue->readable, wake);
+	return (added);
+}
+
+void * queue_bk_dequeue_wait(
+	  t_queue_bk * queue
+	, long timeout
+) {
+	void * data;
+
+	if (1 == queue_bk_dequeue_batch(queue, &data, 1, timeout)) {
+		return (data);
+	}
+	return (NULL);
+}
+
+size_t queue_bk_dequeue_batch(
+	  t_queue_bk * queue
+	, void ** datas
+	, size_t count
+	, long timeout
+) {
+	int                     wake;
+	int                     timed_out;
+	size_t                  taken;
+	struct timespec         ts;
+	const struct timespec * deadline;
+
+	if (
+		   MS_ADDRNULL(queue)
+		|| MS_ADDRNULL(datas)
+		|| 0 == count
+	) {
+		return (0);
+	}
+	taken = 0;
+	timed_out = (0 == timeout);
+	deadline = futex_deadline(&ts, timeout);
+	pthread_mutex_lock(&queue->lock);
+	while (
+		   0 == queue->count
+		&& 0 == timed_out
+	) {
+		timed_out = __queue_bk_wait(queue, &queue->readable, &queue->consumers, deadline);
+	}
+	while (
+		   taken < count
+		&& 0 != queue->count
+	) {
+		datas[taken++] = queue->ring[queue->head];
+		queue->head = (queue->head + 1) % queue->capacity;
+		--queue->count;
+	}
+	wake = __queue_bk_signal(&queue->writable, queue->producers, taken);
+	pthread_mutex_unlock(&queue->lock);
+	futex_wake(&queue->writable, wake);
+	return (taken);
+}
+
+/* EOF */
\ No newline at end of file
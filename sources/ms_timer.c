@@ -0,0 +1,306 @@
+# include <ms_timer.h>
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+/*
+ * Slots of a level: 2^6, a slot of the level l covering 2^(6l) ticks
+*/
+# define TIMER_BITS           6
+# define TIMER_SLOTS          (1 << TIMER_BITS)
+# define TIMER_LEVELS         5
+
+/*
+ * Farthest tick a timer can be placed at, 2^30 ticks ahead
+*/
+# define TIMER_SPAN           ((MS_CAST(size_t, 1) << (TIMER_BITS * TIMER_LEVELS)) - 1)
+
+# define TIMER_SLOT(at, level) \
+	(((at) >> (TIMER_BITS * (level))) & (TIMER_SLOTS - 1))
+
+/*
+ * `counts` holds the number of timers of each level, to skip the ticks
+ * of the empty lower levels
+*/
+struct s_timer_wheel
+{
+	size_t  now;
+	size_t  size;
+	size_t  counts[TIMER_LEVELS];
+	t_ilist slots[TIMER_LEVELS][TIMER_SLOTS];
+};
+
+/*--------------------------------- PRIVATE METHODS ---------------------------------*/
+
+/*
+ * The level is the lowest one whose turn reaches `at`: the slot of
+ * `at` in it comes round, and cascades, when the tick of the slot begins
+*/
+static inline
+void __timer_place(
+	  t_timer_wheel * wheel
+	, t_timer * timer
+	, size_t at
+) {
+	size_t level;
+	size_t delta;
+
+	delta = at - wheel->now;
+	if (delta > TIMER_SPAN) {
+		at = wheel->now + TIMER_SPAN;
+		delta = TIMER_SPAN;
+	}
+	level = 0;
+	while (
+		   level < TIMER_LEVELS - 1
+		&& delta >= (MS_CAST(size_t, 1) << (TIMER_BITS * (level + 1)))
+	) {
+		++level;
+	}
+	ilist_push_back(&wheel->slots[level][TIMER_SLOT(at, level)], &timer->list);
+	timer->level = level + 1;
+	++wheel->counts[level];
+}
+
+/*
+ * The levels whose lower levels all turned at this tick are cascaded,
+ * from the highest one so that a timer can fall several levels
+*/
+static inline
+void __timer_cascade(t_timer_wheel * wheel)
+{
+	size_t    level;
+	t_ilist   pending;
+	t_ilist * node;
+	t_timer * timer;
+
+	level = 1;
+	while (
+		   level < TIMER_LEVELS
+		&& 0 == (wheel->now & ((MS_CAST(size_t, 1) << (TIMER_BITS * level)) - 1))
+	) {
+		++level;
+	}
+	ilist_init(&pending);
+	while (level > 1) {
+		--level;
+		ilist_splice(&pending, &wheel->slots[level][TIMER_SLOT(wheel->now, level)]);
+		node = ilist_pop_front(&pending);
+		while (MS_ADDRCK(node)) {
+			timer = MS_CONTAINER_OF(node, t_timer, list);
+			--wheel->counts[level];
+			__timer_place(wheel, timer, timer->expires);
+			node = ilist_pop_front(&pending);
+		}
+	}
+}
+
+/*
+ * The timers of the slot of the tick are disarmed and moved at the end
+ * of the batch
+*/
+static inline
+size_t __timer_expire(
+	  t_timer_wheel * wheel
+	, t_ilist * expired
+) {
+	size_t    count;
+	t_ilist * slot;
+	t_ilist * node;
+
+	count = 0;
+	slot = &wheel->slots[0][TIMER_SLOT(wheel->now, 0)];
+	node = slot->next;
+	while (node != slot) {
+		MS_CONTAINER_OF(node, t_timer, list)->level = 0;
+		++count;
+		node = node->next;
+	}
+	ilist_splice(expired, slot);
+	wheel->counts[0] -= count;
+	wheel->size -= count;
+	return (count);
+}
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+void timer_init(t_timer * timer)
+{
+	if (MS_ADDRCK(timer)) {
+		ilist_init(&timer->list);
+		timer->expires = 0;
+		timer->level = 0;
+	}
+}
+
+int timer_wheel_init(
+	  t_timer_wheel ** wheel
+	, size_t now
+) {
+	size_t i;
+
+	if (MS_ADDRNULL(wheel)) {
+		return (1);
+	}
+	*wheel = MS_CAST(t_timer_wheel *, MS_ALLOC_ALIGN(MS_CACHE_LINE, sizeof(t_timer_wheel)));
+	if (MS_ADDRNULL(*wheel)) {
+		return (1);
+	}
+	MS_MEMSET(*wheel, 0, sizeof(t_timer_wheel));
+	(*wheel)->now = now;
+	i = 0;
+	while (i < TIMER_LEVELS * TIMER_SLOTS) {
+		ilist_init(&(*wheel)->slots[i / TIMER_SLOTS][i % TIMER_SLOTS]);
+		++i;
+	}
+	return (0);
+}
+
+void timer_wheel_destroy(t_timer_wheel * wheel)
+{
+	size_t    i;
+	t_ilist * node;
+
+	if (MS_ADDRNULL(wheel)) {
+		return ;
+	}
+	i = 0;
+	while (
+		   i < TIMER_LEVELS * TIMER_SLOTS
+		&& 0 != wheel->size
+	) {
+		node = ilist_pop_front(&wheel->slots[i / TIMER_SLOTS][i % TIMER_SLOTS]);
+		if (MS_ADDRCK(node)) {
+			MS_CONTAINER_OF(node, t_timer, list)->level = 0;
+			--wheel->size;
+		} else {
+			++i;
+		}
+	}
+	MS_DEALLOC(wheel);
+}
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+size_t timer_wheel_size(const t_timer_wheel * wheel)
+{
+	if (MS_ADDRCK(wheel)) {
+		return (wheel->size);
+	}
+	return (0);
+}
+
+size_t timer_wheel_now(const t_timer_wheel * wheel)
+{
+	if (MS_ADDRCK(wheel)) {
+		return (wheel->now);
+	}
+	return (0);
+}
+
+int timer_is_armed(const t_timer * timer)
+{
+	if (MS_ADDRCK(timer)) {
+		return (0 != timer->level);
+	}
+	return (0);
+}
+
+/*
+ * The timer may still be in the batch of an expiry, it is unlinked
+ * from it too
+*/
+int timer_wheel_arm(
+	  t_timer_wheel * wheel
+	, t_timer * timer
+	, size_t expires
+) {
+	if (
+		   MS_ADDRNULL(wheel)
+		|| MS_ADDRNULL(timer)
+	) {
+		return (1);
+	}
+	ilist_remove(&timer->list);
+	if (0 == timer->level) {
+		++wheel->size;
+	} else {
+		--wheel->counts[timer->level - 1];
+	}
+	timer->expires = expires;
+	__timer_place(wheel, timer, (expires > wheel->now) ? expires : wheel->now + 1);
+	return (0);
+}
+
+int timer_wheel_cancel(
+	  t_timer_wheel * wheel
+	, t_timer * timer
+) {
+	if (
+		   MS_ADDRNULL(wheel)
+		|| MS_ADDRNULL(timer)
+		|| 0 == timer->level
+	) {
+		return (1);
+	}
+	ilist_remove(&timer->list);
+	--wheel->counts[timer->level - 1];
+	timer->level = 0;
+	--wheel->size;
+	return (0);
+}
+
+/*
+ * While the lower levels are empty, nothing happens until the lowest
+ * level holding timers turns: the wheel jumps to the tick before
+*/
+size_t timer_wheel_advance(
+	  t_timer_wheel * wheel
+	, size_t now
+	, void (*f_expire)(t_ilist * expired, void * arg)
+	, void * arg
+) {
+	size_t    count;
+	size_t    level;
+	size_t    next;
+	t_ilist   expired;
+	t_ilist * node;
+
+	if (MS_ADDRNULL(wheel)) {
+		return (0);
+	}
+	ilist_init(&expired);
+	count = 0;
+	while (wheel->now < now) {
+		level = 0;
+		while (
+			   level < TIMER_LEVELS
+			&& 0 == wheel->counts[level]
+		) {
+			++level;
+		}
+		if (level == TIMER_LEVELS) {
+			wheel->now = now;
+		} else if (0 != level) {
+			next = ((wheel->now >> (TIMER_BITS * level)) + 1) << (TIMER_BITS * level);
+			wheel->now = (next > now) ? now : next - 1;
+		}
+		if (wheel->now < now) {
+			++wheel->now;
+			__timer_cascade(wheel);
+			count += __timer_expire(wheel, &expired);
+		}
+	}
+	if (
+		   0 != count
+		&& MS_ADDRCK(f_expire)
+	) {
+		f_expire(&expired, arg);
+	}
+	node = ilist_pop_front(&expired);
+	while (MS_ADDRCK(node)) {
+		node = ilist_pop_front(&expired);
+	}
+	return (count);
+}
+
+/* EOF */
\ No newline at end of file
@@ -2,6 +2,11 @@
 
 /*----------------------------------- STRUCTURES ------------------------------------*/
 
+/*
+ * Number of descents advanced in lockstep by tree_search_batch
+*/
+# define TREE_BATCH           16
+
 struct s_tree
 {
 	void   * data;
@@ -55,6 +60,63 @@ void tree_destroy(
 	}
 }
 
+/*--------------------------------- PRIVATE METHODS ---------------------------------*/
+
+static inline
+size_t __tree_search_group(
+	  t_tree * root
+	, void ** datas
+	, size_t count
+	, void ** elems
+	, int (*f_compare)(void * elem, void * data)
+) {
+	int      ret;
+	size_t   i;
+	size_t   found;
+	size_t   active;
+	t_tree * node[TREE_BATCH];
+
+	i = 0;
+	while (i < count) {
+		node[i] = root;
+		elems[i] = NULL;
+		++i;
+	}
+	found = 0;
+	active = MS_ADDRCK(root) ? count : 0;
+	while (0 != active) {
+		i = 0;
+		while (i < count) {
+			if (MS_ADDRCK(node[i])) {
+				MS_PREFETCH(node[i]->data);
+			}
+			++i;
+		}
+		i = 0;
+		while (i < count) {
+			if (MS_ADDRCK(node[i])) {
+				ret = f_compare(node[i]->data, datas[i]);
+				if (0 == ret) {
+					elems[i] = node[i]->data;
+					node[i] = NULL;
+					++found;
+				} else if (ret < 0) {
+					node[i] = node[i]->left;
+				} else {
+					node[i] = node[i]->right;
+				}
+				if (MS_ADDRCK(node[i])) {
+					MS_PREFETCH(node[i]);
+				} else {
+					--active;
+				}
+			}
+			++i;
+		}
+	}
+	return (found);
+}
+
 /*------------------------------------- METHODS -------------------------------------*/
 
 int tree_is_empty(const t_tree * tree)
@@ -206,6 +268,46 @@ void * tree_search(
 	return (elem);
 }
 
+size_t tree_search_batch(
+	  t_tree ** tree
+	, void ** datas
+	, size_t count
+	, void ** elems
+	, int (*f_compare)(void * elem, void * data)
+) {
+	size_t i;
+	size_t group;
+	size_t found;
+
+	found = 0;
+	if (
+		   MS_ADDRCK(tree)
+		&& MS_ADDRCK(datas)
+		&& MS_ADDRCK(elems)
+		&& MS_ADDRCK(f_compare)
+	) {
+		if (MS_ADDRCK(*tree)) {
+			MS_PREFETCH(*tree);
+		}
+		i = 0;
+		while (i < count) {
+			group = count - i;
+			if (group > TREE_BATCH) {
+				group = TREE_BATCH;
+			}
+			found += __tree_search_group(
+				  *tree
+				, datas + i
+				, group
+				, elems + i
+				, f_compare
+			);
+			i += group;
+		}
+	}
+	return (found);
+}
+
 int tree_pre_order(
 	  t_tree ** tree
 	, void ** content
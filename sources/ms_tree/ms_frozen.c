@@ -0,0 +1,462 @@
+# include <ms_tree/ms_frozen.h>
+
+# ifdef __AVX2__
+#  include <immintrin.h>
+# endif
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+/*
+ * Number of descents advanced together by tree_fz_search_keys
+*/
+# define FZ_LANES             8
+
+/*
+ * Elements 1..size are stored in Eytzinger order: the children of k
+ * are 2k and 2k + 1. Index 0 is unused so that the 8 descendants
+ * of k three levels below (8k..8k+7) share a single cache line.
+*/
+struct s_tree_fz
+{
+	size_t    size;
+	size_t    depth;
+	void   ** datas;
+	long    * keys;
+};
+
+/*
+ * A subtree filled by tree_fz_init_parallel: node `k` and its
+ * descendants take the data from `i` on
+*/
+typedef struct s_tree_fz_build
+{
+	t_tree_fz * tree;
+	void     ** datas;
+	size_t      i;
+	size_t      k;
+	size_t      grain;
+	t_pool    * pool;
+	long        (*f_key)(void * data);
+} t_tree_fz_build;
+
+/*--------------------------------- PRIVATE METHODS ---------------------------------*/
+
+static inline
+size_t __tree_fz_fill(
+	  t_tree_fz * tree
+	, void ** datas
+	, size_t i
+	, size_t k
+	, long (*f_key)(void * data)
+) {
+	if (k <= tree->size) {
+		i = __tree_fz_fill(tree, datas, i, 2 * k, f_key);
+		tree->datas[k] = datas[i];
+		if (MS_ADDRCK(f_key)) {
+			tree->keys[k] = f_key(datas[i]);
+		}
+		++i;
+		i = __tree_fz_fill(tree, datas, i, 2 * k + 1, f_key);
+	}
+	return (i);
+}
+
+/*
+ * Number of nodes of the subtree of k, level by level
+*/
+static inline
+size_t __tree_fz_count(
+	  const t_tree_fz * tree
+	, size_t k
+) {
+	size_t last;
+	size_t count;
+
+	count = 0;
+	last = k;
+	while (k <= tree->size) {
+		count += ((last < tree->size) ? last : tree->size) - k + 1;
+		k = 2 * k;
+		last = 2 * last + 1;
+	}
+	return (count);
+}
+
+/*
+ * The size of the left subtree tells where the node and the right
+ * subtree start, so that both subtrees are filled at the same time
+*/
+static
+void __tree_fz_build(void * arg)
+{
+	size_t            count;
+	t_pool_task       task;
+	t_tree_fz_build   left;
+	t_tree_fz_build   right;
+	t_tree_fz_build * build;
+
+	build = MS_CAST(t_tree_fz_build *, arg);
+	if (__tree_fz_count(build->tree, build->k) <= build->grain) {
+		__tree_fz_fill(build->tree, build->datas, build->i, build->k, build->f_key);
+		return ;
+	}
+	count = __tree_fz_count(build->tree, 2 * build->k);
+	left = *build;
+	right = *build;
+	left.k = 2 * build->k;
+	right.k = 2 * build->k + 1;
+	right.i = build->i + count + 1;
+	pool_fork(build->pool, &task, &__tree_fz_build, &left);
+	build->tree->datas[build->k] = build->datas[build->i + count];
+	if (MS_ADDRCK(build->f_key)) {
+		build->tree->keys[build->k] = build->f_key(build->datas[build->i + count]);
+	}
+	__tree_fz_build(&right);
+	pool_join(build->pool, &task);
+}
+
+/*
+ * Undo the trailing right turns (and the last left one) of a
+ * finished descent: the result is the lower bound, 0 if none
+*/
+static inline
+size_t __tree_fz_lower_bound(size_t k)
+{
+	return (k >> __builtin_ffsll(MS_CAST(long long, ~k)));
+}
+
+static inline
+void * __tree_fz_match_key(
+	  const t_tree_fz * tree
+	, size_t k
+	, long key
+) {
+	k = __tree_fz_lower_bound(k);
+	if (
+		   0 != k
+		&& tree->keys[k] == key
+	) {
+		return (tree->datas[k]);
+	}
+	return (NULL);
+}
+
+/*
+ * Lockstep descents: the first `depth` levels are complete so every
+ * lane moves unconditionally, only the last level needs a bound check
+*/
+static inline
+size_t __tree_fz_search_lanes(
+	  const t_tree_fz * tree
+	, const long * keys
+	, size_t lanes
+	, void ** elems
+) {
+	size_t i;
+	size_t l;
+	size_t found;
+	size_t k[FZ_LANES];
+
+	l = 0;
+	while (l < lanes) {
+		k[l] = 1;
+		++l;
+	}
+	i = 0;
+	while (i < tree->depth) {
+		l = 0;
+		while (l < lanes) {
+			k[l] = 2 * k[l] + (tree->keys[k[l]] < keys[l]);
+			MS_PREFETCH(tree->keys + 8 * k[l]);
+			++l;
+		}
+		++i;
+	}
+	found = 0;
+	l = 0;
+	while (l < lanes) {
+		if (k[l] <= tree->size) {
+			k[l] = 2 * k[l] + (tree->keys[k[l]] < keys[l]);
+		}
+		elems[l] = __tree_fz_match_key(tree, k[l], keys[l]);
+		found += MS_ADDRCK(elems[l]);
+		++l;
+	}
+	return (found);
+}
+
+# ifdef __AVX2__
+static inline
+size_t __tree_fz_search_lanes_avx2(
+	  const t_tree_fz * tree
+	, const long * keys
+	, void ** elems
+) {
+	size_t      i;
+	size_t      l;
+	size_t      found;
+	long long   k[4];
+	__m256i     vk;
+	__m256i     vx;
+	__m256i     va;
+	__m256i     vmask;
+
+	vk = _mm256_set1_epi64x(1);
+	vx = _mm256_loadu_si256(MS_CAST(const __m256i *, keys));
+	i = 0;
+	while (i < tree->depth) {
+		va = _mm256_i64gather_epi64(MS_CAST(const long long *, tree->keys), vk, 8);
+		vk = _mm256_sub_epi64(
+			  _mm256_add_epi64(vk, vk)
+			, _mm256_cmpgt_epi64(vx, va)
+		);
+		++i;
+	}
+	vmask = _mm256_cmpgt_epi64(
+		  _mm256_set1_epi64x(MS_CAST(long long, tree->size + 1))
+		, vk
+	);
+	va = _mm256_mask_i64gather_epi64(
+		  _mm256_setzero_si256()
+		, MS_CAST(const long long *, tree->keys)
+		, _mm256_and_si256(vk, vmask)
+		, vmask
+		, 8
+	);
+	vk = _mm256_blendv_epi8(
+		  vk
+		, _mm256_sub_epi64(_mm256_add_epi64(vk, vk), _mm256_cmpgt_epi64(vx, va))
+		, vmask
+	);
+	_mm256_storeu_si256(MS_CAST(__m256i *, k), vk);
+	found = 0;
+	l = 0;
+	while (l < 4) {
+		elems[l] = __tree_fz_match_key(tree, MS_CAST(size_t, k[l]), keys[l]);
+		found += MS_ADDRCK(elems[l]);
+		++l;
+	}
+	return (found);
+}
+# endif
+
+static inline
+int __tree_fz_in_order(
+	  const t_tree_fz * tree
+	, size_t k
+	, void ** content
+	, int (*f_fct)(void * data, void ** content)
+) {
+	int ret;
+
+	ret = 0;
+	if (k <= tree->size) {
+		ret = __tree_fz_in_order(tree, 2 * k, content, f_fct);
+		if (0 == ret) {
+			ret = f_fct(tree->datas[k], content);
+			if (0 == ret) {
+				ret = __tree_fz_in_order(tree, 2 * k + 1, content, f_fct);
+			}
+		}
+	}
+	return (ret);
+}
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+int tree_fz_init(
+	  t_tree_fz ** tree
+	, void ** datas
+	, size_t count
+	, long (*f_key)(void * data)
+) {
+	return (tree_fz_init_parallel(tree, datas, count, f_key, NULL, 0));
+}
+
+int tree_fz_init_parallel(
+	  t_tree_fz ** tree
+	, void ** datas
+	, size_t count
+	, long (*f_key)(void * data)
+	, t_pool * pool
+	, size_t grain
+) {
+	size_t          array_size;
+	t_tree_fz_build build;
+
+	if (
+		   MS_ADDRCK(tree)
+		&& (MS_ADDRCK(datas) || 0 == count)
+	) {
+		*tree = MS_CAST(t_tree_fz *, MS_ALLOC(sizeof(t_tree_fz)));
+		if (MS_ADDRCK(*tree)) {
+			MS_MEMSET(*tree, 0, sizeof(t_tree_fz));
+			(*tree)->size = count;
+			while (((MS_CAST(size_t, 2) << (*tree)->depth) - 1) <= count) {
+				++(*tree)->depth;
+			}
+			array_size = (count + 1) * sizeof(void *);
+			(*tree)->datas = MS_CAST(void **, MS_ALLOC_ALIGN(MS_CACHE_LINE, array_size));
+			if (MS_ADDRCK((*tree)->datas)) {
+				if (MS_ADDRCK(f_key)) {
+					(*tree)->keys = MS_CAST(long *, MS_ALLOC_ALIGN(
+						  MS_CACHE_LINE
+						, (count + 1) * sizeof(long)
+					));
+				}
+				if (
+					   MS_ADDRNULL(f_key)
+					|| MS_ADDRCK((*tree)->keys)
+				) {
+					if (MS_ADDRNULL(pool)) {
+						__tree_fz_fill(*tree, datas, 0, 1, f_key);
+					} else {
+						build.tree  = *tree;
+						build.datas = datas;
+						build.i     = 0;
+						build.k     = 1;
+						build.grain = (0 == grain) ? MS_POOL_GRAIN : grain;
+						build.pool  = pool;
+						build.f_key = f_key;
+						__tree_fz_build(&build);
+					}
+					return (0);
+				}
+				MS_DEALLOC((*tree)->datas);
+			}
+			MS_DEALLOC(*tree);
+			*tree = NULL;
+		}
+	}
+	return (1);
+}
+
+void tree_fz_destroy(
+	  t_tree_fz * tree
+	, void (*f_free)(void * data)
+) {
+	size_t k;
+
+	if (MS_ADDRCK(tree)) {
+		if (MS_ADDRCK(f_free)) {
+			k = 1;
+			while (k <= tree->size) {
+				f_free(tree->datas[k]);
+				++k;
+			}
+		}
+		MS_DEALLOC(tree->datas);
+		MS_DEALLOC(tree->keys);
+		MS_DEALLOC(tree);
+	}
+}
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+size_t tree_fz_size(const t_tree_fz * tree)
+{
+	if (MS_ADDRCK(tree)) {
+		return (tree->size);
+	}
+	return (0);
+}
+
+void * tree_fz_search(
+	  const t_tree_fz * tree
+	, void * data
+	, int (*f_compare)(void * elem, void * data)
+) {
+	size_t k;
+
+	if (
+		   MS_ADDRCK(tree)
+		&& MS_ADDRCK(data)
+		&& MS_ADDRCK(f_compare)
+	) {
+		k = 1;
+		while (k <= tree->size) {
+			MS_PREFETCH(tree->datas + 8 * k);
+			k = 2 * k + (f_compare(tree->datas[k], data) > 0);
+		}
+		k = __tree_fz_lower_bound(k);
+		if (
+			   0 != k
+			&& 0 == f_compare(tree->datas[k], data)
+		) {
+			return (tree->datas[k]);
+		}
+	}
+	return (NULL);
+}
+
+void * tree_fz_search_key(
+	  const t_tree_fz * tree
+	, long key
+) {
+	size_t k;
+
+	if (
+		   MS_ADDRCK(tree)
+		&& MS_ADDRCK(tree->keys)
+	) {
+		k = 1;
+		while (k <= tree->size) {
+			MS_PREFETCH(tree->keys + 8 * k);
+			k = 2 * k + (tree->keys[k] < key);
+		}
+		return (__tree_fz_match_key(tree, k, key));
+	}
+	return (NULL);
+}
+
+size_t tree_fz_search_keys(
+	  const t_tree_fz * tree
+	, const long * keys
+	, size_t count
+	, void ** elems
+) {
+	size_t i;
+	size_t lanes;
+	size_t found;
+
+	found = 0;
+	if (
+		   MS_ADDRCK(tree)
+		&& MS_ADDRCK(tree->keys)
+		&& MS_ADDRCK(keys)
+		&& MS_ADDRCK(elems)
+	) {
+		i = 0;
+# ifdef __AVX2__
+		while (i + 4 <= count) {
+			found += __tree_fz_search_lanes_avx2(tree, keys + i, elems + i);
+			i += 4;
+		}
+# endif
+		while (i < count) {
+			lanes = count - i;
+			if (lanes > FZ_LANES) {
+				lanes = FZ_LANES;
+			}
+			found += __tree_fz_search_lanes(tree, keys + i, lanes, elems + i);
+			i += lanes;
+		}
+	}
+	return (found);
+}
+
+int tree_fz_in_order(
+	  const t_tree_fz * tree
+	, void ** content
+	, int (*f_fct)(void * data, void ** content)
+) {
+	if (
+		   MS_ADDRCK(tree)
+		&& MS_ADDRCK(f_fct)
+	) {
+		return (__tree_fz_in_order(tree, 1, content, f_fct));
+	}
+	return (0);
+}
+
+/* EOF */
\ No newline at end of file
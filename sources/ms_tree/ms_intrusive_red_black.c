@@ -0,0 +1,430 @@
+# include <ms_tree/ms_intrusive_red_black.h>
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+enum colors {
+	RED, BLACK
+};
+
+/*--------------------------------- PRIVATE METHODS ---------------------------------*/
+
+static inline
+int __itree_rb_is_red(const t_itree_rb * node)
+{
+	if (
+		   MS_ADDRCK(node)
+		&& RED == node->color
+	) {
+		return (1);
+	}
+	return (0);
+}
+
+/*
+ * Replace the subtree `node` by the subtree `child` in its parent
+*/
+static inline
+void __itree_rb_transplant(
+	  t_itree_rb_root * tree
+	, t_itree_rb * node
+	, t_itree_rb * child
+) {
+	if (MS_ADDRNULL(node->parent)) {
+		tree->root = child;
+	} else if (node == node->parent->left) {
+		node->parent->left = child;
+	} else {
+		node->parent->right = child;
+	}
+	if (MS_ADDRCK(child)) {
+		child->parent = node->parent;
+	}
+}
+
+static inline
+void __itree_rb_rotate_left(
+	  t_itree_rb_root * tree
+	, t_itree_rb * node
+) {
+	t_itree_rb * child;
+
+	child = node->right;
+	node->right = child->left;
+	if (MS_ADDRCK(child->left)) {
+		child->left->parent = node;
+	}
+	__itree_rb_transplant(tree, node, child);
+	child->left = node;
+	node->parent = child;
+}
+
+static inline
+void __itree_rb_rotate_right(
+	  t_itree_rb_root * tree
+	, t_itree_rb * node
+) {
+	t_itree_rb * child;
+
+	child = node->left;
+	node->left = child->right;
+	if (MS_ADDRCK(child->right)) {
+		child->right->parent = node;
+	}
+	__itree_rb_transplant(tree, node, child);
+	child->right = node;
+	node->parent = child;
+}
+
+static inline
+void __itree_rb_insert_fixup(
+	  t_itree_rb_root * tree
+	, t_itree_rb * node
+) {
+	t_itree_rb * uncle;
+	t_itree_rb * parent;
+	t_itree_rb * grand;
+
+	while (__itree_rb_is_red(node->parent)) {
+		parent = node->parent;
+		grand = parent->parent;
+		uncle = (parent == grand->left) ? grand->right : grand->left;
+		if (__itree_rb_is_red(uncle)) {
+			parent->color = BLACK;
+			uncle->color = BLACK;
+			grand->color = RED;
+			node = grand;
+		} else {
+			if (parent == grand->left) {
+				if (node == parent->right) {
+					__itree_rb_rotate_left(tree, parent);
+					parent = node;
+				}
+				__itree_rb_rotate_right(tree, grand);
+			} else {
+				if (node == parent->left) {
+					__itree_rb_rotate_right(tree, parent);
+					parent = node;
+				}
+				__itree_rb_rotate_left(tree, grand);
+			}
+			parent->color = BLACK;
+			grand->color = RED;
+			node = grand;
+		}
+	}
+	tree->root->color = BLACK;
+}
+
+/*
+ * `node` (possibly NULL) carries an extra black, `parent` is its parent
+*/
+static inline
+void __itree_rb_remove_fixup(
+	  t_itree_rb_root * tree
+	, t_itree_rb * node
+	, t_itree_rb * parent
+) {
+	t_itree_rb * sibling;
+
+	while (
+		   node != tree->root
+		&& 0 == __itree_rb_is_red(node)
+	) {
+		if (node == parent->left) {
+			sibling = parent->right;
+			if (__itree_rb_is_red(sibling)) {
+				sibling->color = BLACK;
+				parent->color = RED;
+				__itree_rb_rotate_left(tree, parent);
+				sibling = parent->right;
+			}
+			if (
+				   0 == __itree_rb_is_red(sibling->left)
+				&& 0 == __itree_rb_is_red(sibling->right)
+			) {
+				sibling->color = RED;
+				node = parent;
+				parent = node->parent;
+			} else {
+				if (0 == __itree_rb_is_red(sibling->right)) {
+					sibling->left->color = BLACK;
+					sibling->color = RED;
+					__itree_rb_rotate_right(tree, sibling);
+					sibling = parent->right;
+				}
+				sibling->color = parent->color;
+				parent->color = BLACK;
+				sibling->right->color = BLACK;
+				__itree_rb_rotate_left(tree, parent);
+				node = tree->root;
+			}
+		} else {
+			sibling = parent->left;
+			if (__itree_rb_is_red(sibling)) {
+				sibling->color = BLACK;
+				parent->color = RED;
+				__itree_rb_rotate_right(tree, parent);
+				sibling = parent->left;
+			}
+			if (
+				   0 == __itree_rb_is_red(sibling->left)
+				&& 0 == __itree_rb_is_red(sibling->right)
+			) {
+				sibling->color = RED;
+				node = parent;
+				parent = node->parent;
+			} else {
+				if (0 == __itree_rb_is_red(sibling->left)) {
+					sibling->right->color = BLACK;
+					sibling->color = RED;
+					__itree_rb_rotate_left(tree, sibling);
+					sibling = parent->left;
+				}
+				sibling->color = parent->color;
+				parent->color = BLACK;
+				sibling->left->color = BLACK;
+				__itree_rb_rotate_right(tree, parent);
+				node = tree->root;
+			}
+		}
+	}
+	if (MS_ADDRCK(node)) {
+		node->color = BLACK;
+	}
+}
+
+static inline
+t_itree_rb * __itree_rb_min(t_itree_rb * node)
+{
+	while (MS_ADDRCK(node->left)) {
+		node = node->left;
+	}
+	return (node);
+}
+
+static inline
+t_itree_rb * __itree_rb_max(t_itree_rb * node)
+{
+	while (MS_ADDRCK(node->right)) {
+		node = node->right;
+	}
+	return (node);
+}
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+void itree_rb_init(t_itree_rb_root * tree)
+{
+	if (MS_ADDRCK(tree)) {
+		tree->root = NULL;
+		tree->size = 0;
+	}
+}
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+int itree_rb_is_empty(const t_itree_rb_root * tree)
+{
+	if (
+		   MS_ADDRCK(tree)
+		&& MS_ADDRCK(tree->root)
+	) {
+		return (0);
+	}
+	return (1);
+}
+
+size_t itree_rb_size(const t_itree_rb_root * tree)
+{
+	if (MS_ADDRCK(tree)) {
+		return (tree->size);
+	}
+	return (0);
+}
+
+int itree_rb_insert(
+	  t_itree_rb_root * tree
+	, t_itree_rb * node
+	, int (*f_compare)(t_itree_rb * elem, t_itree_rb * node)
+) {
+	t_itree_rb  * parent;
+	t_itree_rb ** link;
+
+	if (
+		   MS_ADDRNULL(tree)
+		|| MS_ADDRNULL(node)
+		|| MS_ADDRNULL(f_compare)
+	) {
+		return (1);
+	}
+	parent = NULL;
+	link = &tree->root;
+	while (MS_ADDRCK(*link)) {
+		parent = *link;
+		if (f_compare(parent, node) < 0) {
+			link = &parent->left;
+		} else {
+			link = &parent->right;
+		}
+	}
+	node->left   = NULL;
+	node->right  = NULL;
+	node->parent = parent;
+	node->color  = RED;
+	*link = node;
+	++tree->size;
+	__itree_rb_insert_fixup(tree, node);
+	return (0);
+}
+
+void itree_rb_remove(
+	  t_itree_rb_root * tree
+	, t_itree_rb * node
+) {
+	int          color;
+	t_itree_rb * child;
+	t_itree_rb * parent;
+	t_itree_rb * next;
+
+	if (
+		   MS_ADDRNULL(tree)
+		|| MS_ADDRNULL(node)
+	) {
+		return ;
+	}
+	color = node->color;
+	if (MS_ADDRNULL(node->left)) {
+		child = node->right;
+		parent = node->parent;
+		__itree_rb_transplant(tree, node, child);
+	} else if (MS_ADDRNULL(node->right)) {
+		child = node->left;
+		parent = node->parent;
+		__itree_rb_transplant(tree, node, child);
+	} else {
+		next = __itree_rb_min(node->right);
+		color = next->color;
+		child = next->right;
+		parent = next;
+		if (next->parent != node) {
+			parent = next->parent;
+			__itree_rb_transplant(tree, next, child);
+			next->right = node->right;
+			next->right->parent = next;
+		}
+		__itree_rb_transplant(tree, node, next);
+		next->left = node->left;
+		next->left->parent = next;
+		next->color = node->color;
+	}
+	--tree->size;
+	if (BLACK == color) {
+		__itree_rb_remove_fixup(tree, child, parent);
+	}
+	node->left   = NULL;
+	node->right  = NULL;
+	node->parent = NULL;
+}
+
+t_itree_rb * itree_rb_search(
+	  const t_itree_rb_root * tree
+	, void * data
+	, int (*f_compare)(t_itree_rb * elem, void * data)
+) {
+	int          ret;
+	t_itree_rb * node;
+
+	if (
+		   MS_ADDRCK(tree)
+		&& MS_ADDRCK(f_compare)
+	) {
+		node = tree->root;
+		while (MS_ADDRCK(node)) {
+			ret = f_compare(node, data);
+			if (ret < 0) {
+				node = node->left;
+			} else if (ret > 0) {
+				node = node->right;
+			} else {
+				return (node);
+			}
+		}
+	}
+	return (NULL);
+}
+
+t_itree_rb * itree_rb_first(const t_itree_rb_root * tree)
+{
+	if (0 == itree_rb_is_empty(tree)) {
+		return (__itree_rb_min(tree->root));
+	}
+	return (NULL);
+}
+
+t_itree_rb * itree_rb_last(const t_itree_rb_root * tree)
+{
+	if (0 == itree_rb_is_empty(tree)) {
+		return (__itree_rb_max(tree->root));
+	}
+	return (NULL);
+}
+
+t_itree_rb * itree_rb_next(const t_itree_rb * node)
+{
+	if (MS_ADDRNULL(node)) {
+		return (NULL);
+	}
+	if (MS_ADDRCK(node->right)) {
+		return (__itree_rb_min(node->right));
+	}
+	while (
+		   MS_ADDRCK(node->parent)
+		&& node == node->parent->right
+	) {
+		node = node->parent;
+	}
+	return (node->parent);
+}
+
+t_itree_rb * itree_rb_prev(const t_itree_rb * node)
+{
+	if (MS_ADDRNULL(node)) {
+		return (NULL);
+	}
+	if (MS_ADDRCK(node->left)) {
+		return (__itree_rb_max(node->left));
+	}
+	while (
+		   MS_ADDRCK(node->parent)
+		&& node == node->parent->left
+	) {
+		node = node->parent;
+	}
+	return (node->parent);
+}
+
+int itree_rb_in_order(
+	  t_itree_rb_root * tree
+	, void ** content
+	, int (*f_fct)(t_itree_rb * node, void ** content)
+) {
+	int          ret;
+	t_itree_rb * node;
+	t_itree_rb * next;
+
+	ret = 0;
+	if (MS_ADDRCK(f_fct)) {
+		node = itree_rb_first(tree);
+		while (
+			   0 == ret
+			&& MS_ADDRCK(node)
+		) {
+			next = itree_rb_next(node);
+			ret = f_fct(node, content);
+			node = next;
+		}
+	}
+	return (ret);
+}
+
+/* EOF */
\ No newline at end of file
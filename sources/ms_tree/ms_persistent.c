@@ -0,0 +1,318 @@
+# include <ms_tree/ms_persistent.h>
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+/*
+ * Data shared by every copy of a node, freed with the last of them
+*/
+typedef struct s_prb_value
+{
+	size_t        refs;
+	void        * data;
+} t_prb_value;
+
+/*
+ * Nodes are immutable once reachable from a version,
+ * `refs` counts the versions and parent nodes pointing to it
+*/
+struct s_tree_prb
+{
+	void        * data;
+	t_prb_value * value;
+	t_tree_prb  * left;
+	t_tree_prb  * right;
+	size_t        refs;
+	enum colors {
+		RED, BLACK
+	}             color;
+};
+
+/*--------------------------------- PRIVATE METHODS ---------------------------------*/
+
+static inline
+t_tree_prb * __tree_prb_retain(t_tree_prb * node)
+{
+	if (MS_ADDRCK(node)) {
+		MS_ATOMIC_INC(&node->refs);
+	}
+	return (node);
+}
+
+static
+void __tree_prb_release(
+	  t_tree_prb * node
+	, void (*f_free)(void * data)
+) {
+	if (
+		   MS_ADDRCK(node)
+		&& 0 == MS_ATOMIC_DEC(&node->refs)
+	) {
+		__tree_prb_release(node->left, f_free);
+		__tree_prb_release(node->right, f_free);
+		if (0 == MS_ATOMIC_DEC(&node->value->refs)) {
+			if (MS_ADDRCK(f_free)) {
+				f_free(node->value->data);
+			}
+			MS_DEALLOC(node->value);
+		}
+		MS_DEALLOC(node);
+	}
+}
+
+/*
+ * Fresh node (owned by the caller only), taking the given children
+*/
+static inline
+t_tree_prb * __tree_prb_node(
+	  t_prb_value * value
+	, t_tree_prb * left
+	, t_tree_prb * right
+	, int color
+) {
+	t_tree_prb * node;
+
+	node = MS_CAST(t_tree_prb *, MS_ALLOC(sizeof(t_tree_prb)));
+	if (MS_ADDRCK(node)) {
+		node->data  = value->data;
+		node->value = value;
+		node->left  = left;
+		node->right = right;
+		node->refs  = 1;
+		node->color = color;
+		MS_ATOMIC_INC(&value->refs);
+	}
+	return (node);
+}
+
+static inline
+int __tree_prb_is_red(const t_tree_prb * node)
+{
+	if (
+		   MS_ADDRCK(node)
+		&& RED == node->color
+	) {
+		return (1);
+	}
+	return (0);
+}
+
+/*
+ * Okasaki balancing of a fresh black node. A red-red violation can
+ * only come from the copied path, so the nodes involved are fresh
+ * too and are rotated in place.
+*/
+static inline
+t_tree_prb * __tree_prb_balance(t_tree_prb * node)
+{
+	t_tree_prb * x;
+	t_tree_prb * y;
+
+	if (BLACK != node->color) {
+		return (node);
+	}
+	x = node->left;
+	y = node->right;
+	if (__tree_prb_is_red(x) && __tree_prb_is_red(x->left)) {
+		node->left = x->right;
+		x->right = node;
+		x->left->color = BLACK;
+	} else if (__tree_prb_is_red(x) && __tree_prb_is_red(x->right)) {
+		y = x->right;
+		x->right = y->left;
+		node->left = y->right;
+		y->left = x;
+		y->right = node;
+		x->color = BLACK;
+		x = y;
+	} else if (__tree_prb_is_red(y) && __tree_prb_is_red(y->left)) {
+		x = y->left;
+		y->left = x->right;
+		node->right = x->left;
+		x->left = node;
+		x->right = y;
+		y->color = BLACK;
+	} else if (__tree_prb_is_red(y) && __tree_prb_is_red(y->right)) {
+		node->right = y->left;
+		y->left = node;
+		y->right->color = BLACK;
+		x = y;
+	} else {
+		return (node);
+	}
+	node->color = BLACK;
+	x->color = RED;
+	return (x);
+}
+
+static
+t_tree_prb * __tree_prb_insert_recurse(
+	  t_tree_prb * tree
+	, t_prb_value * value
+	, int (*f_compare)(void * elem, void * data)
+) {
+	int          ret;
+	t_tree_prb * child;
+	t_tree_prb * other;
+	t_tree_prb * node;
+
+	if (MS_ADDRNULL(tree)) {
+		return (__tree_prb_node(value, NULL, NULL, RED));
+	}
+	ret = f_compare(tree->data, value->data);
+	child = __tree_prb_insert_recurse(
+		  (ret < 0) ? tree->left : tree->right
+		, value
+		, f_compare
+	);
+	if (MS_ADDRNULL(child)) {
+		return (NULL);
+	}
+	other = __tree_prb_retain((ret < 0) ? tree->right : tree->left);
+	if (ret < 0) {
+		node = __tree_prb_node(tree->value, child, other, tree->color);
+	} else {
+		node = __tree_prb_node(tree->value, other, child, tree->color);
+	}
+	if (MS_ADDRNULL(node)) {
+		__tree_prb_release(child, NULL);
+		__tree_prb_release(other, NULL);
+		return (NULL);
+	}
+	return (__tree_prb_balance(node));
+}
+
+static
+int __tree_prb_in_order(
+	  const t_tree_prb * tree
+	, void ** content
+	, int (*f_fct)(void * data, void ** content)
+) {
+	int ret;
+
+	ret = 0;
+	if (MS_ADDRCK(tree)) {
+		ret = __tree_prb_in_order(tree->left, content, f_fct);
+		if (0 == ret) {
+			ret = f_fct(tree->data, content);
+			if (0 == ret) {
+				ret = __tree_prb_in_order(tree->right, content, f_fct);
+			}
+		}
+	}
+	return (ret);
+}
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+t_tree_prb * tree_prb_snapshot(t_tree_prb * tree)
+{
+	return (__tree_prb_retain(tree));
+}
+
+void tree_prb_destroy(
+	  t_tree_prb ** tree
+	, void (*f_free)(void * data)
+) {
+	if (MS_ADDRCK(tree)) {
+		__tree_prb_release(*tree, f_free);
+		*tree = NULL;
+	}
+}
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+int tree_prb_is_empty(const t_tree_prb * tree)
+{
+	if (MS_ADDRCK(tree)) {
+		return (0);
+	}
+	return (1);
+}
+
+size_t tree_prb_size(const t_tree_prb * tree)
+{
+	if (MS_ADDRCK(tree)) {
+		return (tree_prb_size(tree->left) + 1 + tree_prb_size(tree->right));
+	}
+	return (0);
+}
+
+t_tree_prb * tree_prb_insert(
+	  t_tree_prb * tree
+	, void * data
+	, size_t size
+	, int (*f_compare)(void * elem, void * data)
+) {
+	t_tree_prb  * root;
+	t_prb_value * value;
+
+	if (
+		   MS_ADDRNULL(data)
+		|| MS_ADDRNULL(f_compare)
+	) {
+		return (NULL);
+	}
+	value = MS_CAST(t_prb_value *, MS_ALLOC(sizeof(t_prb_value)));
+	if (MS_ADDRNULL(value)) {
+		return (NULL);
+	}
+	value->refs = 1;
+	value->data = data;
+	if (0 != size) {
+		value->data = MS_ALLOC(size);
+		if (MS_ADDRNULL(value->data)) {
+			MS_DEALLOC(value);
+			return (NULL);
+		}
+		MS_MEMCPY(value->data, data, size);
+	}
+	root = __tree_prb_insert_recurse(tree, value, f_compare);
+	if (MS_ADDRCK(root)) {
+		root->color = BLACK;
+		MS_ATOMIC_DEC(&value->refs);
+		return (root);
+	}
+	if (0 != size) {
+		MS_DEALLOC(value->data);
+	}
+	MS_DEALLOC(value);
+	return (NULL);
+}
+
+void * tree_prb_search(
+	  const t_tree_prb * tree
+	, void * data
+	, int (*f_compare)(void * elem, void * data)
+) {
+	int ret;
+
+	if (
+		   MS_ADDRCK(data)
+		&& MS_ADDRCK(f_compare)
+	) {
+		while (MS_ADDRCK(tree)) {
+			ret = f_compare(tree->data, data);
+			if (ret < 0) {
+				tree = tree->left;
+			} else if (ret > 0) {
+				tree = tree->right;
+			} else {
+				return (tree->data);
+			}
+		}
+	}
+	return (NULL);
+}
+
+int tree_prb_in_order(
+	  const t_tree_prb * tree
+	, void ** content
+	, int (*f_fct)(void * data, void ** content)
+) {
+	if (MS_ADDRCK(f_fct)) {
+		return (__tree_prb_in_order(tree, content, f_fct));
+	}
+	return (0);
+}
+
+/* EOF */
\ No newline at end of file
@@ -0,0 +1,1146 @@
+# include <stdint.h>
+# include <ms_tree/ms_radix.h>
+
+# ifdef __SSE2__
+#  include <emmintrin.h>
+# endif
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+/*
+ * Number of prefix bytes kept inside a node (pessimistic part of the
+ * path compression). Longer prefixes are only checked at the leaf.
+*/
+# define ART_PREFIX_MAX       10
+
+/*
+ * Children are tagged pointers: the low bit set means a leaf
+*/
+# define ART_IS_LEAF(ptr)     (MS_CAST(uintptr_t, (ptr)) & 1)
+# define ART_LEAF_TAG(leaf)   MS_CAST(void *, (MS_CAST(uintptr_t, (leaf)) | 1))
+# define ART_LEAF_RAW(ptr)    (MS_CAST(t_art_leaf *, (MS_CAST(uintptr_t, (ptr)) & ~MS_CAST(uintptr_t, 1))))
+
+enum e_art_type {
+	ART_NODE4, ART_NODE16, ART_NODE48, ART_NODE256
+};
+
+typedef struct s_art_leaf
+{
+	void          * data;
+	size_t          key_len;
+	unsigned char   key[];
+} t_art_leaf;
+
+/*
+ * Header shared by every inner node.
+ * `leaf` holds the key ending exactly after the node prefix.
+*/
+typedef struct s_art_node
+{
+	size_t          prefix_len;
+	t_art_leaf    * leaf;
+	unsigned short  count;
+	unsigned char   type;
+	unsigned char   prefix[ART_PREFIX_MAX];
+} t_art_node;
+
+typedef struct s_art_node4
+{
+	t_art_node      node;
+	unsigned char   keys[4];
+	void          * children[4];
+} t_art_node4;
+
+typedef struct s_art_node16
+{
+	t_art_node      node;
+	unsigned char   keys[16];
+	void          * children[16];
+} t_art_node16;
+
+typedef struct s_art_node48
+{
+	t_art_node      node;
+	unsigned char   index[256];
+	void          * children[48];
+} t_art_node48;
+
+typedef struct s_art_node256
+{
+	t_art_node      node;
+	void          * children[256];
+} t_art_node256;
+
+struct s_tree_art
+{
+	void          * root;
+	size_t          size;
+};
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+static inline
+void __tree_art_destroy_recurse(
+	  void * ptr
+	, void (*f_free)(void * data)
+);
+
+int tree_art_init(t_tree_art ** tree)
+{
+	if (MS_ADDRCK(tree)) {
+		*tree = MS_CAST(t_tree_art *, MS_ALLOC(sizeof(t_tree_art)));
+		if (MS_ADDRCK(*tree)) {
+			MS_MEMSET(*tree, 0, sizeof(t_tree_art));
+			return (0);
+		}
+	}
+	return (1);
+}
+
+void tree_art_destroy(
+	  t_tree_art * tree
+	, void (*f_free)(void * data)
+) {
+	if (MS_ADDRCK(tree)) {
+		__tree_art_destroy_recurse(tree->root, f_free);
+		MS_DEALLOC(tree);
+	}
+}
+
+/*--------------------------------- PRIVATE METHODS ---------------------------------*/
+
+static inline
+void __tree_art_leaf_destroy(
+	  t_art_leaf * leaf
+	, void (*f_free)(void * data)
+) {
+	if (MS_ADDRCK(leaf)) {
+		if (MS_ADDRCK(f_free)) {
+			f_free(leaf->data);
+		}
+		MS_DEALLOC(leaf);
+	}
+}
+
+static inline
+t_art_leaf * __tree_art_leaf(
+	  void * data
+	, size_t size
+	, unsigned char * key
+	, size_t key_len
+) {
+	void       * copy;
+	t_art_leaf * leaf;
+
+	leaf = MS_CAST(t_art_leaf *, MS_ALLOC(sizeof(t_art_leaf) + key_len));
+	if (MS_ADDRCK(leaf)) {
+		leaf->key_len = key_len;
+		MS_MEMCPY(leaf->key, key, key_len);
+		if (0 == size) {
+			leaf->data = data;
+		} else {
+			copy = MS_ALLOC(size);
+			if (MS_ADDRCK(copy)) {
+				MS_MEMCPY(copy, data, size);
+				leaf->data = copy;
+			} else {
+				MS_DEALLOC(leaf);
+				return (NULL);
+			}
+		}
+	}
+	return (leaf);
+}
+
+static inline
+int __tree_art_leaf_match(
+	  const t_art_leaf * leaf
+	, const unsigned char * key
+	, size_t key_len
+) {
+	if (
+		   leaf->key_len == key_len
+		&& 0 == MS_MEMCMP(leaf->key, key, key_len)
+	) {
+		return (1);
+	}
+	return (0);
+}
+
+static inline
+t_art_node * __tree_art_node(unsigned char type)
+{
+	size_t       size;
+	t_art_node * node;
+
+	if (ART_NODE4 == type) {
+		size = sizeof(t_art_node4);
+	} else if (ART_NODE16 == type) {
+		size = sizeof(t_art_node16);
+	} else if (ART_NODE48 == type) {
+		size = sizeof(t_art_node48);
+	} else {
+		size = sizeof(t_art_node256);
+	}
+	node = MS_CAST(t_art_node *, MS_ALLOC(size));
+	if (MS_ADDRCK(node)) {
+		MS_MEMSET(node, 0, size);
+		node->type = type;
+	}
+	return (node);
+}
+
+static inline
+void __tree_art_copy_header(
+	  t_art_node * dst
+	, const t_art_node * src
+) {
+	dst->prefix_len = src->prefix_len;
+	dst->leaf       = src->leaf;
+	dst->count      = src->count;
+	MS_MEMCPY(dst->prefix, src->prefix, ART_PREFIX_MAX);
+}
+
+/*
+ * Position of the first key of a sorted Node4/Node16 which is >= c
+*/
+static inline
+unsigned int __tree_art_lower_bound(
+	  const unsigned char * keys
+	, unsigned int count
+	, unsigned char c
+) {
+	unsigned int i;
+
+	i = 0;
+	while (
+		   i < count
+		&& keys[i] < c
+	) {
+		++i;
+	}
+	return (i);
+}
+
+static inline
+void ** __tree_art_find_child_16(
+	  t_art_node16 * node
+	, unsigned char c
+) {
+#ifdef __SSE2__
+	int          mask;
+	__m128i      cmp;
+
+	cmp  = _mm_cmpeq_epi8(
+		  _mm_set1_epi8(MS_CAST(char, c))
+		, _mm_loadu_si128(MS_CAST(const __m128i *, node->keys))
+	);
+	mask = _mm_movemask_epi8(cmp) & ((1 << node->node.count) - 1);
+	if (0 != mask) {
+		return (&node->children[__builtin_ctz(MS_CAST(unsigned int, mask))]);
+	}
+#else
+	unsigned int i;
+
+	i = 0;
+	while (i < node->node.count) {
+		if (node->keys[i] == c) {
+			return (&node->children[i]);
+		}
+		++i;
+	}
+#endif
+	return (NULL);
+}
+
+static inline
+void ** __tree_art_find_child(
+	  t_art_node * node
+	, unsigned char c
+) {
+	unsigned int    i;
+	t_art_node4   * node4;
+	t_art_node48  * node48;
+	t_art_node256 * node256;
+
+	if (ART_NODE4 == node->type) {
+		node4 = MS_CAST(t_art_node4 *, node);
+		i = 0;
+		while (i < node->count) {
+			if (node4->keys[i] == c) {
+				return (&node4->children[i]);
+			}
+			++i;
+		}
+	} else if (ART_NODE16 == node->type) {
+		return (__tree_art_find_child_16(MS_CAST(t_art_node16 *, node), c));
+	} else if (ART_NODE48 == node->type) {
+		node48 = MS_CAST(t_art_node48 *, node);
+		if (0 != node48->index[c]) {
+			return (&node48->children[node48->index[c] - 1]);
+		}
+	} else {
+		node256 = MS_CAST(t_art_node256 *, node);
+		if (MS_ADDRCK(node256->children[c])) {
+			return (&node256->children[c]);
+		}
+	}
+	return (NULL);
+}
+
+/*
+ * Leftmost leaf below a node, used to recover the prefix bytes
+ * which do not fit in ART_PREFIX_MAX
+*/
+static inline
+t_art_leaf * __tree_art_minimum(void * ptr)
+{
+	unsigned int    i;
+	t_art_node    * node;
+
+	while (
+		   MS_ADDRCK(ptr)
+		&& !ART_IS_LEAF(ptr)
+	) {
+		node = MS_CAST(t_art_node *, ptr);
+		if (MS_ADDRCK(node->leaf)) {
+			return (node->leaf);
+		}
+		if (ART_NODE4 == node->type) {
+			ptr = (MS_CAST(t_art_node4 *, node))->children[0];
+		} else if (ART_NODE16 == node->type) {
+			ptr = (MS_CAST(t_art_node16 *, node))->children[0];
+		} else if (ART_NODE48 == node->type) {
+			i = 0;
+			while (0 == (MS_CAST(t_art_node48 *, node))->index[i]) {
+				++i;
+			}
+			ptr = (MS_CAST(t_art_node48 *, node))->children[
+				(MS_CAST(t_art_node48 *, node))->index[i] - 1
+			];
+		} else {
+			i = 0;
+			while (MS_ADDRNULL((MS_CAST(t_art_node256 *, node))->children[i])) {
+				++i;
+			}
+			ptr = (MS_CAST(t_art_node256 *, node))->children[i];
+		}
+	}
+	if (MS_ADDRCK(ptr)) {
+		return (ART_LEAF_RAW(ptr));
+	}
+	return (NULL);
+}
+
+/*
+ * Number of prefix bytes of the node matching the key from depth
+*/
+static inline
+size_t __tree_art_prefix_mismatch(
+	  t_art_node * node
+	, const unsigned char * key
+	, size_t key_len
+	, size_t depth
+) {
+	size_t       i;
+	size_t       max;
+	t_art_leaf * leaf;
+
+	max = node->prefix_len;
+	if (max > key_len - depth) {
+		max = key_len - depth;
+	}
+	i = 0;
+	while (
+		   i < max
+		&& i < ART_PREFIX_MAX
+	) {
+		if (node->prefix[i] != key[depth + i]) {
+			return (i);
+		}
+		++i;
+	}
+	if (i < max) {
+		leaf = __tree_art_minimum(node);
+		while (i < max) {
+			if (leaf->key[depth + i] != key[depth + i]) {
+				return (i);
+			}
+			++i;
+		}
+	}
+	return (i);
+}
+
+static inline
+void __tree_art_grow(
+	  void ** ref
+	, t_art_node * node
+) {
+	unsigned int    i;
+	t_art_node    * grown;
+
+	grown = __tree_art_node(node->type + 1);
+	if (MS_ADDRNULL(grown)) {
+		return ;
+	}
+	__tree_art_copy_header(grown, node);
+	if (ART_NODE4 == node->type) {
+		MS_MEMCPY(
+			  (MS_CAST(t_art_node16 *, grown))->keys
+			, (MS_CAST(t_art_node4 *, node))->keys
+			, 4
+		);
+		MS_MEMCPY(
+			  (MS_CAST(t_art_node16 *, grown))->children
+			, (MS_CAST(t_art_node4 *, node))->children
+			, 4 * sizeof(void *)
+		);
+	} else if (ART_NODE16 == node->type) {
+		i = 0;
+		while (i < node->count) {
+			(MS_CAST(t_art_node48 *, grown))->index[
+				(MS_CAST(t_art_node16 *, node))->keys[i]
+			] = MS_CAST(unsigned char, i + 1);
+			(MS_CAST(t_art_node48 *, grown))->children[i] =
+				(MS_CAST(t_art_node16 *, node))->children[i];
+			++i;
+		}
+	} else {
+		i = 0;
+		while (i < 256) {
+			if (0 != (MS_CAST(t_art_node48 *, node))->index[i]) {
+				(MS_CAST(t_art_node256 *, grown))->children[i] =
+					(MS_CAST(t_art_node48 *, node))->children[
+						(MS_CAST(t_art_node48 *, node))->index[i] - 1
+					];
+			}
+			++i;
+		}
+	}
+	*ref = grown;
+	MS_DEALLOC(node);
+}
+
+static inline
+int __tree_art_add_child(
+	  void ** ref
+	, t_art_node * node
+	, unsigned char c
+	, void * child
+) {
+	unsigned int    i;
+	t_art_node4   * node4;
+	t_art_node16  * node16;
+	t_art_node48  * node48;
+
+	if (
+		   (ART_NODE4 == node->type && 4 == node->count)
+		|| (ART_NODE16 == node->type && 16 == node->count)
+		|| (ART_NODE48 == node->type && 48 == node->count)
+	) {
+		__tree_art_grow(ref, node);
+		if (*ref == node) {
+			return (1);
+		}
+		node = MS_CAST(t_art_node *, *ref);
+	}
+	if (ART_NODE4 == node->type) {
+		node4 = MS_CAST(t_art_node4 *, node);
+		i = __tree_art_lower_bound(node4->keys, node->count, c);
+		MS_MEMMOVE(node4->keys + i + 1, node4->keys + i, node->count - i);
+		MS_MEMMOVE(
+			  node4->children + i + 1
+			, node4->children + i
+			, (node->count - i) * sizeof(void *)
+		);
+		node4->keys[i]     = c;
+		node4->children[i] = child;
+	} else if (ART_NODE16 == node->type) {
+		node16 = MS_CAST(t_art_node16 *, node);
+		i = __tree_art_lower_bound(node16->keys, node->count, c);
+		MS_MEMMOVE(node16->keys + i + 1, node16->keys + i, node->count - i);
+		MS_MEMMOVE(
+			  node16->children + i + 1
+			, node16->children + i
+			, (node->count - i) * sizeof(void *)
+		);
+		node16->keys[i]     = c;
+		node16->children[i] = child;
+	} else if (ART_NODE48 == node->type) {
+		node48 = MS_CAST(t_art_node48 *, node);
+		i = 0;
+		while (MS_ADDRCK(node48->children[i])) {
+			++i;
+		}
+		node48->children[i] = child;
+		node48->index[c]    = MS_CAST(unsigned char, i + 1);
+	} else {
+		(MS_CAST(t_art_node256 *, node))->children[c] = child;
+	}
+	++node->count;
+	return (0);
+}
+
+static inline
+void __tree_art_remove_child(
+	  t_art_node * node
+	, unsigned char c
+) {
+	unsigned int    i;
+	t_art_node4   * node4;
+	t_art_node16  * node16;
+	t_art_node48  * node48;
+
+	if (ART_NODE4 == node->type) {
+		node4 = MS_CAST(t_art_node4 *, node);
+		i = __tree_art_lower_bound(node4->keys, node->count, c);
+		MS_MEMMOVE(node4->keys + i, node4->keys + i + 1, node->count - i - 1);
+		MS_MEMMOVE(
+			  node4->children + i
+			, node4->children + i + 1
+			, (node->count - i - 1) * sizeof(void *)
+		);
+	} else if (ART_NODE16 == node->type) {
+		node16 = MS_CAST(t_art_node16 *, node);
+		i = __tree_art_lower_bound(node16->keys, node->count, c);
+		MS_MEMMOVE(node16->keys + i, node16->keys + i + 1, node->count - i - 1);
+		MS_MEMMOVE(
+			  node16->children + i
+			, node16->children + i + 1
+			, (node->count - i - 1) * sizeof(void *)
+		);
+	} else if (ART_NODE48 == node->type) {
+		node48 = MS_CAST(t_art_node48 *, node);
+		node48->children[node48->index[c] - 1] = NULL;
+		node48->index[c] = 0;
+	} else {
+		(MS_CAST(t_art_node256 *, node))->children[c] = NULL;
+	}
+	--node->count;
+}
+
+/*
+ * Merge a Node4 holding a single child (and no leaf) into this child
+*/
+static inline
+void __tree_art_collapse(
+	  void ** ref
+	, t_art_node4 * node
+) {
+	size_t       len;
+	size_t       prefix_len;
+	void       * child;
+	t_art_node * inner;
+
+	child = node->children[0];
+	if (!ART_IS_LEAF(child)) {
+		inner = MS_CAST(t_art_node *, child);
+		prefix_len = node->node.prefix_len;
+		if (prefix_len > ART_PREFIX_MAX) {
+			prefix_len = ART_PREFIX_MAX;
+		}
+		if (prefix_len < ART_PREFIX_MAX) {
+			node->node.prefix[prefix_len] = node->keys[0];
+			++prefix_len;
+		}
+		if (prefix_len < ART_PREFIX_MAX) {
+			len = inner->prefix_len;
+			if (len > ART_PREFIX_MAX - prefix_len) {
+				len = ART_PREFIX_MAX - prefix_len;
+			}
+			MS_MEMCPY(node->node.prefix + prefix_len, inner->prefix, len);
+			prefix_len += len;
+		}
+		MS_MEMCPY(inner->prefix, node->node.prefix, prefix_len);
+		inner->prefix_len += node->node.prefix_len + 1;
+	}
+	*ref = child;
+	MS_DEALLOC(node);
+}
+
+static inline
+void __tree_art_shrink(void ** ref)
+{
+	unsigned int    i;
+	unsigned int    j;
+	t_art_node    * node;
+	t_art_node    * shrunk;
+
+	node = MS_CAST(t_art_node *, *ref);
+	if (0 == node->count) {
+		if (MS_ADDRCK(node->leaf)) {
+			*ref = ART_LEAF_TAG(node->leaf);
+		} else {
+			*ref = NULL;
+		}
+		MS_DEALLOC(node);
+	} else if (ART_NODE4 == node->type) {
+		if (
+			   1 == node->count
+			&& MS_ADDRNULL(node->leaf)
+		) {
+			__tree_art_collapse(ref, MS_CAST(t_art_node4 *, node));
+		}
+	} else if (
+		   (ART_NODE16 == node->type && node->count <= 3)
+		|| (ART_NODE48 == node->type && node->count <= 12)
+		|| (ART_NODE256 == node->type && node->count <= 36)
+	) {
+		shrunk = __tree_art_node(node->type - 1);
+		if (MS_ADDRNULL(shrunk)) {
+			return ;
+		}
+		__tree_art_copy_header(shrunk, node);
+		if (ART_NODE16 == node->type) {
+			MS_MEMCPY(
+				  (MS_CAST(t_art_node4 *, shrunk))->keys
+				, (MS_CAST(t_art_node16 *, node))->keys
+				, node->count
+			);
+			MS_MEMCPY(
+				  (MS_CAST(t_art_node4 *, shrunk))->children
+				, (MS_CAST(t_art_node16 *, node))->children
+				, node->count * sizeof(void *)
+			);
+		} else if (ART_NODE48 == node->type) {
+			i = 0;
+			j = 0;
+			while (i < 256) {
+				if (0 != (MS_CAST(t_art_node48 *, node))->index[i]) {
+					(MS_CAST(t_art_node16 *, shrunk))->keys[j] = MS_CAST(unsigned char, i);
+					(MS_CAST(t_art_node16 *, shrunk))->children[j] =
+						(MS_CAST(t_art_node48 *, node))->children[
+							(MS_CAST(t_art_node48 *, node))->index[i] - 1
+						];
+					++j;
+				}
+				++i;
+			}
+		} else {
+			i = 0;
+			j = 0;
+			while (i < 256) {
+				if (MS_ADDRCK((MS_CAST(t_art_node256 *, node))->children[i])) {
+					(MS_CAST(t_art_node48 *, shrunk))->index[i] = MS_CAST(unsigned char, j + 1);
+					(MS_CAST(t_art_node48 *, shrunk))->children[j] =
+						(MS_CAST(t_art_node256 *, node))->children[i];
+					++j;
+				}
+				++i;
+			}
+		}
+		*ref = shrunk;
+		MS_DEALLOC(node);
+	}
+}
+
+/*
+ * Attach a leaf under a freshly split node at the given depth
+*/
+static inline
+int __tree_art_attach(
+	  void ** ref
+	, t_art_leaf * leaf
+	, size_t depth
+) {
+	t_art_node * node;
+
+	node = MS_CAST(t_art_node *, *ref);
+	if (leaf->key_len == depth) {
+		node->leaf = leaf;
+		return (0);
+	}
+	return (__tree_art_add_child(ref, node, leaf->key[depth], ART_LEAF_TAG(leaf)));
+}
+
+static inline
+int __tree_art_split_leaf(
+	  void ** ref
+	, t_art_leaf * leaf
+	, size_t depth
+) {
+	size_t       i;
+	size_t       max;
+	void       * split;
+	t_art_leaf * other;
+
+	other = ART_LEAF_RAW(*ref);
+	max = leaf->key_len;
+	if (max > other->key_len) {
+		max = other->key_len;
+	}
+	i = depth;
+	while (
+		   i < max
+		&& leaf->key[i] == other->key[i]
+	) {
+		++i;
+	}
+	split = __tree_art_node(ART_NODE4);
+	if (MS_ADDRNULL(split)) {
+		return (1);
+	}
+	(MS_CAST(t_art_node *, split))->prefix_len = i - depth;
+	MS_MEMCPY(
+		  (MS_CAST(t_art_node *, split))->prefix
+		, leaf->key + depth
+		, ((i - depth) < ART_PREFIX_MAX) ? (i - depth) : ART_PREFIX_MAX
+	);
+	__tree_art_attach(&split, other, i);
+	__tree_art_attach(&split, leaf, i);
+	*ref = split;
+	return (0);
+}
+
+static inline
+int __tree_art_split_prefix(
+	  void ** ref
+	, t_art_leaf * leaf
+	, size_t depth
+	, size_t mismatch
+) {
+	unsigned char   c;
+	void          * split;
+	t_art_node    * node;
+	t_art_leaf    * minimum;
+
+	node = MS_CAST(t_art_node *, *ref);
+	split = __tree_art_node(ART_NODE4);
+	if (MS_ADDRNULL(split)) {
+		return (1);
+	}
+	(MS_CAST(t_art_node *, split))->prefix_len = mismatch;
+	MS_MEMCPY(
+		  (MS_CAST(t_art_node *, split))->prefix
+		, node->prefix
+		, (mismatch < ART_PREFIX_MAX) ? mismatch : ART_PREFIX_MAX
+	);
+	if (node->prefix_len <= ART_PREFIX_MAX) {
+		c = node->prefix[mismatch];
+		node->prefix_len -= mismatch + 1;
+		MS_MEMMOVE(node->prefix, node->prefix + mismatch + 1, node->prefix_len);
+	} else {
+		minimum = __tree_art_minimum(node);
+		c = minimum->key[depth + mismatch];
+		node->prefix_len -= mismatch + 1;
+		MS_MEMCPY(
+			  node->prefix
+			, minimum->key + depth + mismatch + 1
+			, (node->prefix_len < ART_PREFIX_MAX) ? node->prefix_len : ART_PREFIX_MAX
+		);
+	}
+	__tree_art_add_child(&split, MS_CAST(t_art_node *, split), c, node);
+	__tree_art_attach(&split, leaf, depth + mismatch);
+	*ref = split;
+	return (0);
+}
+
+static inline
+int __tree_art_insert_recurse(
+	  void ** ref
+	, t_art_leaf * leaf
+	, size_t depth
+) {
+	size_t       mismatch;
+	void      ** child;
+	t_art_node * node;
+
+	if (MS_ADDRNULL(*ref)) {
+		*ref = ART_LEAF_TAG(leaf);
+		return (0);
+	}
+	if (ART_IS_LEAF(*ref)) {
+		if (__tree_art_leaf_match(ART_LEAF_RAW(*ref), leaf->key, leaf->key_len)) {
+			return (1);
+		}
+		return (__tree_art_split_leaf(ref, leaf, depth));
+	}
+	node = MS_CAST(t_art_node *, *ref);
+	if (0 != node->prefix_len) {
+		mismatch = __tree_art_prefix_mismatch(node, leaf->key, leaf->key_len, depth);
+		if (mismatch < node->prefix_len) {
+			return (__tree_art_split_prefix(ref, leaf, depth, mismatch));
+		}
+		depth += node->prefix_len;
+	}
+	if (leaf->key_len == depth) {
+		if (MS_ADDRCK(node->leaf)) {
+			return (1);
+		}
+		node->leaf = leaf;
+		return (0);
+	}
+	child = __tree_art_find_child(node, leaf->key[depth]);
+	if (MS_ADDRCK(child)) {
+		return (__tree_art_insert_recurse(child, leaf, depth + 1));
+	}
+	return (__tree_art_add_child(ref, node, leaf->key[depth], ART_LEAF_TAG(leaf)));
+}
+
+/*
+ * Optimistic check of the stored prefix bytes, the leaf comparison
+ * validates the bytes beyond ART_PREFIX_MAX
+*/
+static inline
+int __tree_art_prefix_check(
+	  const t_art_node * node
+	, const unsigned char * key
+	, size_t key_len
+	, size_t depth
+) {
+	size_t i;
+	size_t max;
+
+	if (node->prefix_len > key_len - depth) {
+		return (0);
+	}
+	max = (node->prefix_len < ART_PREFIX_MAX) ? node->prefix_len : ART_PREFIX_MAX;
+	i = 0;
+	while (i < max) {
+		if (node->prefix[i] != key[depth + i]) {
+			return (0);
+		}
+		++i;
+	}
+	return (1);
+}
+
+static inline
+t_art_leaf * __tree_art_remove_recurse(
+	  void ** ref
+	, unsigned char * key
+	, size_t key_len
+	, size_t depth
+) {
+	void      ** child;
+	t_art_leaf * leaf;
+	t_art_node * node;
+
+	if (ART_IS_LEAF(*ref)) {
+		leaf = ART_LEAF_RAW(*ref);
+		if (__tree_art_leaf_match(leaf, key, key_len)) {
+			*ref = NULL;
+			return (leaf);
+		}
+		return (NULL);
+	}
+	node = MS_CAST(t_art_node *, *ref);
+	if (0 == __tree_art_prefix_check(node, key, key_len, depth)) {
+		return (NULL);
+	}
+	depth += node->prefix_len;
+	if (key_len == depth) {
+		leaf = node->leaf;
+		if (
+			   MS_ADDRCK(leaf)
+			&& __tree_art_leaf_match(leaf, key, key_len)
+		) {
+			node->leaf = NULL;
+			__tree_art_shrink(ref);
+			return (leaf);
+		}
+		return (NULL);
+	}
+	child = __tree_art_find_child(node, key[depth]);
+	if (MS_ADDRNULL(child)) {
+		return (NULL);
+	}
+	if (ART_IS_LEAF(*child)) {
+		leaf = ART_LEAF_RAW(*child);
+		if (__tree_art_leaf_match(leaf, key, key_len)) {
+			__tree_art_remove_child(node, key[depth]);
+			__tree_art_shrink(ref);
+			return (leaf);
+		}
+		return (NULL);
+	}
+	return (__tree_art_remove_recurse(child, key, key_len, depth + 1));
+}
+
+static inline
+int __tree_art_iter(
+	  void * ptr
+	, void ** content
+	, int (*f_fct)(void * data, void ** content)
+) {
+	int             ret;
+	unsigned int    i;
+	t_art_node    * node;
+
+	if (ART_IS_LEAF(ptr)) {
+		return (f_fct(ART_LEAF_RAW(ptr)->data, content));
+	}
+	ret = 0;
+	node = MS_CAST(t_art_node *, ptr);
+	if (MS_ADDRCK(node->leaf)) {
+		ret = f_fct(node->leaf->data, content);
+	}
+	i = 0;
+	if (ART_NODE4 == node->type) {
+		while (0 == ret && i < node->count) {
+			ret = __tree_art_iter((MS_CAST(t_art_node4 *, node))->children[i], content, f_fct);
+			++i;
+		}
+	} else if (ART_NODE16 == node->type) {
+		while (0 == ret && i < node->count) {
+			ret = __tree_art_iter((MS_CAST(t_art_node16 *, node))->children[i], content, f_fct);
+			++i;
+		}
+	} else if (ART_NODE48 == node->type) {
+		while (0 == ret && i < 256) {
+			if (0 != (MS_CAST(t_art_node48 *, node))->index[i]) {
+				ret = __tree_art_iter(
+					  (MS_CAST(t_art_node48 *, node))->children[
+						(MS_CAST(t_art_node48 *, node))->index[i] - 1
+					  ]
+					, content
+					, f_fct
+				);
+			}
+			++i;
+		}
+	} else {
+		while (0 == ret && i < 256) {
+			if (MS_ADDRCK((MS_CAST(t_art_node256 *, node))->children[i])) {
+				ret = __tree_art_iter(
+					  (MS_CAST(t_art_node256 *, node))->children[i]
+					, content
+					, f_fct
+				);
+			}
+			++i;
+		}
+	}
+	return (ret);
+}
+
+static inline
+void __tree_art_destroy_recurse(
+	  void * ptr
+	, void (*f_free)(void * data)
+) {
+	unsigned int    i;
+	t_art_node    * node;
+
+	if (MS_ADDRNULL(ptr)) {
+		return ;
+	}
+	if (ART_IS_LEAF(ptr)) {
+		__tree_art_leaf_destroy(ART_LEAF_RAW(ptr), f_free);
+		return ;
+	}
+	node = MS_CAST(t_art_node *, ptr);
+	__tree_art_leaf_destroy(node->leaf, f_free);
+	i = 0;
+	if (ART_NODE4 == node->type) {
+		while (i < node->count) {
+			__tree_art_destroy_recurse((MS_CAST(t_art_node4 *, node))->children[i], f_free);
+			++i;
+		}
+	} else if (ART_NODE16 == node->type) {
+		while (i < node->count) {
+			__tree_art_destroy_recurse((MS_CAST(t_art_node16 *, node))->children[i], f_free);
+			++i;
+		}
+	} else if (ART_NODE48 == node->type) {
+		while (i < 48) {
+			__tree_art_destroy_recurse((MS_CAST(t_art_node48 *, node))->children[i], f_free);
+			++i;
+		}
+	} else {
+		while (i < 256) {
+			__tree_art_destroy_recurse((MS_CAST(t_art_node256 *, node))->children[i], f_free);
+			++i;
+		}
+	}
+	MS_DEALLOC(node);
+}
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+int tree_art_is_empty(const t_tree_art * tree)
+{
+	if (MS_ADDRCK(tree)) {
+		if (MS_ADDRCK(tree->root)) {
+			return (0);
+		}
+	}
+	return (1);
+}
+
+size_t tree_art_size(const t_tree_art * tree)
+{
+	if (MS_ADDRCK(tree)) {
+		return (tree->size);
+	}
+	return (0);
+}
+
+int tree_art_insert(
+	  t_tree_art * tree
+	, void * data
+	, size_t size
+	, unsigned char * key
+	, size_t key_len
+) {
+	t_art_leaf * leaf;
+
+	if (
+		   MS_ADDRCK(tree)
+		&& MS_ADDRCK(data)
+		&& MS_ADDRCK(key)
+	) {
+		leaf = __tree_art_leaf(data, size, key, key_len);
+		if (MS_ADDRCK(leaf)) {
+			if (0 == __tree_art_insert_recurse(&tree->root, leaf, 0)) {
+				++tree->size;
+				return (0);
+			}
+			if (0 != size) {
+				MS_DEALLOC(leaf->data);
+			}
+			MS_DEALLOC(leaf);
+		}
+	}
+	return (1);
+}
+
+void * tree_art_search(
+	  t_tree_art * tree
+	, unsigned char * key
+	, size_t key_len
+	, int flag
+) {
+	size_t       depth;
+	void      ** child;
+	void       * ptr;
+	void       * data;
+	t_art_leaf * leaf;
+	t_art_node * node;
+
+	if (
+		   MS_ADDRNULL(tree)
+		|| MS_ADDRNULL(key)
+		|| MS_ADDRNULL(tree->root)
+	) {
+		return (NULL);
+	}
+	if (MS_ELEMENT_REMOVE & flag) {
+		leaf = __tree_art_remove_recurse(&tree->root, key, key_len, 0);
+		if (MS_ADDRNULL(leaf)) {
+			return (NULL);
+		}
+		--tree->size;
+		data = leaf->data;
+		MS_DEALLOC(leaf);
+		return (data);
+	}
+	depth = 0;
+	ptr = tree->root;
+	while (MS_ADDRCK(ptr)) {
+		if (ART_IS_LEAF(ptr)) {
+			leaf = ART_LEAF_RAW(ptr);
+			if (__tree_art_leaf_match(leaf, key, key_len)) {
+				return (leaf->data);
+			}
+			return (NULL);
+		}
+		node = MS_CAST(t_art_node *, ptr);
+		if (0 == __tree_art_prefix_check(node, key, key_len, depth)) {
+			return (NULL);
+		}
+		depth += node->prefix_len;
+		if (key_len == depth) {
+			if (
+				   MS_ADDRCK(node->leaf)
+				&& __tree_art_leaf_match(node->leaf, key, key_len)
+			) {
+				return (node->leaf->data);
+			}
+			return (NULL);
+		}
+		child = __tree_art_find_child(node, key[depth]);
+		if (MS_ADDRNULL(child)) {
+			return (NULL);
+		}
+		ptr = *child;
+		++depth;
+	}
+	return (NULL);
+}
+
+int tree_art_in_order(
+	  t_tree_art * tree
+	, void ** content
+	, int (*f_fct)(void * data, void ** content)
+) {
+	if (
+		   MS_ADDRCK(tree)
+		&& MS_ADDRCK(f_fct)
+		&& MS_ADDRCK(tree->root)
+	) {
+		return (__tree_art_iter(tree->root, content, f_fct));
+	}
+	return (0);
+}
+
+int tree_art_prefix(
+	  t_tree_art * tree
+	, unsigned char * prefix
+	, size_t prefix_len
+	, void ** content
+	, int (*f_fct)(void * data, void ** content)
+) {
+	size_t       depth;
+	size_t       mismatch;
+	void      ** child;
+	void       * ptr;
+	t_art_leaf * leaf;
+	t_art_node * node;
+
+	if (
+		   MS_ADDRNULL(tree)
+		|| MS_ADDRNULL(f_fct)
+		|| (MS_ADDRNULL(prefix) && 0 != prefix_len)
+	) {
+		return (0);
+	}
+	depth = 0;
+	ptr = tree->root;
+	while (MS_ADDRCK(ptr)) {
+		if (ART_IS_LEAF(ptr)) {
+			leaf = ART_LEAF_RAW(ptr);
+			if (
+				   leaf->key_len >= prefix_len
+				&& 0 == MS_MEMCMP(leaf->key, prefix, prefix_len)
+			) {
+				return (f_fct(leaf->data, content));
+			}
+			return (0);
+		}
+		if (depth == prefix_len) {
+			return (__tree_art_iter(ptr, content, f_fct));
+		}
+		node = MS_CAST(t_art_node *, ptr);
+		if (0 != node->prefix_len) {
+			mismatch = __tree_art_prefix_mismatch(node, prefix, prefix_len, depth);
+			if (depth + mismatch == prefix_len) {
+				return (__tree_art_iter(ptr, content, f_fct));
+			}
+			if (mismatch < node->prefix_len) {
+				return (0);
+			}
+			depth += node->prefix_len;
+		}
+		child = __tree_art_find_child(node, prefix[depth]);
+		if (MS_ADDRNULL(child)) {
+			return (0);
+		}
+		ptr = *child;
+		++depth;
+	}
+	return (0);
+}
+
+/* EOF */
\ No newline at end of file
@@ -2,6 +2,11 @@
 
 /*----------------------------------- STRUCTURES ------------------------------------*/
 
+/*
+ * Number of descents advanced in lockstep by tree_rb_search_batch
+*/
+# define TREE_RB_BATCH        16
+
 struct s_tree_rb
 {
 	void        * data;
@@ -13,6 +18,28 @@ struct s_tree_rb
 	}             color;
 };
 
+/*
+ * A subtree handled by a task of the parallel methods, `height` nodes
+ * on its leftmost path. The reduction folds the subtree into `partial`,
+ * which starts as a copy of `identity`
+*/
+typedef struct s_tree_rb_parallel
+{
+	t_tree_rb  * tree;
+	size_t       height;
+	size_t       grain;
+	t_pool     * pool;
+	void         (*f_free)(void * data);
+	void      ** content;
+	int          (*f_fct)(void * data, void ** content);
+	int        * ret;
+	void       * partial;
+	const void * identity;
+	size_t       size;
+	void         (*f_map)(void * partial, void * data);
+	void         (*f_combine)(void * partial, const void * other);
+} t_tree_rb_parallel;
+
 /*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
 
 t_tree_rb * tree_rb_leef(
@@ -244,8 +271,260 @@ int __tree_rb_insert_recurse(
 	return (ret);
 }
 
+static inline
+size_t __tree_rb_search_group(
+	  t_tree_rb * root
+	, void ** datas
+	, size_t count
+	, void ** elems
+	, int (*f_compare)(void * elem, void * data)
+) {
+	int         ret;
+	size_t      i;
+	size_t      found;
+	size_t      active;
+	t_tree_rb * node[TREE_RB_BATCH];
+
+	i = 0;
+	while (i < count) {
+		node[i] = root;
+		elems[i] = NULL;
+		++i;
+	}
+	found = 0;
+	active = MS_ADDRCK(root) ? count : 0;
+	while (0 != active) {
+		i = 0;
+		while (i < count) {
+			if (MS_ADDRCK(node[i])) {
+				MS_PREFETCH(node[i]->data);
+			}
+			++i;
+		}
+		i = 0;
+		while (i < count) {
+			if (MS_ADDRCK(node[i])) {
+				ret = f_compare(node[i]->data, datas[i]);
+				if (0 == ret) {
+					elems[i] = node[i]->data;
+					node[i] = NULL;
+					++found;
+				} else if (ret < 0) {
+					node[i] = node[i]->left;
+				} else {
+					node[i] = node[i]->right;
+				}
+				if (MS_ADDRCK(node[i])) {
+					MS_PREFETCH(node[i]);
+				} else {
+					--active;
+				}
+			}
+			++i;
+		}
+	}
+	return (found);
+}
+
+static inline
+size_t __tree_rb_collect(
+	  t_tree_rb * tree
+	, void ** datas
+	, size_t i
+) {
+	if (MS_ADDRCK(tree)) {
+		i = __tree_rb_collect(tree->left, datas, i);
+		datas[i] = tree->data;
+		i = __tree_rb_collect(tree->right, datas, i + 1);
+	}
+	return (i);
+}
+
+/*
+ * Being balanced, a subtree holds about 2^height nodes: the ones
+ * below the grain are handled on the spot by a single task. The height
+ * is that of the leftmost path, a shorter subtree may reach NULL first
+*/
+static inline
+int __tree_rb_is_small(const t_tree_rb_parallel * parallel)
+{
+	return (
+		   0 == parallel->height
+		|| (
+			   parallel->height < 8 * sizeof(size_t)
+			&& (MS_CAST(size_t, 1) << parallel->height) <= parallel->grain
+		)
+	);
+}
+
+static inline
+void __tree_rb_parallel_init(
+	  t_tree_rb_parallel * parallel
+	, t_tree_rb * tree
+	, t_pool * pool
+	, size_t grain
+) {
+	MS_MEMSET(parallel, 0, sizeof(t_tree_rb_parallel));
+	parallel->tree  = tree;
+	parallel->grain = (0 == grain) ? MS_POOL_GRAIN : grain;
+	parallel->pool  = pool;
+	while (MS_ADDRCK(tree)) {
+		++parallel->height;
+		tree = tree->left;
+	}
+}
+
+/*
+ * The left child is forked and the right one handled meanwhile
+*/
+static inline
+void __tree_rb_parallel_split(
+	  t_tree_rb_parallel * parallel
+	, t_tree_rb_parallel * left
+	, t_tree_rb_parallel * right
+) {
+	*left = *parallel;
+	*right = *parallel;
+	left->tree = parallel->tree->left;
+	right->tree = parallel->tree->right;
+	--left->height;
+	--right->height;
+}
+
+static
+void __tree_rb_destroy_task(void * arg)
+{
+	t_pool_task          task;
+	t_tree_rb_parallel   left;
+	t_tree_rb_parallel   right;
+	t_tree_rb_parallel * parallel;
+
+	parallel = MS_CAST(t_tree_rb_parallel *, arg);
+	if (MS_ADDRNULL(parallel->tree)) {
+		return ;
+	}
+	if (__tree_rb_is_small(parallel)) {
+		tree_rb_destroy(&parallel->tree, parallel->f_free);
+		return ;
+	}
+	__tree_rb_parallel_split(parallel, &left, &right);
+	pool_fork(parallel->pool, &task, &__tree_rb_destroy_task, &left);
+	__tree_rb_destroy_task(&right);
+	pool_join(parallel->pool, &task);
+	if (MS_ADDRCK(parallel->f_free)) {
+		parallel->f_free(parallel->tree->data);
+	}
+	MS_DEALLOC(parallel->tree);
+}
+
+/*
+ * A failed task keeps the subtrees not started yet from running
+*/
+static
+void __tree_rb_in_order_task(void * arg)
+{
+	int                  ret;
+	int                  first;
+	t_pool_task          task;
+	t_tree_rb_parallel   left;
+	t_tree_rb_parallel   right;
+	t_tree_rb_parallel * parallel;
+
+	parallel = MS_CAST(t_tree_rb_parallel *, arg);
+	if (
+		   MS_ADDRNULL(parallel->tree)
+		|| 0 != MS_ATOMIC_LOAD(parallel->ret)
+	) {
+		return ;
+	}
+	if (__tree_rb_is_small(parallel)) {
+		ret = tree_rb_in_order(&parallel->tree, parallel->content, parallel->f_fct);
+	} else {
+		__tree_rb_parallel_split(parallel, &left, &right);
+		pool_fork(parallel->pool, &task, &__tree_rb_in_order_task, &left);
+		ret = parallel->f_fct(parallel->tree->data, parallel->content);
+		if (0 == ret) {
+			__tree_rb_in_order_task(&right);
+		}
+		pool_join(parallel->pool, &task);
+	}
+	if (0 != ret) {
+		first = 0;
+		MS_ATOMIC_CAS(parallel->ret, &first, ret);
+	}
+}
+
+static inline
+void __tree_rb_reduce_leef(
+	  t_tree_rb * tree
+	, void * partial
+	, void (*f_map)(void * partial, void * data)
+) {
+	if (MS_ADDRCK(tree)) {
+		__tree_rb_reduce_leef(tree->left, partial, f_map);
+		f_map(partial, tree->data);
+		__tree_rb_reduce_leef(tree->right, partial, f_map);
+	}
+}
+
+/*
+ * The right subtree is folded into a partial of its own, combined
+ * after the node: the order of the data is kept, only the grouping
+ * changes. Without memory for it, the subtree is not split
+*/
+static
+void __tree_rb_reduce_task(void * arg)
+{
+	void               * partial;
+	t_pool_task          task;
+	t_tree_rb_parallel   left;
+	t_tree_rb_parallel   right;
+	t_tree_rb_parallel * parallel;
+
+	parallel = MS_CAST(t_tree_rb_parallel *, arg);
+	if (MS_ADDRNULL(parallel->tree)) {
+		return ;
+	}
+	partial = NULL;
+	if (0 == __tree_rb_is_small(parallel)) {
+		partial = MS_ALLOC(parallel->size);
+	}
+	if (MS_ADDRNULL(partial)) {
+		__tree_rb_reduce_leef(parallel->tree, parallel->partial, parallel->f_map);
+		return ;
+	}
+	MS_MEMCPY(partial, parallel->identity, parallel->size);
+	__tree_rb_parallel_split(parallel, &left, &right);
+	right.partial = partial;
+	pool_fork(parallel->pool, &task, &__tree_rb_reduce_task, &left);
+	__tree_rb_reduce_task(&right);
+	pool_join(parallel->pool, &task);
+	parallel->f_map(parallel->partial, parallel->tree->data);
+	parallel->f_combine(parallel->partial, partial);
+	MS_DEALLOC(partial);
+}
+
 /*------------------------------------- METHODS -------------------------------------*/
 
+void tree_rb_destroy_parallel(
+	  t_tree_rb ** tree
+	, void (*f_free)(void * data)
+	, t_pool * pool
+	, size_t grain
+) {
+	t_tree_rb_parallel parallel;
+
+	if (
+		   MS_ADDRCK(tree)
+		&& MS_ADDRCK(*tree)
+	) {
+		__tree_rb_parallel_init(&parallel, *tree, pool, grain);
+		parallel.f_free = f_free;
+		__tree_rb_destroy_task(&parallel);
+		*tree = NULL;
+	}
+}
+
 int tree_rb_is_empty(const t_tree_rb * tree)
 {
 	if (MS_ADDRCK(tree)) {
@@ -359,6 +638,46 @@ void * tree_rb_search(
 	return (elem);
 }
 
+size_t tree_rb_search_batch(
+	  t_tree_rb ** tree
+	, void ** datas
+	, size_t count
+	, void ** elems
+	, int (*f_compare)(void * elem, void * data)
+) {
+	size_t i;
+	size_t group;
+	size_t found;
+
+	found = 0;
+	if (
+		   MS_ADDRCK(tree)
+		&& MS_ADDRCK(datas)
+		&& MS_ADDRCK(elems)
+		&& MS_ADDRCK(f_compare)
+	) {
+		if (MS_ADDRCK(*tree)) {
+			MS_PREFETCH(*tree);
+		}
+		i = 0;
+		while (i < count) {
+			group = count - i;
+			if (group > TREE_RB_BATCH) {
+				group = TREE_RB_BATCH;
+			}
+			found += __tree_rb_search_group(
+				  *tree
+				, datas + i
+				, group
+				, elems + i
+				, f_compare
+			);
+			i += group;
+		}
+	}
+	return (found);
+}
+
 int tree_rb_pre_order(
 	  t_tree_rb ** tree
 	, void ** content
@@ -423,6 +742,72 @@ int tree_rb_in_order(
 	return (ret);
 }
 
+int tree_rb_in_order_parallel(
+	  t_tree_rb ** tree
+	, void ** content
+	, int (*f_fct)(void * data, void ** content)
+	, t_pool * pool
+	, size_t grain
+) {
+	int                ret;
+	t_tree_rb_parallel parallel;
+
+	ret = 0;
+	if (
+		   MS_ADDRCK(tree)
+		&& MS_ADDRCK(f_fct)
+		&& MS_ADDRCK(*tree)
+	) {
+		__tree_rb_parallel_init(&parallel, *tree, pool, grain);
+		parallel.content = content;
+		parallel.f_fct   = f_fct;
+		parallel.ret     = &ret;
+		__tree_rb_in_order_task(&parallel);
+	}
+	return (ret);
+}
+
+/*
+ * The caller's identity is copied before `result` receives the left
+ * subtrees
+*/
+int tree_rb_reduce_parallel(
+	  t_tree_rb ** tree
+	, void * result
+	, size_t size
+	, void (*f_map)(void * partial, void * data)
+	, void (*f_combine)(void * partial, const void * other)
+	, t_pool * pool
+	, size_t grain
+) {
+	void             * identity;
+	t_tree_rb_parallel parallel;
+
+	if (
+		   MS_ADDRNULL(tree)
+		|| MS_ADDRNULL(result)
+		|| 0 == size
+		|| MS_ADDRNULL(f_map)
+		|| MS_ADDRNULL(f_combine)
+	) {
+		return (1);
+	}
+	identity = MS_ALLOC(size);
+	if (MS_ADDRNULL(identity)) {
+		return (1);
+	}
+	MS_MEMCPY(identity, result, size);
+	__tree_rb_parallel_init(&parallel, *tree, pool, grain);
+	parallel.partial   = result;
+	parallel.identity  = identity;
+	parallel.size      = size;
+	parallel.f_map     = f_map;
+	parallel.f_combine = f_combine;
+	__tree_rb_reduce_task(&parallel);
+	MS_DEALLOC(identity);
+	return (0);
+}
+
 int tree_rb_out_order(
 	  t_tree_rb ** tree
 	, void ** content
@@ -487,4 +872,29 @@ int tree_rb_post_order(
 	return (ret);
 }
 
+int tree_rb_freeze(
+	  t_tree_rb ** tree
+	, t_tree_fz ** frozen
+	, long (*f_key)(void * data)
+) {
+	int      ret;
+	size_t   size;
+	void  ** datas;
+
+	ret = 1;
+	if (
+		   MS_ADDRCK(tree)
+		&& MS_ADDRCK(frozen)
+	) {
+		size = tree_rb_size(*tree);
+		datas = MS_CAST(void **, MS_ALLOC((size + 1) * sizeof(void *)));
+		if (MS_ADDRCK(datas)) {
+			__tree_rb_collect(*tree, datas, 0);
+			ret = tree_fz_init(frozen, datas, size, f_key);
+			MS_DEALLOC(datas);
+		}
+	}
+	return (ret);
+}
+
 /* EOF */
\ No newline at end of file
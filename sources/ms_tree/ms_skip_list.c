@@ -0,0 +1,537 @@
+# include <ms_tree/ms_skip_list.h>
+# include <ms_epoch.h>
+
+/*----------------------------------- STRUCTURES ------------------------------------*/
+
+/*
+ * Levels of the skip list, a node gets one more with a chance of 1/4:
+ * enough for 4^16 elements
+*/
+# define TREE_SL_LEVELS       16
+
+/*
+ * Low bit of the `next` of a node removed from that level
+*/
+# define TREE_SL_MARK         MS_CAST(size_t, 0x01)
+# define TREE_SL_MARKED(ptr)  (0 != (MS_CAST(size_t, ptr) & TREE_SL_MARK))
+# define TREE_SL_PTR(ptr)     (MS_CAST(t_tree_sl_node *, (MS_CAST(size_t, ptr) & ~TREE_SL_MARK)))
+
+/*
+ * `refs` is held once by the thread linking the levels of the node and
+ * once by the thread removing it: the last one to let go unlinks the
+ * node from every level and retires it, so that a level linked late
+ * cannot leave a freed node reachable
+*/
+typedef struct s_tree_sl_node
+{
+	void                   * data;
+	size_t                   refs;
+	size_t                   height;
+	struct s_tree_sl_node  * next[];
+} t_tree_sl_node;
+
+/*
+ * `count` is on its own cache line, the readers never write
+*/
+struct s_tree_sl
+{
+	t_tree_sl_node * head;
+	size_t           count MS_ALIGNED(MS_CACHE_LINE);
+};
+
+static __thread size_t g_tree_sl_seed;
+
+/*--------------------------------- PRIVATE METHODS ---------------------------------*/
+
+static
+void __tree_sl_dealloc(void * data)
+{
+	MS_DEALLOC(data);
+}
+
+/*
+ * xorshift64, seeded per thread
+*/
+static inline
+size_t __tree_sl_height(void)
+{
+	size_t bits;
+	size_t height;
+
+	if (0 == g_tree_sl_seed) {
+		g_tree_sl_seed = MS_CAST(size_t, &g_tree_sl_seed) | 1;
+	}
+	g_tree_sl_seed ^= g_tree_sl_seed << 13;
+	g_tree_sl_seed ^= g_tree_sl_seed >> 7;
+	g_tree_sl_seed ^= g_tree_sl_seed << 17;
+	bits = g_tree_sl_seed;
+	height = 1;
+	while (
+		   height < TREE_SL_LEVELS
+		&& 0 == (bits & 3)
+	) {
+		bits >>= 2;
+		++height;
+	}
+	return (height);
+}
+
+static inline
+t_tree_sl_node * __tree_sl_node(
+	  void * data
+	, size_t size
+	, size_t height
+) {
+	t_tree_sl_node * node;
+
+	node = MS_CAST(t_tree_sl_node *, MS_ALLOC(sizeof(t_tree_sl_node) + height * sizeof(t_tree_sl_node *)));
+	if (MS_ADDRCK(node)) {
+		MS_MEMSET(node->next, 0, height * sizeof(t_tree_sl_node *));
+		node->refs   = 2;
+		node->height = height;
+		node->data   = data;
+		if (0 != size) {
+			node->data = MS_ALLOC(size);
+			if (MS_ADDRNULL(node->data)) {
+				MS_DEALLOC(node);
+				return (NULL);
+			}
+			MS_MEMCPY(node->data, data, size);
+		}
+	}
+	return (node);
+}
+
+/*
+ * Set the mark of a level, returns 1 if this call set it
+*/
+static inline
+int __tree_sl_mark(t_tree_sl_node ** next)
+{
+	t_tree_sl_node * expected;
+
+	expected = MS_ATOMIC_LOAD(next);
+	while (
+		   !TREE_SL_MARKED(expected)
+		&& 0 == MS_ATOMIC_CAS(
+			  next
+			, &expected
+			, MS_CAST(t_tree_sl_node *, (MS_CAST(size_t, expected) | TREE_SL_MARK))
+		)
+	) {
+	}
+	return (!TREE_SL_MARKED(expected));
+}
+
+/*
+ * Whether the search of `data` goes past `node`. Looking for `target`,
+ * it also goes past the other nodes equal to it: a node removed may
+ * still follow, on an upper level, the node inserted again in its place
+*/
+static inline
+int __tree_sl_before(
+	  t_tree_sl_node * node
+	, void * data
+	, t_tree_sl_node * target
+	, int (*f_compare)(void * elem, void * data)
+) {
+	int ret;
+
+	if (node == target) {
+		return (0);
+	}
+	ret = f_compare(node->data, data);
+	return (
+		   ret > 0
+		|| (
+			   0 == ret
+			&& MS_ADDRCK(target)
+		)
+	);
+}
+
+/*
+ * Fill `preds` and `succs` with the nodes around `data` on each level,
+ * unlinking on the way the nodes marked on that level.
+ * Returns 1 if `succs[0]` is equal to `data`
+*/
+static
+int __tree_sl_find(
+	  t_tree_sl * tree
+	, void * data
+	, t_tree_sl_node * target
+	, int (*f_compare)(void * elem, void * data)
+	, t_tree_sl_node ** preds
+	, t_tree_sl_node ** succs
+) {
+	int              walk;
+	int              retry;
+	size_t           level;
+	t_tree_sl_node * pred;
+	t_tree_sl_node * curr;
+	t_tree_sl_node * next;
+
+	retry = 1;
+	while (0 != retry) {
+		retry = 0;
+		pred = tree->head;
+		level = TREE_SL_LEVELS;
+		while (
+			   0 == retry
+			&& level-- > 0
+		) {
+			curr = TREE_SL_PTR(MS_ATOMIC_LOAD(&pred->next[level]));
+			walk = 1;
+			while (
+				   0 == retry
+				&& 1 == walk
+				&& MS_ADDRCK(curr)
+			) {
+				next = MS_ATOMIC_LOAD(&curr->next[level]);
+				if (TREE_SL_MARKED(next)) {
+					if (MS_ATOMIC_CAS(&pred->next[level], &curr, TREE_SL_PTR(next))) {
+						curr = TREE_SL_PTR(next);
+					} else {
+						retry = 1;
+					}
+				} else if (__tree_sl_before(curr, data, target, f_compare)) {
+					pred = curr;
+					curr = next;
+				} else {
+					walk = 0;
+				}
+			}
+			preds[level] = pred;
+			succs[level] = curr;
+		}
+	}
+	return (
+		   MS_ADDRCK(succs[0])
+		&& 0 == f_compare(succs[0]->data, data)
+	);
+}
+
+/*
+ * First node not marked on the bottom level and not below `data`,
+ * without writing: the marked nodes are stepped over
+*/
+static inline
+t_tree_sl_node * __tree_sl_seek(
+	  t_tree_sl * tree
+	, void * data
+	, int (*f_compare)(void * elem, void * data)
+) {
+	int              walk;
+	size_t           level;
+	t_tree_sl_node * pred;
+	t_tree_sl_node * curr;
+	t_tree_sl_node * next;
+
+	pred = tree->head;
+	curr = NULL;
+	level = TREE_SL_LEVELS;
+	while (level-- > 0) {
+		curr = TREE_SL_PTR(MS_ATOMIC_LOAD(&pred->next[level]));
+		walk = 1;
+		while (
+			   1 == walk
+			&& MS_ADDRCK(curr)
+		) {
+			next = MS_ATOMIC_LOAD(&curr->next[level]);
+			if (TREE_SL_MARKED(next)) {
+				curr = TREE_SL_PTR(next);
+			} else if (f_compare(curr->data, data) > 0) {
+				pred = curr;
+				curr = next;
+			} else {
+				walk = 0;
+			}
+		}
+	}
+	return (curr);
+}
+
+/*
+ * Link the upper levels of a node linked on the bottom one, bottom-up.
+ * Stops as soon as a level of the node is marked
+*/
+static inline
+void __tree_sl_tower(
+	  t_tree_sl * tree
+	, t_tree_sl_node * node
+	, int (*f_compare)(void * elem, void * data)
+	, t_tree_sl_node ** preds
+	, t_tree_sl_node ** succs
+) {
+	size_t           level;
+	t_tree_sl_node * next;
+
+	level = 1;
+	while (level < node->height) {
+		next = MS_ATOMIC_LOAD(&node->next[level]);
+		if (TREE_SL_MARKED(next)) {
+			level = node->height;
+		} else if (
+			   next == succs[level]
+			|| MS_ATOMIC_CAS(&node->next[level], &next, succs[level])
+		) {
+			if (MS_ATOMIC_CAS(&preds[level]->next[level], &succs[level], node)) {
+				++level;
+			} else {
+				__tree_sl_find(tree, node->data, node, f_compare, preds, succs);
+			}
+		}
+	}
+}
+
+/*
+ * Drop a reference, the last one unlinks the node and retires it
+*/
+static inline
+void __tree_sl_release(
+	  t_tree_sl * tree
+	, t_tree_sl_node * node
+	, int (*f_compare)(void * elem, void * data)
+) {
+	t_tree_sl_node * preds[TREE_SL_LEVELS];
+	t_tree_sl_node * succs[TREE_SL_LEVELS];
+
+	if (0 == MS_ATOMIC_DEC(&node->refs)) {
+		__tree_sl_find(tree, node->data, node, f_compare, preds, succs);
+		epoch_retire(node, &__tree_sl_dealloc);
+	}
+}
+
+/*-------------------------------- CONSTRUCTOR/DESTR --------------------------------*/
+
+int tree_sl_init(t_tree_sl ** tree)
+{
+	if (MS_ADDRNULL(tree)) {
+		return (1);
+	}
+	*tree = MS_CAST(t_tree_sl *, MS_ALLOC_ALIGN(MS_CACHE_LINE, sizeof(t_tree_sl)));
+	if (MS_ADDRNULL(*tree)) {
+		return (1);
+	}
+	(*tree)->count = 0;
+	(*tree)->head  = __tree_sl_node(NULL, 0, TREE_SL_LEVELS);
+	if (MS_ADDRNULL((*tree)->head)) {
+		MS_DEALLOC(*tree);
+		*tree = NULL;
+		return (1);
+	}
+	return (0);
+}
+
+void tree_sl_destroy(
+	  t_tree_sl * tree
+	, void (*f_free)(void * data)
+) {
+	t_tree_sl_node * node;
+	t_tree_sl_node * next;
+
+	if (MS_ADDRCK(tree)) {
+		node = tree->head->next[0];
+		while (MS_ADDRCK(node)) {
+			next = node->next[0];
+			if (
+				   !TREE_SL_MARKED(next)
+				&& MS_ADDRCK(f_free)
+			) {
+				f_free(node->data);
+			}
+			MS_DEALLOC(node);
+			node = TREE_SL_PTR(next);
+		}
+		MS_DEALLOC(tree->head);
+		MS_DEALLOC(tree);
+	}
+}
+
+/*------------------------------------- METHODS -------------------------------------*/
+
+size_t tree_sl_size(const t_tree_sl * tree)
+{
+	if (MS_ADDRCK(tree)) {
+		return (MS_ATOMIC_LOAD(&tree->count));
+	}
+	return (0);
+}
+
+int tree_sl_insert(
+	  t_tree_sl * tree
+	, void * data
+	, size_t size
+	, int (*f_compare)(void * elem, void * data)
+) {
+	int              ret;
+	int              found;
+	t_tree_sl_node * node;
+	t_tree_sl_node * preds[TREE_SL_LEVELS];
+	t_tree_sl_node * succs[TREE_SL_LEVELS];
+
+	if (
+		   MS_ADDRNULL(tree)
+		|| MS_ADDRNULL(data)
+		|| MS_ADDRNULL(f_compare)
+	) {
+		return (1);
+	}
+	node = __tree_sl_node(data, size, __tree_sl_height());
+	if (MS_ADDRNULL(node)) {
+		return (1);
+	}
+	ret = 1;
+	if (0 == epoch_enter()) {
+		found = epoch_reserve(1);
+		while (
+			   0 == found
+			&& 0 != ret
+		) {
+			found = __tree_sl_find(tree, node->data, NULL, f_compare, preds, succs);
+			if (0 == found) {
+				node->next[0] = succs[0];
+				if (MS_ATOMIC_CAS(&preds[0]->next[0], &succs[0], node)) {
+					ret = 0;
+				}
+			}
+		}
+		if (0 == ret) {
+			MS_ATOMIC_INC(&tree->count);
+			__tree_sl_tower(tree, node, f_compare, preds, succs);
+			__tree_sl_release(tree, node, f_compare);
+		}
+		epoch_exit();
+	}
+	if (0 != ret) {
+		if (0 != size) {
+			MS_DEALLOC(node->data);
+		}
+		MS_DEALLOC(node);
+	}
+	return (ret);
+}
+
+void * tree_sl_search(
+	  t_tree_sl * tree
+	, void * data
+	, int (*f_compare)(void * elem, void * data)
+) {
+	void           * elem;
+	t_tree_sl_node * node;
+
+	if (
+		   MS_ADDRNULL(tree)
+		|| MS_ADDRNULL(data)
+		|| MS_ADDRNULL(f_compare)
+	) {
+		return (NULL);
+	}
+	elem = NULL;
+	if (0 == epoch_enter()) {
+		node = __tree_sl_seek(tree, data, f_compare);
+		if (
+			   MS_ADDRCK(node)
+			&& 0 == f_compare(node->data, data)
+		) {
+			elem = node->data;
+		}
+		epoch_exit();
+	}
+	return (elem);
+}
+
+int tree_sl_remove(
+	  t_tree_sl * tree
+	, void * data
+	, int (*f_compare)(void * elem, void * data)
+	, void (*f_free)(void * data)
+) {
+	int              ret;
+	size_t           level;
+	t_tree_sl_node * node;
+	t_tree_sl_node * preds[TREE_SL_LEVELS];
+	t_tree_sl_node * succs[TREE_SL_LEVELS];
+
+	if (
+		   MS_ADDRNULL(tree)
+		|| MS_ADDRNULL(data)
+		|| MS_ADDRNULL(f_compare)
+	) {
+		return (1);
+	}
+	ret = 1;
+	if (0 == epoch_enter()) {
+		if (
+			   0 == epoch_reserve(2)
+			&& 1 == __tree_sl_find(tree, data, NULL, f_compare, preds, succs)
+		) {
+			node = succs[0];
+			level = node->height;
+			while (--level > 0) {
+				__tree_sl_mark(&node->next[level]);
+			}
+			if (1 == __tree_sl_mark(&node->next[0])) {
+				MS_ATOMIC_DEC(&tree->count);
+				if (MS_ADDRCK(f_free)) {
+					epoch_retire(node->data, f_free);
+				}
+				__tree_sl_release(tree, node, f_compare);
+				ret = 0;
+			}
+		}
+		epoch_exit();
+	}
+	return (ret);
+}
+
+int tree_sl_range(
+	  t_tree_sl * tree
+	, void * min
+	, void * max
+	, void ** content
+	, int (*f_fct)(void * data, void ** content)
+	, int (*f_compare)(void * elem, void * data)
+) {
+	int              ret;
+	t_tree_sl_node * node;
+	t_tree_sl_node * next;
+
+	if (
+		   MS_ADDRNULL(tree)
+		|| MS_ADDRNULL(f_fct)
+		|| (
+			   MS_ADDRNULL(f_compare)
+			&& (MS_ADDRCK(min) || MS_ADDRCK(max))
+		)
+	) {
+		return (1);
+	}
+	if (0 != epoch_enter()) {
+		return (1);
+	}
+	if (MS_ADDRCK(min)) {
+		node = __tree_sl_seek(tree, min, f_compare);
+	} else {
+		node = TREE_SL_PTR(MS_ATOMIC_LOAD(&tree->head->next[0]));
+	}
+	ret = 0;
+	while (
+		   0 == ret
+		&& MS_ADDRCK(node)
+		&& (
+			   MS_ADDRNULL(max)
+			|| f_compare(node->data, max) >= 0
+		)
+	) {
+		next = MS_ATOMIC_LOAD(&node->next[0]);
+		if (!TREE_SL_MARKED(next)) {
+			ret = f_fct(node->data, content);
+		}
+		node = TREE_SL_PTR(next);
+	}
+	epoch_exit();
+	return (ret);
+}
+
+/* EOF */
\ No newline at end of file